@@ -26,6 +26,7 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/keymap_common.c \
     $(QUANTUM_DIR)/keycode_config.c \
     $(QUANTUM_DIR)/sync_timer.c \
+    $(QUANTUM_DIR)/timeout.c \
     $(QUANTUM_DIR)/logging/debug.c \
     $(QUANTUM_DIR)/logging/sendchar.c \
 
@@ -37,6 +38,12 @@ else
     include $(PLATFORM_PATH)/$(PLATFORM_KEY)/printf.mk
 endif
 
+ifeq ($(strip $(CONSOLE_BINARY_LOG_ENABLE)), yes)
+    OPT_DEFS += -DCONSOLE_BINARY_LOG_ENABLE
+    CONSOLE_ENABLE = yes
+    QUANTUM_SRC += $(QUANTUM_DIR)/logging/binary_log.c
+endif
+
 ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), yes)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
     CONSOLE_ENABLE = yes
@@ -300,7 +307,7 @@ ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
   endif
 endif
 
-VALID_FLASH_DRIVER_TYPES := spi
+VALID_FLASH_DRIVER_TYPES := spi custom
 FLASH_DRIVER ?= none
 ifneq ($(strip $(FLASH_DRIVER)), none)
     ifeq ($(filter $(FLASH_DRIVER),$(VALID_FLASH_DRIVER_TYPES)),)
@@ -624,6 +631,7 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     RAW_ENABLE := yes
     BOOTMAGIC_ENABLE := yes
     TRI_LAYER_ENABLE := yes
+    CRC_ENABLE := yes
     SRC += $(QUANTUM_DIR)/via.c
     OPT_DEFS += -DVIA_ENABLE
 endif
@@ -657,7 +665,8 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     # if 'lite' then skip the actual matrix implementation
     ifneq ($(strip $(CUSTOM_MATRIX)), lite)
         # Include the standard or split matrix code if needed
-        QUANTUM_SRC += $(QUANTUM_DIR)/matrix.c
+        QUANTUM_SRC += $(QUANTUM_DIR)/matrix.c \
+                       $(QUANTUM_DIR)/matrix_port.c
     endif
 endif
 
@@ -932,6 +941,12 @@ ifeq ($(strip $(ENCODER_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(LATENCY_TRACKING_ENABLE)), yes)
+    SRC += $(QUANTUM_DIR)/latency_tracking.c
+    OPT_DEFS += -DLATENCY_TRACKING_ENABLE
+    RAW_ENABLE = yes
+endif
+
 ifeq ($(strip $(OS_DETECTION_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/os_detection.c
     OPT_DEFS += -DOS_DETECTION_ENABLE
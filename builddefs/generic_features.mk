@@ -28,6 +28,7 @@ GENERIC_FEATURES = \
     DYNAMIC_MACRO \
     GRAVE_ESC \
     HAPTIC \
+    IDLE_SLEEP \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -33,7 +34,7 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_i2c.h"
@@ -41,10 +42,14 @@
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+// State of the EEPROM's internal write cycle, started by the last page write
+static bool     write_in_progress = false;
+static uint32_t write_start;
+static uint8_t  write_device;
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -53,6 +58,191 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+/*
+    The EEPROM doesn't acknowledge its address until the internal write cycle
+    has completed, so poll for an ACK rather than waiting out the worst case
+    write time. Returns true once the EEPROM is ready.
+*/
+static bool eeprom_i2c_poll_ready(void) {
+    if (!write_in_progress) {
+        return true;
+    }
+
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE] = {0};
+    if (i2c_transmit(write_device, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100) == I2C_STATUS_SUCCESS || timer_elapsed32(write_start) > EXTERNAL_EEPROM_WRITE_TIME) {
+        write_in_progress = false;
+    }
+    return !write_in_progress;
+}
+
+static void eeprom_i2c_wait_ready(void) {
+    while (!eeprom_i2c_poll_ready()) {
+    }
+}
+
+static void eeprom_i2c_read(uintptr_t addr, uint8_t *buf, size_t len) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, (const void *)addr);
+
+    eeprom_i2c_wait_ready();
+    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
+    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS(addr), buf, len, 100);
+
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
+    dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
+    for (size_t i = 0; i < len; ++i) {
+        dprintf(" %02X", (int)buf[i]);
+    }
+    dprintf("\n");
+#endif // DEBUG_EEPROM_OUTPUT
+}
+
+/*
+    Writes data within a single page, returning as soon as it's been
+    transferred -- the EEPROM completes the write cycle in the background.
+*/
+static void eeprom_i2c_write_page(uintptr_t addr, const uint8_t *buf, size_t len) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
+    fill_target_address(complete_packet, (const void *)addr);
+    for (size_t i = 0; i < len; i++) {
+        complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + i] = buf[i];
+    }
+
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
+    dprintf("[EEPROM W] 0x%04X: ", ((int)addr));
+    for (size_t i = 0; i < len; i++) {
+        dprintf(" %02X", (int)buf[i]);
+    }
+    dprintf("\n");
+#endif // DEBUG_EEPROM_OUTPUT
+
+    eeprom_i2c_wait_ready();
+
+#if defined(EXTERNAL_EEPROM_WP_PIN)
+    setPinOutput(EXTERNAL_EEPROM_WP_PIN);
+    writePin(EXTERNAL_EEPROM_WP_PIN, 0);
+#endif
+
+    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + len, 100);
+    write_in_progress = (EXTERNAL_EEPROM_WRITE_TIME) > 0;
+    write_start       = timer_read32();
+    write_device      = EXTERNAL_EEPROM_I2C_ADDRESS(addr);
+
+#if defined(EXTERNAL_EEPROM_WP_PIN)
+    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
+    writePin(EXTERNAL_EEPROM_WP_PIN, 1);
+    setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
+#endif
+}
+
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+/*
+    Pages with pending writes. Only the bytes written are tracked, any others
+    in between are read back from the EEPROM when the page is flushed.
+*/
+typedef struct {
+    bool     in_use;
+    uint32_t page;
+    uint32_t last_written;
+    uint8_t  dirty[(EXTERNAL_EEPROM_PAGE_SIZE + 7) / 8];
+    uint8_t  data[EXTERNAL_EEPROM_PAGE_SIZE];
+} eeprom_i2c_cache_page_t;
+
+static eeprom_i2c_cache_page_t cache[EXTERNAL_EEPROM_WRITE_BEHIND_PAGES];
+static uint32_t                cache_counter = 0;
+
+#    define CACHE_IS_DIRTY(slot, offset) ((slot)->dirty[(offset) / 8] & (1 << ((offset) % 8)))
+
+static eeprom_i2c_cache_page_t *eeprom_i2c_cache_find(uint32_t page) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_WRITE_BEHIND_PAGES; ++i) {
+        if (cache[i].in_use && cache[i].page == page) {
+            return &cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Least recently written page, giving pages still being written to the chance to accumulate further changes
+static eeprom_i2c_cache_page_t *eeprom_i2c_cache_oldest(void) {
+    eeprom_i2c_cache_page_t *oldest = NULL;
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_WRITE_BEHIND_PAGES; ++i) {
+        if (cache[i].in_use && (!oldest || cache[i].last_written < oldest->last_written)) {
+            oldest = &cache[i];
+        }
+    }
+    return oldest;
+}
+
+static void eeprom_i2c_cache_flush_page(eeprom_i2c_cache_page_t *slot) {
+    uint16_t first = EXTERNAL_EEPROM_PAGE_SIZE;
+    uint16_t last  = 0;
+    for (uint16_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; ++i) {
+        if (CACHE_IS_DIRTY(slot, i)) {
+            first = first < i ? first : i;
+            last  = i;
+        }
+    }
+
+    // Fill any gaps from the EEPROM, so that the whole span goes out as a single page write
+    uintptr_t base = (uintptr_t)slot->page * EXTERNAL_EEPROM_PAGE_SIZE;
+    for (uint16_t i = first; i <= last; ++i) {
+        if (!CACHE_IS_DIRTY(slot, i)) {
+            uint8_t current[EXTERNAL_EEPROM_PAGE_SIZE];
+            eeprom_i2c_read(base + first, current, last - first + 1);
+            for (uint16_t j = i; j <= last; ++j) {
+                if (!CACHE_IS_DIRTY(slot, j)) {
+                    slot->data[j] = current[j - first];
+                }
+            }
+            break;
+        }
+    }
+
+    eeprom_i2c_write_page(base + first, &slot->data[first], last - first + 1);
+    slot->in_use = false;
+}
+
+static eeprom_i2c_cache_page_t *eeprom_i2c_cache_get(uint32_t page) {
+    eeprom_i2c_cache_page_t *slot = eeprom_i2c_cache_find(page);
+    if (slot) {
+        return slot;
+    }
+
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_WRITE_BEHIND_PAGES; ++i) {
+        if (!cache[i].in_use) {
+            slot = &cache[i];
+            break;
+        }
+    }
+
+    // Out of space, the oldest page needs to be written out now
+    if (!slot) {
+        slot = eeprom_i2c_cache_oldest();
+        eeprom_i2c_cache_flush_page(slot);
+    }
+
+    slot->in_use = true;
+    slot->page   = page;
+    memset(slot->dirty, 0, sizeof(slot->dirty));
+    return slot;
+}
+
+void eeprom_i2c_task(void) {
+    eeprom_i2c_cache_page_t *slot = eeprom_i2c_cache_oldest();
+    if (slot && eeprom_i2c_poll_ready()) {
+        eeprom_i2c_cache_flush_page(slot);
+    }
+}
+
+void eeprom_i2c_flush(void) {
+    eeprom_i2c_cache_page_t *slot;
+    while ((slot = eeprom_i2c_cache_oldest()) != NULL) {
+        eeprom_i2c_cache_flush_page(slot);
+    }
+    eeprom_i2c_wait_ready();
+}
+#endif // defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -60,6 +250,10 @@ void eeprom_driver_init(void) {
     writePin(EXTERNAL_EEPROM_WP_PIN, 1);
     setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
 #endif
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+    memset(cache, 0, sizeof(cache));
+#endif
+    write_in_progress = false;
 }
 
 void eeprom_driver_erase(void) {
@@ -67,11 +261,17 @@ void eeprom_driver_erase(void) {
     uint32_t start = timer_read32();
 #endif
 
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+    // Pending writes are about to be overwritten anyway
+    memset(cache, 0, sizeof(cache));
+#endif
+
     uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
     memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        eeprom_i2c_write_page(addr, buf, EXTERNAL_EEPROM_PAGE_SIZE);
     }
+    eeprom_i2c_wait_ready();
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("EEPROM erase took %ldms to complete\n", ((long)(timer_read32() - start)));
@@ -79,62 +279,67 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+    uint8_t * write_buf   = (uint8_t *)buf;
+    uintptr_t target_addr = (uintptr_t)addr;
 
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+    while (len > 0) {
+        uintptr_t page_offset = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+        size_t    read_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
+        if (read_length > len) {
+            read_length = len;
+        }
 
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-    dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
-    for (size_t i = 0; i < len; ++i) {
-        dprintf(" %02X", (int)(((uint8_t *)buf)[i]));
+        // Pending writes take precedence over what's in the EEPROM, which only needs reading if they don't cover everything
+        eeprom_i2c_cache_page_t *slot    = eeprom_i2c_cache_find(target_addr / EXTERNAL_EEPROM_PAGE_SIZE);
+        bool                     covered = slot != NULL;
+        for (size_t i = 0; i < read_length && covered; ++i) {
+            covered = CACHE_IS_DIRTY(slot, page_offset + i);
+        }
+        if (!covered) {
+            eeprom_i2c_read(target_addr, write_buf, read_length);
+        }
+        if (slot) {
+            for (size_t i = 0; i < read_length; ++i) {
+                if (CACHE_IS_DIRTY(slot, page_offset + i)) {
+                    write_buf[i] = slot->data[page_offset + i];
+                }
+            }
+        }
+
+        write_buf += read_length;
+        target_addr += read_length;
+        len -= read_length;
     }
-    dprintf("\n");
-#endif // DEBUG_EEPROM_OUTPUT
+#else
+    eeprom_i2c_read((uintptr_t)addr, buf, len);
+#endif
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
     uint8_t * read_buf    = (uint8_t *)buf;
     uintptr_t target_addr = (uintptr_t)addr;
 
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    setPinOutput(EXTERNAL_EEPROM_WP_PIN);
-    writePin(EXTERNAL_EEPROM_WP_PIN, 0);
-#endif
-
     while (len > 0) {
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
+        size_t    write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
         if (write_length > len) {
             write_length = len;
         }
 
-        fill_target_address(complete_packet, (const void *)target_addr);
-        for (uint8_t i = 0; i < write_length; i++) {
-            complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + i] = read_buf[i];
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+        eeprom_i2c_cache_page_t *slot = eeprom_i2c_cache_get(target_addr / EXTERNAL_EEPROM_PAGE_SIZE);
+        for (size_t i = 0; i < write_length; ++i) {
+            slot->data[page_offset + i] = read_buf[i];
+            slot->dirty[(page_offset + i) / 8] |= 1 << ((page_offset + i) % 8);
         }
-
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-        dprintf("[EEPROM W] 0x%04X: ", ((int)target_addr));
-        for (uint8_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(read_buf[i]));
-        }
-        dprintf("\n");
-#endif // DEBUG_EEPROM_OUTPUT
-
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        slot->last_written = ++cache_counter;
+#else
+        eeprom_i2c_write_page(target_addr, read_buf, write_length);
+#endif
 
         read_buf += write_length;
         target_addr += write_length;
         len -= write_length;
     }
-
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
-    writePin(EXTERNAL_EEPROM_WP_PIN, 1);
-    setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
-#endif
 }
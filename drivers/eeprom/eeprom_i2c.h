@@ -123,3 +123,20 @@
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
 #endif
+
+/*
+    Write-behind caching. When enabled, writes only update a RAM cache of
+    EXTERNAL_EEPROM_WRITE_BEHIND_PAGES pages, which are written out one page
+    per write cycle from eeprom_i2c_task(). Writing to more pages than the
+    cache holds writes out the oldest one immediately.
+
+    #define EXTERNAL_EEPROM_WRITE_BEHIND
+*/
+#ifndef EXTERNAL_EEPROM_WRITE_BEHIND_PAGES
+#    define EXTERNAL_EEPROM_WRITE_BEHIND_PAGES 8
+#endif
+
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+void eeprom_i2c_task(void);
+void eeprom_i2c_flush(void);
+#endif
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "eeprom.h"
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
@@ -21,3 +22,11 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
     wear_leveling_write((uint32_t)addr, buf, len);
 }
+
+void eeprom_batch_begin(void) {
+    wear_leveling_batch_begin();
+}
+
+void eeprom_batch_commit(void) {
+    wear_leveling_batch_commit();
+}
@@ -63,35 +63,73 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define FLASH_FLAG_WIP 0x01 /* Write in progress bit */
 #define FLASH_FLAG_WEL 0x02 /* Write enable latch bit */
 
+/* Read command used for data, along with the dummy bytes it needs after the address */
+#ifdef EXTERNAL_FLASH_SPI_FAST_READ
+#    define FLASH_CMD_READ_DATA FLASH_CMD_FASTREAD
+#    define FLASH_READ_DUMMY_BYTES (EXTERNAL_FLASH_SPI_FAST_READ_DUMMY_BYTES)
+#else
+#    define FLASH_CMD_READ_DATA FLASH_CMD_READ
+#    define FLASH_READ_DUMMY_BYTES 0
+#endif
+
 // #define DEBUG_FLASH_SPI_OUTPUT
 
+/*
+    Whether a program or erase may still be in progress. Commands return as
+    soon as they've been issued, and only the next command waits for the chip
+    to become idle again -- once it's been seen to be idle, there's no need to
+    poll the status register before every read.
+*/
+static bool flash_busy = true;
+
+/* Remainder of the write started by flash_write_block_async() */
+static struct {
+    uint32_t       addr;
+    const uint8_t *data;
+    size_t         len;
+} flash_pending_write;
+
 static bool spi_flash_start(void) {
     return spi_start(EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN, EXTERNAL_FLASH_SPI_LSBFIRST, EXTERNAL_FLASH_SPI_MODE, EXTERNAL_FLASH_SPI_CLOCK_DIVISOR);
 }
 
+static flash_status_t spi_flash_read_status(uint8_t *status) {
+    bool res = spi_flash_start();
+    if (!res) {
+        dprint("Failed to start SPI! [spi flash read status]\n");
+        return FLASH_STATUS_ERROR;
+    }
+
+    spi_write(FLASH_CMD_RDSR);
+
+    *status = (uint8_t)spi_read();
+
+    spi_stop();
+
+    if (!(*status & FLASH_FLAG_WIP)) {
+        flash_busy = false;
+    }
+
+    return FLASH_STATUS_SUCCESS;
+}
+
 static flash_status_t spi_flash_wait_while_busy(void) {
     uint32_t       deadline = timer_read32() + EXTERNAL_FLASH_SPI_TIMEOUT;
     flash_status_t response = FLASH_STATUS_SUCCESS;
     uint8_t        retval;
 
-    do {
-        bool res = spi_flash_start();
-        if (!res) {
-            dprint("Failed to start SPI! [spi flash wait while busy]\n");
-            return FLASH_STATUS_ERROR;
+    while (flash_busy) {
+        response = spi_flash_read_status(&retval);
+        if (response != FLASH_STATUS_SUCCESS) {
+            dprint("Failed to read status! [spi flash wait while busy]\n");
+            break;
         }
 
-        spi_write(FLASH_CMD_RDSR);
-
-        retval = (uint8_t)spi_read();
-
-        spi_stop();
-
-        if (timer_read32() >= deadline) {
+        if (flash_busy && timer_expired32(timer_read32(), deadline)) {
             response = FLASH_STATUS_TIMEOUT;
             break;
         }
-    } while (retval & FLASH_FLAG_WIP);
+    }
 
     return response;
 }
@@ -110,30 +148,20 @@ static flash_status_t spi_flash_write_enable(void) {
     return FLASH_STATUS_SUCCESS;
 }
 
-static flash_status_t spi_flash_write_disable(void) {
-    bool res = spi_flash_start();
-    if (!res) {
-        dprint("Failed to start SPI! [spi flash write disable]\n");
-        return FLASH_STATUS_ERROR;
-    }
-
-    spi_write(FLASH_CMD_WRDI);
-
-    spi_stop();
-
-    return FLASH_STATUS_SUCCESS;
-}
-
 /* This function is used for read transfer, write transfer and erase transfer. */
 static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t *data, size_t len) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
-    uint8_t        buffer[EXTERNAL_FLASH_ADDRESS_SIZE + 1];
+    uint8_t        buffer[EXTERNAL_FLASH_ADDRESS_SIZE + 1 + FLASH_READ_DUMMY_BYTES] = {0};
+    size_t         header_len                                                        = EXTERNAL_FLASH_ADDRESS_SIZE + 1;
 
     buffer[0] = cmd;
     for (int i = 0; i < EXTERNAL_FLASH_ADDRESS_SIZE; ++i) {
         buffer[EXTERNAL_FLASH_ADDRESS_SIZE - i] = addr & 0xFF;
         addr >>= 8;
     }
+    if (cmd == FLASH_CMD_FASTREAD) {
+        header_len += FLASH_READ_DUMMY_BYTES;
+    }
 
     bool res = spi_flash_start();
     if (!res) {
@@ -141,12 +169,19 @@ static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t
         return FLASH_STATUS_ERROR;
     }
 
-    response = spi_transmit(buffer, sizeof(buffer));
+    response = spi_transmit(buffer, header_len);
 
     if ((!response) && (data != NULL)) {
         switch (cmd) {
             case FLASH_CMD_READ:
-                response = spi_receive(data, len);
+            case FLASH_CMD_FASTREAD:
+                /* Reads continue across pages for as long as the chip is selected. */
+                while ((!response) && (len > 0)) {
+                    uint16_t chunk = MIN(len, UINT16_MAX);
+                    response       = spi_receive(data, chunk);
+                    data += chunk;
+                    len -= chunk;
+                }
                 break;
             case FLASH_CMD_PP:
                 response = spi_transmit(data, len);
@@ -162,15 +197,137 @@ static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t
     return response;
 }
 
+/* Issues a program or erase, leaving the chip busy with it. */
+static flash_status_t spi_flash_program(uint8_t cmd, uint32_t addr, uint8_t *data, size_t len) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+
+    /* Enable writes. */
+    response = spi_flash_write_enable();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to write-enable! [spi flash program]\n");
+        return response;
+    }
+
+    /* Write-in-progress gets set as soon as the command ends, and the write enable latch is cleared once it's complete. */
+    flash_busy = true;
+    response   = spi_flash_transaction(cmd, addr, data, len);
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to program! [spi flash program]\n");
+        return response;
+    }
+
+    return response;
+}
+
+/* Issues the next page of the pending asynchronous write. */
+static flash_status_t spi_flash_program_next_page(void) {
+    uint32_t page_offset  = flash_pending_write.addr % EXTERNAL_FLASH_PAGE_SIZE;
+    size_t   write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
+    if (write_length > flash_pending_write.len) {
+        write_length = flash_pending_write.len;
+    }
+
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_FLASH_SPI_OUTPUT)
+    dprintf("[SPI FLASH W] 0x%08lx: ", flash_pending_write.addr);
+    for (size_t i = 0; i < write_length; i++) {
+        dprintf(" %02X", (int)(uint8_t)(flash_pending_write.data[i]));
+    }
+    dprintf("\n");
+#endif // DEBUG_FLASH_SPI_OUTPUT
+
+    flash_status_t response = spi_flash_program(FLASH_CMD_PP, flash_pending_write.addr, (uint8_t *)flash_pending_write.data, write_length);
+    if (response != FLASH_STATUS_SUCCESS) {
+        flash_pending_write.len = 0;
+        return response;
+    }
+
+    flash_pending_write.data += write_length;
+    flash_pending_write.addr += write_length;
+    flash_pending_write.len -= write_length;
+
+    return response;
+}
+
+/* Waits out the rest of any pending asynchronous write, and the chip being busy. */
+static flash_status_t spi_flash_wait_for_idle(void) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+
+    while (flash_pending_write.len > 0) {
+        response = spi_flash_wait_while_busy();
+        if (response != FLASH_STATUS_SUCCESS) {
+            flash_pending_write.len = 0;
+            return response;
+        }
+
+        response = spi_flash_program_next_page();
+        if (response != FLASH_STATUS_SUCCESS) {
+            return response;
+        }
+    }
+
+    return spi_flash_wait_while_busy();
+}
+
 void flash_init(void) {
     spi_init();
+
+    /* Might still be busy with something from before a reset. */
+    flash_busy              = true;
+    flash_pending_write.len = 0;
+}
+
+bool flash_is_busy(void) {
+    uint8_t status;
+    if (flash_pending_write.len > 0) {
+        return true;
+    }
+    if (flash_busy && spi_flash_read_status(&status) != FLASH_STATUS_SUCCESS) {
+        return true;
+    }
+    return flash_busy;
+}
+
+flash_status_t flash_wait(void) {
+    flash_status_t response = spi_flash_wait_for_idle();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to check WIP flag! [spi flash wait]\n");
+    }
+    return response;
+}
+
+flash_status_t flash_task(void) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+    uint8_t        status;
+
+    if (flash_busy) {
+        response = spi_flash_read_status(&status);
+        if (response != FLASH_STATUS_SUCCESS) {
+            dprint("Failed to check WIP flag! [spi flash task]\n");
+            flash_pending_write.len = 0;
+            return response;
+        }
+        if (flash_busy) {
+            return FLASH_STATUS_BUSY;
+        }
+    }
+
+    if (flash_pending_write.len > 0) {
+        response = spi_flash_program_next_page();
+        if (response != FLASH_STATUS_SUCCESS) {
+            dprint("Failed to write block! [spi flash task]\n");
+            return response;
+        }
+        return FLASH_STATUS_BUSY;
+    }
+
+    return response;
 }
 
 flash_status_t flash_erase_chip(void) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
 
     /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    response = spi_flash_wait_for_idle();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash erase chip]\n");
         return response;
@@ -189,16 +346,10 @@ flash_status_t flash_erase_chip(void) {
         dprint("Failed to start SPI! [spi flash erase chip]\n");
         return FLASH_STATUS_ERROR;
     }
+    flash_busy = true;
     spi_write(FLASH_CMD_CE);
     spi_stop();
 
-    /* Wait for the write-in-progress bit to be cleared.*/
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase chip]\n");
-        return response;
-    }
-
     return response;
 }
 
@@ -207,38 +358,24 @@ flash_status_t flash_erase_sector(uint32_t addr) {
 
     /* Check that the address exceeds the limit. */
     if ((addr + (EXTERNAL_FLASH_SECTOR_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_SECTOR_SIZE)) != 0)) {
-        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (uint32_t)addr);
+        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (unsigned long)addr);
         return FLASH_STATUS_ERROR;
     }
 
     /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    response = spi_flash_wait_for_idle();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash erase sector]\n");
         return response;
     }
 
-    /* Enable writes. */
-    response = spi_flash_write_enable();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase sector]\n");
-        return response;
-    }
-
     /* Erase Sector. */
-    response = spi_flash_transaction(FLASH_CMD_SE, addr, NULL, 0);
+    response = spi_flash_program(FLASH_CMD_SE, addr, NULL, 0);
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to erase sector! [spi flash erase sector]\n");
         return response;
     }
 
-    /* Wait for the write-in-progress bit to be cleared.*/
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase sector]\n");
-        return response;
-    }
-
     return response;
 }
 
@@ -247,38 +384,24 @@ flash_status_t flash_erase_block(uint32_t addr) {
 
     /* Check that the address exceeds the limit. */
     if ((addr + (EXTERNAL_FLASH_BLOCK_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_BLOCK_SIZE)) != 0)) {
-        dprintf("Flash erase block address over limit! [addr:0x%lx]\n", (uint32_t)addr);
+        dprintf("Flash erase block address over limit! [addr:0x%lx]\n", (unsigned long)addr);
         return FLASH_STATUS_ERROR;
     }
 
     /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    response = spi_flash_wait_for_idle();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash erase block]\n");
         return response;
     }
 
-    /* Enable writes. */
-    response = spi_flash_write_enable();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase block]\n");
-        return response;
-    }
-
     /* Erase Block. */
-    response = spi_flash_transaction(FLASH_CMD_BE, addr, NULL, 0);
+    response = spi_flash_program(FLASH_CMD_BE, addr, NULL, 0);
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to erase block! [spi flash erase block]\n");
         return response;
     }
 
-    /* Wait for the write-in-progress bit to be cleared.*/
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase block]\n");
-        return response;
-    }
-
     return response;
 }
 
@@ -287,7 +410,7 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
     uint8_t *      read_buf = (uint8_t *)buf;
 
     /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    response = spi_flash_wait_for_idle();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash read block]\n");
         memset(read_buf, 0, len);
@@ -295,7 +418,7 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
     }
 
     /* Perform read. */
-    response = spi_flash_transaction(FLASH_CMD_READ, addr, read_buf, len);
+    response = spi_flash_transaction(FLASH_CMD_READ_DATA, addr, read_buf, len);
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to read block! [spi flash read block]\n");
         memset(read_buf, 0, len);
@@ -314,61 +437,54 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
 }
 
 flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len) {
-    flash_status_t response  = FLASH_STATUS_SUCCESS;
-    uint8_t *      write_buf = (uint8_t *)buf;
-
-    while (len > 0) {
-        uint32_t page_offset  = addr % EXTERNAL_FLASH_PAGE_SIZE;
-        size_t   write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
-        }
+    flash_status_t response = FLASH_STATUS_SUCCESS;
 
-        /* Wait for the write-in-progress bit to be cleared. */
+    response = flash_write_block_async(addr, buf, len);
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+
+    /* Issue every page but the last one, which is left to complete in the background. */
+    while (flash_pending_write.len > 0) {
         response = spi_flash_wait_while_busy();
         if (response != FLASH_STATUS_SUCCESS) {
             dprint("Failed to check WIP flag! [spi flash write block]\n");
+            flash_pending_write.len = 0;
             return response;
         }
 
-        /* Enable writes. */
-        response = spi_flash_write_enable();
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to write-enable! [spi flash write block]\n");
-            return response;
-        }
-
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_FLASH_SPI_OUTPUT)
-        dprintf("[SPI FLASH W] 0x%08lx: ", addr);
-        for (size_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(uint8_t)(write_buf[i]));
-        }
-        dprintf("\n");
-#endif // DEBUG_FLASH_SPI_OUTPUT
-
-        /* Perform the write. */
-        response = spi_flash_transaction(FLASH_CMD_PP, addr, write_buf, write_length);
+        response = spi_flash_program_next_page();
         if (response != FLASH_STATUS_SUCCESS) {
             dprint("Failed to write block! [spi flash write block]\n");
             return response;
         }
-
-        write_buf += write_length;
-        addr += write_length;
-        len -= write_length;
     }
 
+    return response;
+}
+
+flash_status_t flash_write_block_async(uint32_t addr, const void *buf, size_t len) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+
     /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    response = spi_flash_wait_for_idle();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash write block]\n");
         return response;
     }
 
-    /* Disable writes. */
-    response = spi_flash_write_disable();
+    if (len == 0) {
+        return response;
+    }
+
+    flash_pending_write.addr = addr;
+    flash_pending_write.data = (const uint8_t *)buf;
+    flash_pending_write.len  = len;
+
+    /* Start off the first page, flash_task() issues the rest as the chip becomes idle. */
+    response = spi_flash_program_next_page();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-disable! [spi flash write block]\n");
+        dprint("Failed to write block! [spi flash write block]\n");
         return response;
     }
 
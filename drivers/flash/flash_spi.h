@@ -56,6 +56,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EXTERNAL_FLASH_SPI_LSBFIRST false
 #endif
 
+/*
+    Whether reads should use the FAST_READ command instead of READ. Most chips
+    limit READ to a lower clock frequency, so this is needed to run the SPI bus
+    at the chip's full speed.
+*/
+// #define EXTERNAL_FLASH_SPI_FAST_READ
+
+/*
+    The number of dummy bytes following the address of a FAST_READ, as
+    specified in the datasheet.
+*/
+#ifndef EXTERNAL_FLASH_SPI_FAST_READ_DUMMY_BYTES
+#    define EXTERNAL_FLASH_SPI_FAST_READ_DUMMY_BYTES 1
+#endif
+
 /*
     The Flash address size in bytes, as specified in datasheet.
 */
@@ -112,12 +127,15 @@ typedef int16_t flash_status_t;
 #define FLASH_STATUS_ERROR (-1)
 #define FLASH_STATUS_TIMEOUT (-2)
 #define FLASH_STATUS_BAD_ADDRESS (-3)
+#define FLASH_STATUS_BUSY (-4)
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 void flash_init(void);
 
@@ -131,6 +149,25 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len);
 
 flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len);
 
+/*
+    Programs and erases return as soon as they've been issued, and any later
+    command waits for the chip to finish first. flash_is_busy() checks without
+    waiting, and flash_wait() waits until everything has been completed.
+*/
+bool flash_is_busy(void);
+
+flash_status_t flash_wait(void);
+
+/*
+    Starts writing a block, returning once its first page is being programmed.
+    The rest of the pages are issued by flash_task() as the chip becomes idle,
+    so the buffer needs to remain valid until it returns FLASH_STATUS_SUCCESS.
+    Any other command completes the write before it runs.
+*/
+flash_status_t flash_write_block_async(uint32_t addr, const void *buf, size_t len);
+
+flash_status_t flash_task(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "progmem.h"
 #include "wait.h"
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
 // for SH1107: https://www.displayfuture.com/Display/datasheet/controller/SH1107.pdf
@@ -926,6 +930,31 @@ uint8_t oled_max_lines(void) {
     return OLED_DISPLAY_WIDTH / OLED_FONT_HEIGHT;
 }
 
+#ifdef IDLE_SLEEP_ENABLE
+// Lets the main loop sleep until the next update, display timeout or scroll is due
+static void oled_request_wakeup(void) {
+    // Blocks left over from the per-call render limit
+    if ((oled_dirty & OLED_ALL_BLOCKS_MASK) && !oled_scrolling) {
+        idle_sleep_prevent();
+        return;
+    }
+#    if OLED_UPDATE_INTERVAL > 0
+    uint16_t elapsed = timer_elapsed(oled_update_timeout);
+    idle_sleep_request_wakeup_in(elapsed < OLED_UPDATE_INTERVAL ? OLED_UPDATE_INTERVAL - elapsed : 0);
+#    endif
+#    if OLED_TIMEOUT > 0
+    if (oled_active) {
+        idle_sleep_request_wakeup(oled_timeout);
+    }
+#    endif
+#    if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling) {
+        idle_sleep_request_wakeup(oled_scroll_timeout);
+    }
+#    endif
+}
+#endif
+
 void oled_task(void) {
     if (!oled_initialized) {
         return;
@@ -968,6 +997,10 @@ void oled_task(void) {
 #    endif
     }
 #endif
+
+#ifdef IDLE_SLEEP_ENABLE
+    oled_request_wakeup();
+#endif
 }
 
 __attribute__((weak)) bool oled_task_kb(void) {
@@ -277,17 +277,20 @@ void cirque_pinnacle_init(void) {
 }
 
 pinnacle_data_t cirque_pinnacle_read_data(void) {
-    uint8_t         data_ready = 0;
-    uint8_t         data[6]    = {0};
-    pinnacle_data_t result     = {0};
+    uint8_t         data[6] = {0};
+    pinnacle_data_t result  = {0};
 
+    // With the DR pin wired up as the motion pin, this is only called once data is ready, saving a bus transaction
+#ifndef POINTING_DEVICE_MOTION_PIN
     // Check if there is valid data available
+    uint8_t data_ready = 0;
     RAP_ReadBytes(HOSTREG__STATUS1, &data_ready, 1);
     if ((data_ready & HOSTREG__STATUS1__DATA_READY) == 0) {
         // no data available yet
         result.valid = false; // be explicit
         return result;
     }
+#endif
 
     // Read all data bytes
     RAP_ReadBytes(HOSTREG__PACKETBYTE_0, data, 6);
@@ -73,6 +73,9 @@ uint8_t pmw33xx_read(uint8_t sensor, uint8_t reg_addr) {
         return 0;
     }
 
+    // any register access other than Motion_Burst ends burst mode
+    in_burst[sensor] = false;
+
     // send adress of the register, with MSBit = 0 to indicate it's a read
     spi_write(reg_addr & 0x7f);
     // tSRAD (=160us)
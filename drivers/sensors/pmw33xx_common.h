@@ -53,6 +53,10 @@ _Static_assert(sizeof((pmw33xx_report_t){0}.motion) == 1, "pmw33xx_report_t.moti
 #    endif
 #endif
 
+#if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
+#    define POINTING_DEVICE_TASK_THROTTLE_MS 1 // Fixed interval, the sensor frame rate is well above 1kHz and reading it more often than the host polls only costs SPI bus time.
+#endif
+
 #if !defined(PMW33XX_LIFTOFF_DISTANCE)
 #    define PMW33XX_LIFTOFF_DISTANCE 0x02
 #endif
@@ -41,6 +41,18 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    bool     ret    = true;
+    uint32_t offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
+    for (uint32_t i = 0; i < length; i += (EXTERNAL_FLASH_SECTOR_SIZE)) {
+        if (flash_erase_sector(offset + i) != FLASH_STATUS_SUCCESS) {
+            ret = false;
+            break;
+        }
+    }
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
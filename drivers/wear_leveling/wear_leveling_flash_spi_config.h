@@ -28,6 +28,11 @@
 #    define WEAR_LEVELING_BACKING_SIZE ((EXTERNAL_FLASH_BLOCK_SIZE) * (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT))
 #endif // WEAR_LEVELING_BACKING_SIZE
 
+// Smallest unit erased by backing_store_erase_range()
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (EXTERNAL_FLASH_SECTOR_SIZE)
+#endif // BACKING_STORE_ERASE_SIZE
+
 // Use half of the backing size for logical EEPROM
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
 #    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
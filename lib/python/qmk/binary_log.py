@@ -0,0 +1,206 @@
+"""Functions for decoding QMK binary console logs.
+
+With `CONSOLE_BINARY_LOG_ENABLE = yes` the keyboard sends the address of each format string along with the raw argument values. Format strings are looked up in the firmware's ELF file and rendered here.
+"""
+import re
+import struct
+
+# Matches a printf style conversion, in the same way quantum/logging/binary_log.c walks the format string
+FORMAT_RE = re.compile(r'%([-+ #0]*)(\*|\d*)(?:\.(\*|\d*))?([lhzt]*)(.)', re.DOTALL)
+
+NUMERIC_CONVERSIONS = 'diuxXobcp'
+FLOAT_CONVERSIONS = 'fFeEgG'
+
+
+class ElfStrings:
+    """Reads NUL terminated strings out of the loadable sections of an ELF file by address.
+    """
+    def __init__(self, data):
+        self.data = data
+        self.sections = []
+
+        if data[:4] != b'\x7fELF':
+            raise ValueError('Not an ELF file')
+
+        is_64 = data[4] == 2
+        endian = '<' if data[5] == 1 else '>'
+
+        if is_64:
+            shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x3A)
+            section_format = endian + 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x2E)
+            section_format = endian + 'IIIIII'
+
+        SHT_PROGBITS = 1
+        SHF_ALLOC = 2
+        for index in range(shnum):
+            _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(section_format, data, shoff + index * shentsize)
+            if sh_type == SHT_PROGBITS and sh_flags & SHF_ALLOC and sh_size:
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+    def string_at(self, address):
+        """Returns the string at `address`, or None if it doesn't point into a loadable section.
+        """
+        for sh_addr, sh_offset, sh_size in self.sections:
+            if sh_addr <= address < sh_addr + sh_size:
+                start = sh_offset + address - sh_addr
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('utf-8', errors='replace')
+
+        return None
+
+
+def cobs_decode(frame):
+    """Undoes the COBS encoding of a single frame, returning None if it is malformed.
+    """
+    result = bytearray()
+    index = 0
+
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            return None
+        result += frame[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(frame):
+            result.append(0)
+
+    return bytes(result)
+
+
+def _format_value(flags, width, precision, conversion, value):
+    """Renders one integer argument the way the keyboard's printf would have.
+    """
+    if conversion in 'di':
+        value = value - (1 << 32) if value & 0x80000000 else value
+        conversion = 'd'
+    elif conversion == 'u':
+        conversion = 'd'
+    elif conversion == 'p':
+        conversion = 'x'
+        flags += '#'
+    elif conversion == 'c':
+        return ('%' + flags.replace('0', '') + width + 'c') % chr(value & 0xFF)
+
+    if conversion == 'b':
+        digits = format(value, 'b')
+        if precision:
+            digits = digits.zfill(int(precision))
+        if '-' in flags:
+            return digits.ljust(int(width or 0))
+        return digits.rjust(int(width or 0), '0' if '0' in flags else ' ')
+
+    spec = '%' + flags + width
+    if precision:
+        spec += '.' + precision
+    return (spec + conversion) % value
+
+
+def render(fmt, args):
+    """Renders a format string with the raw argument bytes from a log record.
+    """
+    output = []
+    position = 0
+    offset = 0
+
+    def next_u32():
+        nonlocal offset
+        if offset + 4 > len(args):
+            return None
+        value, = struct.unpack_from('<I', args, offset)
+        offset += 4
+        return value
+
+    for match in FORMAT_RE.finditer(fmt):
+        output.append(fmt[position:match.start()])
+        position = match.end()
+        flags, width, precision, _, conversion = match.groups()
+        precision = precision or ''
+
+        if conversion == '%':
+            output.append('%')
+            continue
+
+        if width == '*':
+            width = next_u32()
+            width = '' if width is None else str(width)
+        if precision == '*':
+            precision = next_u32()
+            precision = '' if precision is None else str(precision)
+
+        if conversion in NUMERIC_CONVERSIONS:
+            value = next_u32()
+            output.append('?' if value is None else _format_value(flags, width, precision, conversion, value))
+
+        elif conversion in 'sS':
+            end = args.find(b'\0', offset)
+            if end < 0:
+                output.append('?')
+                offset = len(args)
+                continue
+            text = args[offset:end].decode('utf-8', errors='replace')
+            offset = end + 1
+            spec = '%' + flags + width + ('.' + precision if precision else '') + 's'
+            output.append(spec % text)
+
+        elif conversion in FLOAT_CONVERSIONS:
+            output.append('?')
+
+        else:
+            # Unknown conversion, the keyboard stopped storing arguments here
+            output.append(fmt[match.start():])
+            position = len(fmt)
+            break
+
+    output.append(fmt[position:])
+    return ''.join(output)
+
+
+class BinaryLogDecoder:
+    """Turns the byte stream from a keyboard console into text.
+
+    Zero bytes delimit records, so the padding at the end of partially filled console reports is skipped over. A record that was split by such padding fails its length check and is reported instead of rendered.
+    """
+    def __init__(self, elf_strings):
+        self.strings = elf_strings
+        self.frame = bytearray()
+
+    def feed(self, data):
+        """Consumes raw console bytes, returning the text for every record that was completed.
+        """
+        output = []
+
+        for byte in data:
+            if byte:
+                self.frame.append(byte)
+                continue
+
+            if self.frame:
+                output.append(self.decode_frame(bytes(self.frame)))
+                self.frame.clear()
+
+        return ''.join(output)
+
+    def decode_frame(self, frame):
+        record = cobs_decode(frame)
+
+        if record is None or len(record) < 5 or record[0] != len(record):
+            return '<corrupt log record>\n'
+
+        address, = struct.unpack_from('<I', record, 1)
+        args = record[5:]
+
+        if address == 0:
+            dropped, = struct.unpack_from('<H', args.ljust(2, b'\0'))
+            return f'<{dropped} log records dropped>\n'
+
+        fmt = self.strings.string_at(address)
+        if fmt is None:
+            return f'<unknown format string at 0x{address:08X}>\n'
+
+        return render(fmt, args)
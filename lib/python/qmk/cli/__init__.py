@@ -37,6 +37,7 @@ subcommands = [
     'qmk.cli.chibios.confmigrate',
     'qmk.cli.clean',
     'qmk.cli.compile',
+    'qmk.cli.console_decode',
     'qmk.cli.docs',
     'qmk.cli.doctor',
     'qmk.cli.find',
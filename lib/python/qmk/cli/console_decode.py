@@ -0,0 +1,72 @@
+"""Decode binary console logs from keyboards built with CONSOLE_BINARY_LOG_ENABLE.
+"""
+import sys
+from pathlib import Path
+
+from milc import cli
+
+from qmk.binary_log import BinaryLogDecoder, ElfStrings
+
+CONSOLE_USAGE_PAGE = 0xFF31
+CONSOLE_USAGE = 0x0074
+
+
+def _find_console(device):
+    """Returns the HID path of the first console matching `device` (VID:PID), or of any console if it's not set.
+    """
+    import hid
+
+    vid = pid = None
+    if device:
+        vid, pid = (int(part, 16) for part in device.split(':'))
+
+    for info in hid.enumerate(vid or 0, pid or 0):
+        if info['usage_page'] == CONSOLE_USAGE_PAGE and info['usage'] == CONSOLE_USAGE:
+            return info
+
+    return None
+
+
+@cli.argument('-e', '--elf', arg_only=True, type=Path, required=True, help='The .elf file the keyboard firmware was built as.')
+@cli.argument('-d', '--device', help='Device to select, as VID:PID in hex. Defaults to the first console found.')
+@cli.argument('-i', '--input', arg_only=True, type=Path, help='Decode a raw console capture instead of reading from a keyboard. Use "-" for stdin.')
+@cli.subcommand('Render the binary console log of a keyboard.')
+def console_decode(cli):
+    """Renders the binary console log of a keyboard built with `CONSOLE_BINARY_LOG_ENABLE = yes`.
+
+    The keyboard only sends the addresses of its format strings, so the .elf file it was built from is needed to turn them back into text.
+    """
+    if not cli.args.elf.exists():
+        cli.log.error('ELF file %s does not exist!', cli.args.elf)
+        return False
+
+    decoder = BinaryLogDecoder(ElfStrings(cli.args.elf.read_bytes()))
+
+    if cli.args.input:
+        stream = sys.stdin.buffer if str(cli.args.input) == '-' else cli.args.input.open('rb')
+        with stream:
+            sys.stdout.write(decoder.feed(stream.read()))
+        return True
+
+    import hid
+
+    info = _find_console(cli.config.console_decode.device)
+    if not info:
+        cli.log.error('No keyboard console found.')
+        return False
+
+    cli.log.info('Connected to %s %s (%04X:%04X)', info['manufacturer_string'], info['product_string'], info['vendor_id'], info['product_id'])
+
+    device = hid.Device(path=info['path'])
+    try:
+        while True:
+            data = device.read(32, 1000)
+            if data:
+                sys.stdout.write(decoder.feed(data))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        device.close()
+
+    return True
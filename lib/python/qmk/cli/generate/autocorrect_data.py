@@ -165,6 +165,15 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
+def key_index(c: str) -> int:
+    """Returns the bit of character `c` in a bitmap branch node mask."""
+    if c == "'":
+        return 26
+    if c == ':':
+        return 27
+    return TYPO_CHARS[c] - KC_A
+
+
 def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
@@ -175,48 +184,81 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
   """
     table = []
 
+    # Subtrees that serialize identically are only emitted once; later branches
+    # link to the first copy. Maps a subtree signature to (entry, byte delta).
+    signatures = {}
+    emitted = {}
+
+    def make_leaf(typo, correction):
+        word_boundary_ending = typo[-1] == ':'
+        typo = typo.strip(':')
+        i = 0  # Make the autocorrection data for this entry and serialize it.
+        while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+            i += 1
+        backspaces = len(typo) - i - 1 + word_boundary_ending
+        assert 0 <= backspaces <= 63
+        correction = correction[i:]
+        bs_count = [backspaces + 128]
+        return bs_count + list(bytes(correction, 'ascii')) + [0]
+
+    def signature(trie_node):
+        key = id(trie_node)
+        if key not in signatures:
+            if 'LEAF' in trie_node:
+                signatures[key] = ('LEAF', tuple(make_leaf(*trie_node['LEAF'])))
+            else:
+                signatures[key] = tuple((c, signature(child)) for c, child in sorted(trie_node.items()))
+        return signatures[key]
+
+    def link(trie_node):
+        return emitted.get(signature(trie_node)) or traverse(trie_node)
+
     # Traverse trie in depth first order.
-    def traverse(trie_node):
+    def traverse(trie_node, root=False):
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': make_leaf(*trie_node['LEAF']), 'links': [], 'byte_offset': 0}
             table.append(entry)
+            emitted.setdefault(signature(trie_node), (entry, 0))
         elif len(trie_node) == 1:  # Handle trie node with a single child.
-            c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
+            entry = {'chars': '', 'byte_offset': 0}
+            table.append(entry)
 
             # It's common for a trie to have long chains of single-child nodes. We
             # find the whole chain so that we can serialize it more efficiently.
+            # Every position within the chain is itself a valid node to link to.
             while len(trie_node) == 1 and 'LEAF' not in trie_node:
+                emitted.setdefault(signature(trie_node), (entry, len(entry['chars'])))
                 c, trie_node = next(iter(trie_node.items()))
                 entry['chars'] += c
 
-            table.append(entry)
             entry['links'] = [traverse(trie_node)]
         else:  # Handle trie node with multiple children.
             entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
+            # The root is always a bitmap branch, so the firmware can reject a key
+            # ending no typo with a single bit test. Elsewhere, use it when smaller.
+            entry['bitmap'] = root or len(trie_node) >= 4
+            if entry['bitmap']:
+                entry['chars'] = ''.join(sorted(trie_node.keys(), key=key_index))
             table.append(entry)
-            entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
+            emitted.setdefault(signature(trie_node), (entry, 0))
+            entry['links'] = [link(trie_node[c]) for c in entry['chars']]
+        return (entry, 0)
 
-    traverse(trie)
+    traverse(trie, root=True)
 
     def serialize(e: Dict[str, Any]) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
             return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
+        elif e['bitmap']:  # Handle a bitmap branch table entry.
+            mask = 0
+            for c in e['chars']:
+                mask |= 1 << key_index(c)
+            data = [192 | (mask >> 24), mask & 255, (mask >> 8) & 255, (mask >> 16) & 255]
+            for link in e['links']:
+                data += encode_link(link)
+            return data
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
@@ -232,9 +274,10 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
+def encode_link(link: Tuple[Dict[str, Any], int]) -> List[int]:
     """Encodes a node link as two bytes."""
-    byte_offset = link['byte_offset']
+    entry, delta = link
+    byte_offset = entry['byte_offset'] + delta
     if not (0 <= byte_offset <= 0xffff):
         cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
         sys.exit(1)
@@ -0,0 +1,52 @@
+import struct
+
+from qmk.binary_log import BinaryLogDecoder, cobs_decode, render
+
+
+class FakeStrings:
+    def __init__(self, strings):
+        self.strings = strings
+
+    def string_at(self, address):
+        return self.strings.get(address)
+
+
+def _u32(*values):
+    return b''.join(struct.pack('<I', value & 0xFFFFFFFF) for value in values)
+
+
+def _frame(address, args=b''):
+    record = bytes([5 + len(args)]) + _u32(address) + args
+    encoded = bytearray([0])
+    code_index = 0
+    for byte in record:
+        if byte == 0:
+            encoded[code_index] = len(encoded) - code_index
+            code_index = len(encoded)
+            encoded.append(0)
+        else:
+            encoded.append(byte)
+    encoded[code_index] = len(encoded) - code_index
+    return bytes(encoded) + b'\0'
+
+
+def test_render_integers():
+    assert render('%d %3u %04X %c %%', _u32(-5, 7, 0xAB, ord('q'))) == '-5   7 00AB q %'
+
+
+def test_render_binary_and_strings():
+    assert render('%08b [%-4s] %*d', _u32(5) + b'ab\0' + _u32(3, 9)) == '00000101 [ab  ]   9'
+
+
+def test_render_missing_arguments():
+    assert render('%u %u', _u32(1)) == '1 ?'
+
+
+def test_cobs_decode_rejects_truncated_frames():
+    assert cobs_decode(b'\x05ab') is None
+
+
+def test_decoder_skips_padding():
+    decoder = BinaryLogDecoder(FakeStrings({0x1234: 'row %u\n'}))
+    output = decoder.feed(b'\0\0' + _frame(0x1234, _u32(3)) + b'\0' * 7 + _frame(0, b'\x02\0'))
+    assert output == 'row 3\n<2 log records dropped>\n'
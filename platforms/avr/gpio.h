@@ -36,3 +36,12 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define togglePin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t gpio_port_t;
+typedef uint8_t gpio_port_data_t;
+
+#define getPinPort(pin) ((gpio_port_t)((pin) >> PORT_SHIFTER))
+#define getPinPortBit(pin) ((pin)&0xF)
+#define readPortData(port) PINx_ADDRESS((port) << PORT_SHIFTER)
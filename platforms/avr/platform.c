@@ -16,6 +16,12 @@
 
 #include "platform_deps.h"
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include <stdbool.h>
+#    include <avr/sleep.h>
+#    include "timer.h"
+#endif
+
 static void disable_jtag(void) {
 // To use PF4-7 (PC2-5 on ATmega32A), disable JTAG by writing JTD bit twice within four cycles.
 #if (defined(__AVR_AT90USB646__) || defined(__AVR_AT90USB647__) || defined(__AVR_AT90USB1286__) || defined(__AVR_AT90USB1287__) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__))
@@ -30,3 +36,30 @@ static void disable_jtag(void) {
 void platform_setup(void) {
     disable_jtag();
 }
+
+#ifdef IDLE_SLEEP_ENABLE
+static volatile bool idle_woken = false;
+
+void platform_idle_sleep(uint32_t timeout_ms) {
+    // Idle mode keeps the timer and USB running; the 1ms timer tick guarantees a wakeup for the elapsed check
+    uint32_t start = timer_read32();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (timer_elapsed32(start) < timeout_ms) {
+        cli();
+        // Checked with interrupts disabled, so a wake can't slip in between the check and sleeping
+        if (idle_woken) {
+            sei();
+            break;
+        }
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    idle_woken = false;
+}
+
+void platform_idle_wake(void) {
+    idle_woken = true;
+}
+#endif
@@ -84,6 +84,20 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Each bank needs to be erasable without touching the other, so a sector has to start exactly where the second bank does
+    bool bank_boundary = false;
+    for (int i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) - base_offset == (WEAR_LEVELING_BANK_SIZE)) {
+            bank_boundary = true;
+            break;
+        }
+    }
+    if (!bank_boundary) {
+        chSysHalt("No sector boundary between the wear_leveling banks");
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
+
     return true;
 }
 
@@ -117,6 +131,41 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    bool          ret     = true;
+    bool          covered = false;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        // Only erase the sectors starting within the range
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (offset < address || offset >= address + length) {
+            // A range without a sector start is fine if it lies within a sector already erased by an earlier step for the same bank,
+            // rather than one which started in the other bank
+            if (offset <= address && address < offset + flashGetSectorSize(flash, first_sector + i) && offset >= address - (address % (WEAR_LEVELING_BANK_SIZE))) {
+                covered = true;
+            }
+            continue;
+        }
+        covered = true;
+
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    if (!covered) {
+        bs_dprintf("Erase of %lu bytes at 0x%08lX contains no sector start\n", (unsigned long)length, (unsigned long)address);
+        return false;
+    }
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -43,6 +43,12 @@
 #    endif
 #endif
 
+// Sector sizes are only known at runtime, backing_store_erase_range() erases every sector starting within the range.
+// 1kB covers the smallest sectors of the supported MCUs, ranges inside a sector erased by an earlier step are skipped.
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE 1024
+#endif // BACKING_STORE_ERASE_SIZE
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
@@ -187,6 +187,13 @@ bool backing_store_erase(void) {
     return true;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + address, length);
+    restore_interrupts(interrupts);
+    return true;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
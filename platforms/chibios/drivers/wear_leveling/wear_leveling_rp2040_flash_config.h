@@ -21,6 +21,11 @@
 #    define WEAR_LEVELING_LOGICAL_SIZE 4096
 #endif // WEAR_LEVELING_LOGICAL_SIZE
 
+// Smallest unit erased by backing_store_erase_range()
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (FLASH_SECTOR_SIZE)
+#endif // BACKING_STORE_ERASE_SIZE
+
 // Define how much flash space we have (defaults to lib/pico-sdk/src/boards/include/boards/***)
 #ifndef WEAR_LEVELING_RP2040_FLASH_SIZE
 #    define WEAR_LEVELING_RP2040_FLASH_SIZE (PICO_FLASH_SIZE_BYTES)
@@ -43,3 +43,29 @@ typedef ioline_t pin_t;
 #define readPin(pin) palReadLine(pin)
 
 #define togglePin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+#if defined(PAL_PORT) && defined(PAL_PAD)
+typedef ioportid_t   gpio_port_t;
+typedef ioportmask_t gpio_port_data_t;
+
+#    define getPinPort(pin) PAL_PORT(pin)
+#    define getPinPortBit(pin) PAL_PAD(pin)
+#    define readPortData(port) palReadPort(port)
+#endif
+
+/* Edge notifications by pin. */
+
+#if (PAL_USE_CALLBACKS == TRUE)
+#    define enablePinChangeCallback(pin, callback)                \
+        do {                                                      \
+            palEnableLineEvent((pin), PAL_EVENT_MODE_BOTH_EDGES); \
+            palSetLineCallback((pin), (callback), NULL);          \
+        } while (0)
+#    define disablePinChangeCallback(pin) palDisableLineEvent(pin)
+#    if defined(MCU_STM32)
+// EXTI line N is shared by pad N of every port, so e.g. A3 and B3 cannot both raise pin change callbacks
+#        define getPinChangeLine(pin) PAL_PAD(pin)
+#    endif
+#endif
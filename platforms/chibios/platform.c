@@ -19,4 +19,21 @@
 void platform_setup(void) {
     halInit();
     chSysInit();
-}
\ No newline at end of file
+}
+
+#ifdef IDLE_SLEEP_ENABLE
+// Signalled by wake sources, taken by the main thread while it sleeps
+static BSEMAPHORE_DECL(idle_wake_semaphore, true);
+
+void platform_idle_sleep(uint32_t timeout_ms) {
+    // Hand the CPU to the idle thread, which executes WFI when CORTEX_ENABLE_WFI_IDLE is enabled
+    chBSemWaitTimeout(&idle_wake_semaphore, TIME_MS2I(timeout_ms));
+}
+
+void platform_idle_wake(void) {
+    // Works from both thread and interrupt context
+    syssts_t status = chSysGetStatusAndLockX();
+    chBSemSignalI(&idle_wake_semaphore);
+    chSysRestoreStatusX(status);
+}
+#endif
@@ -70,3 +70,16 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #else
 #    error Unknown EEPROM driver.
 #endif
+
+#if defined(EEPROM_WEAR_LEVELING)
+// Writes in between are deferred, and logged together on commit
+void eeprom_batch_begin(void);
+void eeprom_batch_commit(void);
+#else
+#    define eeprom_batch_begin() \
+        do {                     \
+        } while (0)
+#    define eeprom_batch_commit() \
+        do {                      \
+        } while (0)
+#endif
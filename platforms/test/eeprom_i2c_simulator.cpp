@@ -0,0 +1,106 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "eeprom_i2c_simulator.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void set_time(uint32_t t);
+}
+
+// Start, address and data bytes, plus their ACKs at 400kHz
+#define SIM_BYTE_TIME_US 23
+
+void EepromI2cSimulator::reset() {
+    memory.assign(EXTERNAL_EEPROM_BYTE_COUNT, 0xFF);
+    pointer        = 0;
+    clock_us       = 0;
+    busy_until_us  = 0;
+    transactions   = 0;
+    nacks          = 0;
+    page_writes    = 0;
+    page_overruns  = 0;
+    write_cycle_us = 0;
+    set_time(0);
+}
+
+std::uint64_t EepromI2cSimulator::now_us() {
+    // Tests may also move the platform timer on, e.g. to simulate the rest of the main loop
+    std::uint64_t timer_us = (std::uint64_t)timer_read32() * 1000;
+    if (timer_us > clock_us) {
+        clock_us = timer_us;
+    }
+    return clock_us;
+}
+
+bool EepromI2cSimulator::busy() {
+    return now_us() < busy_until_us;
+}
+
+bool EepromI2cSimulator::bus_transaction(std::uint16_t bytes) {
+    ++transactions;
+
+    // The device address gets NACKed while a write cycle is in progress, ending the transaction
+    bool acked = !busy();
+    clock_us += (acked ? bytes + 1 : 1) * SIM_BYTE_TIME_US;
+    set_time(clock_us / 1000);
+
+    if (!acked) {
+        ++nacks;
+    }
+    return acked;
+}
+
+i2c_status_t EepromI2cSimulator::transmit(std::uint8_t device, const std::uint8_t* data, std::uint16_t length) {
+    if (!bus_transaction(length)) {
+        return I2C_STATUS_ERROR;
+    }
+
+    // Memory address first, then any data to be written
+    pointer = 0;
+    for (std::uint16_t i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE && i < length; ++i) {
+        pointer = (pointer << 8) | data[i];
+    }
+    pointer %= EXTERNAL_EEPROM_BYTE_COUNT;
+    if (length <= EXTERNAL_EEPROM_ADDRESS_SIZE) {
+        return I2C_STATUS_SUCCESS;
+    }
+
+    std::uint32_t page_base = pointer - (pointer % EXTERNAL_EEPROM_PAGE_SIZE);
+    std::uint32_t offset    = pointer % EXTERNAL_EEPROM_PAGE_SIZE;
+    std::uint16_t count     = length - EXTERNAL_EEPROM_ADDRESS_SIZE;
+    if (offset + count > EXTERNAL_EEPROM_PAGE_SIZE) {
+        ++page_overruns;
+    }
+    for (std::uint16_t i = 0; i < count; ++i) {
+        memory[page_base + ((offset + i) % EXTERNAL_EEPROM_PAGE_SIZE)] = data[EXTERNAL_EEPROM_ADDRESS_SIZE + i];
+    }
+
+    ++page_writes;
+    busy_until_us = clock_us + (std::uint64_t)EXTERNAL_EEPROM_WRITE_TIME * 1000;
+    write_cycle_us += (std::uint64_t)EXTERNAL_EEPROM_WRITE_TIME * 1000;
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t EepromI2cSimulator::receive(std::uint8_t device, std::uint8_t* data, std::uint16_t length) {
+    if (!bus_transaction(length)) {
+        return I2C_STATUS_ERROR;
+    }
+
+    // Sequential reads roll over the whole memory
+    for (std::uint16_t i = 0; i < length; ++i) {
+        data[i] = memory[pointer];
+        pointer = (pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+extern "C" void i2c_init(void) {}
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    return EepromI2cSimulator::Instance().transmit(address, data, length);
+}
+
+extern "C" i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    return EepromI2cSimulator::Instance().receive(address, data, length);
+}
@@ -0,0 +1,63 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+#include "eeprom.h"
+}
+
+/*
+    Host model of an I2C EEPROM behind i2c_master, driven by the platform timer.
+
+    Every bus transaction takes time at 400kHz. Page writes wrap around within
+    their page like the real parts do, and for EXTERNAL_EEPROM_WRITE_TIME after
+    a write every transaction is NACKed.
+*/
+class EepromI2cSimulator {
+   public:
+    static EepromI2cSimulator& Instance() {
+        static EepromI2cSimulator instance;
+        return instance;
+    }
+
+    void reset();
+
+    // Simulated time, in microseconds
+    std::uint64_t now_us();
+    bool          busy();
+
+    // Contents of the EEPROM itself, ignoring anything the driver hasn't written yet
+    std::uint8_t peek(std::uint32_t address) const {
+        return memory[address];
+    }
+    void poke(std::uint32_t address, std::uint8_t value) {
+        memory[address] = value;
+    }
+
+    // Statistics since the last reset
+    std::uint64_t transactions   = 0;
+    std::uint64_t nacks          = 0;
+    std::uint64_t page_writes    = 0;
+    std::uint64_t page_overruns  = 0; // page writes which wrapped around within their page
+    std::uint64_t write_cycle_us = 0; // total busy time
+
+    i2c_status_t transmit(std::uint8_t device, const std::uint8_t* data, std::uint16_t length);
+    i2c_status_t receive(std::uint8_t device, std::uint8_t* data, std::uint16_t length);
+
+   private:
+    EepromI2cSimulator() {
+        reset();
+    }
+
+    // Accounts for a transaction of the given number of bytes, returning false if it was NACKed
+    bool bus_transaction(std::uint16_t bytes);
+
+    std::vector<std::uint8_t> memory;
+    std::uint32_t             pointer;
+    std::uint64_t             clock_us;
+    std::uint64_t             busy_until_us;
+};
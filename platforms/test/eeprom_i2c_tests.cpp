@@ -0,0 +1,209 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iostream>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "eeprom_i2c_simulator.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class EepromI2cTest : public testing::Test {
+   protected:
+    EepromI2cSimulator& sim = EepromI2cSimulator::Instance();
+
+    void SetUp() override {
+        sim.reset();
+        eeprom_driver_init();
+    }
+
+    // Writes out anything pending
+    void flush() {
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+        eeprom_i2c_flush();
+#endif
+    }
+
+    // Runs the main loop until everything's been written, returning the longest time spent in a single task call
+    std::uint64_t run_task() {
+        std::uint64_t longest = 0;
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+        for (int i = 0; i < 10000; ++i) {
+            std::uint64_t start        = sim.now_us();
+            std::uint64_t transactions = sim.transactions;
+            eeprom_i2c_task();
+            longest = std::max(longest, sim.now_us() - start);
+            // Nothing left to poll for or write
+            if (sim.transactions == transactions) {
+                break;
+            }
+            advance_time(1);
+        }
+#endif
+        return longest;
+    }
+
+    void expect_device_contents(std::uint32_t address, const std::vector<std::uint8_t>& data) {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            EXPECT_EQ(sim.peek(address + i), data[i]) << "Mismatch at 0x" << std::hex << address + i;
+        }
+    }
+};
+
+TEST_F(EepromI2cTest, ReadBack) {
+    std::vector<std::uint8_t> data(3 * EXTERNAL_EEPROM_PAGE_SIZE + 7);
+    std::iota(data.begin(), data.end(), 0x10);
+
+    // Deliberately unaligned, spanning several pages
+    eeprom_write_block(data.data(), (void *)5, data.size());
+
+    std::vector<std::uint8_t> readback(data.size());
+    eeprom_read_block(readback.data(), (const void *)5, readback.size());
+    EXPECT_EQ(readback, data);
+
+    flush();
+    EXPECT_EQ(sim.page_overruns, 0) << "Page writes crossed page boundaries";
+    expect_device_contents(5, data);
+
+    eeprom_read_block(readback.data(), (const void *)5, readback.size());
+    EXPECT_EQ(readback, data);
+}
+
+TEST_F(EepromI2cTest, UpdateFunctions) {
+    eeprom_update_dword((uint32_t *)(EXTERNAL_EEPROM_PAGE_SIZE - 2), 0x12345678);
+    eeprom_update_byte((uint8_t *)(EXTERNAL_EEPROM_PAGE_SIZE - 3), 0x9A);
+    EXPECT_EQ(eeprom_read_dword((const uint32_t *)(EXTERNAL_EEPROM_PAGE_SIZE - 2)), 0x12345678);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)(EXTERNAL_EEPROM_PAGE_SIZE - 3)), 0x9A);
+
+    flush();
+    expect_device_contents(EXTERNAL_EEPROM_PAGE_SIZE - 3, {0x9A, 0x78, 0x56, 0x34, 0x12});
+}
+
+TEST_F(EepromI2cTest, Erase) {
+    std::uint8_t value = 0x42;
+    eeprom_write_block(&value, (void *)100, 1);
+    eeprom_driver_erase();
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)100), 0x00);
+    EXPECT_EQ(sim.peek(100), 0x00);
+    EXPECT_EQ(sim.peek(EXTERNAL_EEPROM_BYTE_COUNT - 1), 0x00);
+}
+
+#if !defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+TEST_F(EepromI2cTest, AckPolling_NoFixedDelay) {
+    std::vector<std::uint8_t> data(4 * EXTERNAL_EEPROM_PAGE_SIZE, 0x5A);
+
+    std::uint64_t start = sim.now_us();
+    eeprom_write_block(data.data(), (void *)0, data.size());
+    std::uint64_t elapsed = sim.now_us() - start;
+
+    // Only waits for the earlier pages' write cycles, the last one completes in the background
+    EXPECT_EQ(sim.page_writes, 4);
+    EXPECT_GT(sim.nacks, 0) << "Expected ACK polling";
+    EXPECT_LT(elapsed, 4 * EXTERNAL_EEPROM_WRITE_TIME * 1000) << "Waited out the last write cycle";
+    EXPECT_TRUE(sim.busy());
+
+    // Reads wait for the write cycle to complete
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)0), 0x5A);
+    EXPECT_FALSE(sim.busy());
+}
+#endif // !defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+TEST_F(EepromI2cTest, WriteBehind_DoesNotBlock) {
+    std::vector<std::uint8_t> data(EXTERNAL_EEPROM_WRITE_BEHIND_PAGES * EXTERNAL_EEPROM_PAGE_SIZE, 0xA5);
+
+    eeprom_write_block(data.data(), (void *)0, data.size());
+    EXPECT_EQ(sim.transactions, 0) << "Writes should only have touched the cache";
+
+    std::vector<std::uint8_t> readback(data.size());
+    eeprom_read_block(readback.data(), (const void *)0, readback.size());
+    EXPECT_EQ(readback, data);
+    EXPECT_EQ(sim.transactions, 0) << "Reads of pending writes should come from the cache";
+
+    std::uint64_t longest = run_task();
+    EXPECT_EQ(sim.page_writes, EXTERNAL_EEPROM_WRITE_BEHIND_PAGES);
+    EXPECT_LT(longest, 1000) << "Task should never wait on a write cycle";
+    expect_device_contents(0, data);
+}
+
+TEST_F(EepromI2cTest, WriteBehind_Coalesces) {
+    for (std::uint32_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; ++i) {
+        eeprom_update_byte((uint8_t *)(EXTERNAL_EEPROM_PAGE_SIZE + i), i);
+    }
+    flush();
+    EXPECT_EQ(sim.page_writes, 1) << "Writes to the same page should have been combined";
+}
+
+TEST_F(EepromI2cTest, WriteBehind_GapsPreserved) {
+    for (std::uint32_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; ++i) {
+        sim.poke(i, 0x30 + i);
+    }
+
+    std::uint8_t first = 0x01, last = 0x02;
+    eeprom_write_block(&first, (void *)1, 1);
+    eeprom_write_block(&last, (void *)(EXTERNAL_EEPROM_PAGE_SIZE - 2), 1);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)2), 0x32) << "Unwritten bytes should come from the EEPROM";
+    flush();
+
+    EXPECT_EQ(sim.page_writes, 1);
+    EXPECT_EQ(sim.peek(0), 0x30);
+    EXPECT_EQ(sim.peek(1), 0x01);
+    EXPECT_EQ(sim.peek(2), 0x32);
+    EXPECT_EQ(sim.peek(EXTERNAL_EEPROM_PAGE_SIZE - 2), 0x02);
+    EXPECT_EQ(sim.peek(EXTERNAL_EEPROM_PAGE_SIZE - 1), 0x30 + EXTERNAL_EEPROM_PAGE_SIZE - 1);
+}
+
+TEST_F(EepromI2cTest, WriteBehind_Eviction) {
+    std::vector<std::uint8_t> data((EXTERNAL_EEPROM_WRITE_BEHIND_PAGES + 3) * EXTERNAL_EEPROM_PAGE_SIZE);
+    std::iota(data.begin(), data.end(), 0x20);
+
+    eeprom_write_block(data.data(), (void *)0, data.size());
+    EXPECT_EQ(sim.page_writes, 3) << "Only the pages which didn't fit should have been written";
+
+    std::vector<std::uint8_t> readback(data.size());
+    eeprom_read_block(readback.data(), (const void *)0, readback.size());
+    EXPECT_EQ(readback, data);
+
+    flush();
+    expect_device_contents(0, data);
+}
+#endif // defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+
+/*
+    Saving a 2kB keymap from VIA, which arrives as 28 byte writes in separate
+    main loop iterations. Reports the longest the keyboard was blocked for.
+*/
+TEST_F(EepromI2cTest, KeymapSave) {
+    std::vector<std::uint8_t> keymap(2048);
+    std::iota(keymap.begin(), keymap.end(), 0x01);
+
+    std::uint64_t longest = 0;
+    std::uint64_t start   = sim.now_us();
+    for (std::size_t offset = 0; offset < keymap.size(); offset += 28) {
+        std::size_t   length      = std::min<std::size_t>(28, keymap.size() - offset);
+        std::uint64_t write_start = sim.now_us();
+        eeprom_write_block(&keymap[offset], (void *)(64 + offset), length);
+        longest = std::max(longest, sim.now_us() - write_start);
+
+#if defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+        std::uint64_t task_start = sim.now_us();
+        eeprom_i2c_task();
+        longest = std::max(longest, sim.now_us() - task_start);
+#endif
+        advance_time(1);
+    }
+    longest = std::max(longest, run_task());
+    flush();
+    std::uint64_t total = sim.now_us() - start;
+
+    expect_device_contents(64, keymap);
+    EXPECT_EQ(sim.page_overruns, 0) << "Page writes crossed page boundaries";
+
+    std::cout << "[ I2C      ] 2048 byte keymap save: " << sim.page_writes << " page writes, " << sim.nacks << " busy polls, longest block " << longest << "us, " << total << "us total" << std::endl;
+    RecordProperty("page_writes", (int)sim.page_writes);
+    RecordProperty("longest_block_us", (int)longest);
+}
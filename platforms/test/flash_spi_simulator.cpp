@@ -0,0 +1,257 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "flash_spi_simulator.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void set_time(uint32_t t);
+}
+
+// One byte at 8MHz, also used for the chip select setup and hold time
+#define SIM_BYTE_TIME_US 1
+
+// Typical timings of an MX25L4006E
+#define SIM_PAGE_PROGRAM_US 1400
+#define SIM_SECTOR_ERASE_US 60000
+#define SIM_BLOCK_ERASE_US 700000
+#define SIM_CHIP_ERASE_US 4000000
+
+#define SIM_CMD_WRSR 0x01
+#define SIM_CMD_PP 0x02
+#define SIM_CMD_READ 0x03
+#define SIM_CMD_WRDI 0x04
+#define SIM_CMD_RDSR 0x05
+#define SIM_CMD_WREN 0x06
+#define SIM_CMD_FASTREAD 0x0B
+#define SIM_CMD_SE 0x20
+#define SIM_CMD_CE 0x60
+#define SIM_CMD_BE 0xD8
+
+#define SIM_FLAG_WIP 0x01
+#define SIM_FLAG_WEL 0x02
+
+void FlashSpiSimulator::reset() {
+    memory.assign(EXTERNAL_FLASH_SIZE, 0xFF);
+    program_data.clear();
+    clock_us         = 0;
+    busy_until_us    = 0;
+    write_enabled    = false;
+    selected         = false;
+    ignored          = false;
+    command          = 0;
+    address          = 0;
+    index            = 0;
+    transactions     = 0;
+    status_polls     = 0;
+    reads            = 0;
+    fast_reads       = 0;
+    bytes_read       = 0;
+    page_programs    = 0;
+    erases           = 0;
+    page_overruns    = 0;
+    ignored_commands = 0;
+    protocol_errors  = 0;
+    set_time(0);
+}
+
+std::uint64_t FlashSpiSimulator::now_us() {
+    // Tests may also move the platform timer on, e.g. to simulate the rest of the main loop
+    std::uint64_t timer_us = (std::uint64_t)timer_read32() * 1000;
+    if (timer_us > clock_us) {
+        clock_us = timer_us;
+    }
+    return clock_us;
+}
+
+bool FlashSpiSimulator::busy() {
+    return now_us() < busy_until_us;
+}
+
+void FlashSpiSimulator::clock_bytes(std::uint32_t count) {
+    clock_us = now_us() + count * SIM_BYTE_TIME_US;
+    set_time(clock_us / 1000);
+}
+
+void FlashSpiSimulator::start_operation(std::uint64_t duration_us) {
+    // The write enable latch stays set until the operation completes, see the status register below
+    write_enabled = false;
+    busy_until_us = clock_us + duration_us;
+}
+
+void FlashSpiSimulator::select() {
+    clock_bytes(1);
+    ++transactions;
+    selected = true;
+    ignored  = false;
+    command  = 0;
+    address  = 0;
+    index    = 0;
+    program_data.clear();
+}
+
+std::uint8_t FlashSpiSimulator::exchange(std::uint8_t mosi, bool is_read) {
+    if (!selected) {
+        ++protocol_errors;
+        return 0xFF;
+    }
+    clock_bytes(1);
+
+    std::uint32_t i = index++;
+    if (i == 0) {
+        command = mosi;
+        if (busy() && command != SIM_CMD_RDSR) {
+            ignored = true;
+            ++ignored_commands;
+            return 0xFF;
+        }
+        switch (command) {
+            case SIM_CMD_WREN:
+                write_enabled = true;
+                break;
+            case SIM_CMD_WRDI:
+                write_enabled = false;
+                break;
+            case SIM_CMD_RDSR:
+                ++status_polls;
+                break;
+            case SIM_CMD_READ:
+                ++reads;
+                break;
+            case SIM_CMD_FASTREAD:
+                ++fast_reads;
+                break;
+        }
+        return 0xFF;
+    }
+    if (ignored) {
+        return 0xFF;
+    }
+
+    if (command == SIM_CMD_RDSR) {
+        return (busy() ? SIM_FLAG_WIP : 0) | ((busy() || write_enabled) ? SIM_FLAG_WEL : 0);
+    }
+
+    // Address, most significant byte first, followed by the dummy bytes of a FAST_READ
+    std::uint32_t header = 1 + EXTERNAL_FLASH_ADDRESS_SIZE + (command == SIM_CMD_FASTREAD ? EXTERNAL_FLASH_SPI_FAST_READ_DUMMY_BYTES : 0);
+    if (i < header) {
+        if (is_read) {
+            ++protocol_errors;
+        }
+        if (i <= EXTERNAL_FLASH_ADDRESS_SIZE) {
+            address = (address << 8) | mosi;
+        }
+        return 0xFF;
+    }
+
+    switch (command) {
+        case SIM_CMD_READ:
+        case SIM_CMD_FASTREAD:
+            // Sequential reads roll over the whole memory
+            ++bytes_read;
+            return memory[(address + i - header) % EXTERNAL_FLASH_SIZE];
+        case SIM_CMD_PP:
+            if (is_read) {
+                ++protocol_errors;
+            }
+            program_data.push_back(mosi);
+            return 0xFF;
+        default:
+            ++protocol_errors;
+            return 0xFF;
+    }
+}
+
+void FlashSpiSimulator::deselect() {
+    if (!selected) {
+        ++protocol_errors;
+        return;
+    }
+    selected = false;
+    clock_bytes(1);
+
+    if (ignored || index == 0) {
+        return;
+    }
+
+    // Programs and erases start once the chip is deselected
+    std::uint32_t size = 0;
+    std::uint64_t duration_us;
+    switch (command) {
+        case SIM_CMD_PP:
+            duration_us = SIM_PAGE_PROGRAM_US;
+            break;
+        case SIM_CMD_SE:
+            size        = EXTERNAL_FLASH_SECTOR_SIZE;
+            duration_us = SIM_SECTOR_ERASE_US;
+            break;
+        case SIM_CMD_BE:
+            size        = EXTERNAL_FLASH_BLOCK_SIZE;
+            duration_us = SIM_BLOCK_ERASE_US;
+            break;
+        case SIM_CMD_CE:
+            size        = EXTERNAL_FLASH_SIZE;
+            duration_us = SIM_CHIP_ERASE_US;
+            break;
+        default:
+            return;
+    }
+
+    if (!write_enabled || (command != SIM_CMD_CE && index < 1 + EXTERNAL_FLASH_ADDRESS_SIZE)) {
+        ++ignored_commands;
+        return;
+    }
+
+    address %= EXTERNAL_FLASH_SIZE;
+    if (command == SIM_CMD_PP) {
+        std::uint32_t page_base = address - (address % EXTERNAL_FLASH_PAGE_SIZE);
+        std::uint32_t offset    = address % EXTERNAL_FLASH_PAGE_SIZE;
+        if (offset + program_data.size() > EXTERNAL_FLASH_PAGE_SIZE) {
+            ++page_overruns;
+        }
+        // Programming can only clear bits
+        for (std::size_t i = 0; i < program_data.size(); ++i) {
+            memory[page_base + ((offset + i) % EXTERNAL_FLASH_PAGE_SIZE)] &= program_data[i];
+        }
+        ++page_programs;
+    } else {
+        std::uint32_t base = (command == SIM_CMD_CE) ? 0 : address - (address % size);
+        std::fill(memory.begin() + base, memory.begin() + base + size, 0xFF);
+        ++erases;
+    }
+    start_operation(duration_us);
+}
+
+extern "C" void spi_init(void) {}
+
+extern "C" bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    FlashSpiSimulator::Instance().select();
+    return true;
+}
+
+extern "C" spi_status_t spi_write(uint8_t data) {
+    FlashSpiSimulator::Instance().exchange(data, false);
+    return SPI_STATUS_SUCCESS;
+}
+
+extern "C" spi_status_t spi_read(void) {
+    return FlashSpiSimulator::Instance().exchange(0xFF, true);
+}
+
+extern "C" spi_status_t spi_transmit(const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        FlashSpiSimulator::Instance().exchange(data[i], false);
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+extern "C" spi_status_t spi_receive(uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        data[i] = FlashSpiSimulator::Instance().exchange(0xFF, true);
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+extern "C" void spi_stop(void) {
+    FlashSpiSimulator::Instance().deselect();
+}
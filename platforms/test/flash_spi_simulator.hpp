@@ -0,0 +1,72 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "spi_master.h"
+#include "flash_spi.h"
+}
+
+/*
+    Host model of a SPI NOR flash behind spi_master, driven by the platform timer.
+
+    Every byte clocked takes time. Page programs wrap around within their page
+    and can only clear bits, programs and erases need the write enable latch
+    set, and while one is in progress anything other than RDSR is ignored.
+*/
+class FlashSpiSimulator {
+   public:
+    static FlashSpiSimulator& Instance() {
+        static FlashSpiSimulator instance;
+        return instance;
+    }
+
+    void reset();
+
+    // Simulated time, in microseconds
+    std::uint64_t now_us();
+    bool          busy();
+
+    // Contents of the flash itself
+    std::uint8_t peek(std::uint32_t address) const {
+        return memory[address];
+    }
+
+    // Statistics since the last reset
+    std::uint64_t transactions     = 0;
+    std::uint64_t status_polls     = 0;
+    std::uint64_t reads            = 0; // READ commands
+    std::uint64_t fast_reads       = 0; // FAST_READ commands
+    std::uint64_t bytes_read       = 0;
+    std::uint64_t page_programs    = 0;
+    std::uint64_t erases           = 0;
+    std::uint64_t page_overruns    = 0; // page programs which wrapped around within their page
+    std::uint64_t ignored_commands = 0; // sent while busy, or without the write enable latch set
+    std::uint64_t protocol_errors  = 0; // data clocked before the command's address and dummy bytes
+
+    void         select();
+    void         deselect();
+    std::uint8_t exchange(std::uint8_t mosi, bool is_read);
+
+   private:
+    FlashSpiSimulator() {
+        reset();
+    }
+
+    void clock_bytes(std::uint32_t count);
+    void start_operation(std::uint64_t duration_us);
+
+    std::vector<std::uint8_t> memory;
+    std::vector<std::uint8_t> program_data;
+    std::uint64_t             clock_us;
+    std::uint64_t             busy_until_us;
+    bool                      write_enabled;
+    bool                      selected;
+    bool                      ignored;
+    std::uint8_t              command;
+    std::uint32_t             address;
+    std::uint32_t             index; // bytes clocked since selection
+};
@@ -0,0 +1,180 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iostream>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "flash_spi_simulator.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class FlashSpiTest : public testing::Test {
+   protected:
+    FlashSpiSimulator& sim = FlashSpiSimulator::Instance();
+
+    void SetUp() override {
+        sim.reset();
+        flash_init();
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(sim.ignored_commands, 0) << "Commands were sent while busy or not write enabled";
+        EXPECT_EQ(sim.protocol_errors, 0) << "Malformed SPI transactions";
+        EXPECT_EQ(sim.page_overruns, 0) << "Page programs crossed page boundaries";
+    }
+
+    // Runs the main loop until the flash task is done, returning the longest time spent in a single call
+    std::uint64_t run_task() {
+        std::uint64_t  longest = 0;
+        flash_status_t status  = FLASH_STATUS_BUSY;
+        for (int i = 0; i < 10000 && status == FLASH_STATUS_BUSY; ++i) {
+            std::uint64_t start = sim.now_us();
+            status              = flash_task();
+            longest             = std::max(longest, sim.now_us() - start);
+            advance_time(1);
+        }
+        EXPECT_EQ(status, FLASH_STATUS_SUCCESS) << "Task did not complete";
+        return longest;
+    }
+
+    void expect_device_contents(std::uint32_t address, const std::vector<std::uint8_t>& data) {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            EXPECT_EQ(sim.peek(address + i), data[i]) << "Mismatch at 0x" << std::hex << address + i;
+        }
+    }
+
+    void expect_read_command(std::uint64_t count) {
+#if defined(EXTERNAL_FLASH_SPI_FAST_READ)
+        EXPECT_EQ(sim.fast_reads, count);
+        EXPECT_EQ(sim.reads, 0);
+#else
+        EXPECT_EQ(sim.reads, count);
+        EXPECT_EQ(sim.fast_reads, 0);
+#endif
+    }
+};
+
+TEST_F(FlashSpiTest, ReadBack) {
+    std::vector<std::uint8_t> data(3 * EXTERNAL_FLASH_PAGE_SIZE + 7);
+    std::iota(data.begin(), data.end(), 0x10);
+
+    // Deliberately unaligned, spanning several pages
+    EXPECT_EQ(flash_write_block(5, data.data(), data.size()), FLASH_STATUS_SUCCESS);
+
+    std::vector<std::uint8_t> readback(data.size());
+    EXPECT_EQ(flash_read_block(5, readback.data(), readback.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_EQ(readback, data);
+    EXPECT_EQ(sim.page_programs, 4);
+    expect_device_contents(5, data);
+    expect_read_command(1);
+}
+
+TEST_F(FlashSpiTest, Read_SingleTransaction) {
+    std::vector<std::uint8_t> readback(70000);
+
+    // Nothing is known about the chip after init, so the first read checks it isn't busy
+    EXPECT_EQ(flash_read_block(0, readback.data(), 16), FLASH_STATUS_SUCCESS);
+    EXPECT_EQ(sim.status_polls, 1);
+
+    // Once idle, reads don't need to poll, and stream for longer than a single SPI transfer
+    std::uint64_t transactions = sim.transactions;
+    EXPECT_EQ(flash_read_block(100, readback.data(), readback.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_EQ(sim.transactions - transactions, 1);
+    EXPECT_EQ(sim.status_polls, 1);
+    EXPECT_EQ(sim.bytes_read, 16 + readback.size());
+    expect_read_command(2);
+}
+
+TEST_F(FlashSpiTest, Write_ReturnsWhileProgramming) {
+    std::vector<std::uint8_t> data(EXTERNAL_FLASH_PAGE_SIZE, 0x5A);
+
+    EXPECT_EQ(flash_write_block(EXTERNAL_FLASH_PAGE_SIZE, data.data(), data.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_TRUE(sim.busy()) << "Waited out the page program";
+    EXPECT_TRUE(flash_is_busy());
+
+    // Reads wait for the program to complete
+    std::vector<std::uint8_t> readback(data.size());
+    EXPECT_EQ(flash_read_block(EXTERNAL_FLASH_PAGE_SIZE, readback.data(), readback.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_FALSE(sim.busy());
+    EXPECT_FALSE(flash_is_busy());
+    EXPECT_EQ(readback, data);
+}
+
+TEST_F(FlashSpiTest, Async_WritesInBackground) {
+    std::vector<std::uint8_t> data(4 * EXTERNAL_FLASH_PAGE_SIZE + 7);
+    std::iota(data.begin(), data.end(), 0x20);
+
+    EXPECT_EQ(flash_write_block_async(EXTERNAL_FLASH_PAGE_SIZE - 3, data.data(), data.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_EQ(sim.page_programs, 1) << "Only the first page should have been started";
+    EXPECT_TRUE(flash_is_busy());
+
+    std::uint64_t longest = run_task();
+    EXPECT_EQ(sim.page_programs, 6);
+    EXPECT_LT(longest, 1000) << "Task should never wait on a page program";
+    EXPECT_FALSE(flash_is_busy());
+    expect_device_contents(EXTERNAL_FLASH_PAGE_SIZE - 3, data);
+}
+
+TEST_F(FlashSpiTest, Async_CompletedByOtherCommands) {
+    std::vector<std::uint8_t> data(3 * EXTERNAL_FLASH_PAGE_SIZE, 0xA5);
+
+    EXPECT_EQ(flash_write_block_async(0, data.data(), data.size()), FLASH_STATUS_SUCCESS);
+
+    std::vector<std::uint8_t> readback(data.size());
+    EXPECT_EQ(flash_read_block(0, readback.data(), readback.size()), FLASH_STATUS_SUCCESS);
+    EXPECT_EQ(readback, data);
+    EXPECT_EQ(sim.page_programs, 3);
+    EXPECT_EQ(flash_task(), FLASH_STATUS_SUCCESS) << "Nothing further should be pending";
+}
+
+TEST_F(FlashSpiTest, EraseSector) {
+    std::vector<std::uint8_t> data(2 * EXTERNAL_FLASH_SECTOR_SIZE, 0x00);
+    EXPECT_EQ(flash_write_block(0, data.data(), data.size()), FLASH_STATUS_SUCCESS);
+
+    EXPECT_EQ(flash_erase_sector(EXTERNAL_FLASH_SECTOR_SIZE), FLASH_STATUS_SUCCESS);
+    EXPECT_TRUE(sim.busy()) << "Waited out the erase";
+    EXPECT_EQ(sim.erases, 1);
+
+    EXPECT_EQ(flash_wait(), FLASH_STATUS_SUCCESS);
+    EXPECT_FALSE(sim.busy());
+    EXPECT_EQ(sim.peek(EXTERNAL_FLASH_SECTOR_SIZE - 1), 0x00);
+    EXPECT_EQ(sim.peek(EXTERNAL_FLASH_SECTOR_SIZE), 0xFF);
+    EXPECT_EQ(sim.peek(2 * EXTERNAL_FLASH_SECTOR_SIZE - 1), 0xFF);
+}
+
+/*
+    Appending 2kB to a wear-leveling write log in 8 byte writes, each in a
+    separate main loop iteration. Reports the longest the keyboard was blocked
+    for.
+*/
+TEST_F(FlashSpiTest, LogAppends) {
+    std::vector<std::uint8_t> log(2048);
+    std::iota(log.begin(), log.end(), 0x01);
+
+    std::uint64_t longest = 0;
+    std::uint64_t start   = sim.now_us();
+    for (std::size_t offset = 0; offset < log.size(); offset += 8) {
+        std::uint64_t write_start = sim.now_us();
+        EXPECT_EQ(flash_write_block(offset, &log[offset], 8), FLASH_STATUS_SUCCESS);
+        longest = std::max(longest, sim.now_us() - write_start);
+
+        std::uint64_t task_start = sim.now_us();
+        flash_task();
+        longest = std::max(longest, sim.now_us() - task_start);
+
+        // At least a millisecond for the rest of the main loop, the platform timer only ticks whole milliseconds
+        advance_time(2);
+    }
+    EXPECT_EQ(flash_wait(), FLASH_STATUS_SUCCESS);
+    std::uint64_t total = sim.now_us() - start;
+
+    expect_device_contents(0, log);
+    EXPECT_LT(longest, 1000) << "Writes should not wait out their own page program";
+
+    std::cout << "[ FLASH    ] 2048 byte log append: " << sim.page_programs << " page programs, " << sim.status_polls << " busy polls, longest block " << longest << "us, " << total << "us total" << std::endl;
+    RecordProperty("page_programs", (int)sim.page_programs);
+    RecordProperty("longest_block_us", (int)longest);
+}
@@ -16,6 +16,26 @@
 
 #include "platform_deps.h"
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include <stdbool.h>
+#    include "wait.h"
+#endif
+
 void platform_setup(void) {
     // do nothing
-}
\ No newline at end of file
+}
+
+#ifdef IDLE_SLEEP_ENABLE
+static bool idle_woken = false;
+
+void platform_idle_sleep(uint32_t timeout_ms) {
+    if (!idle_woken) {
+        wait_ms(timeout_ms);
+    }
+    idle_woken = false;
+}
+
+void platform_idle_wake(void) {
+    idle_woken = true;
+}
+#endif
@@ -23,3 +23,42 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+eeprom_i2c_DEFS := -DEEPROM_I2C -DEEPROM_I2C_24LC64
+eeprom_i2c_write_behind_DEFS := $(eeprom_i2c_DEFS) \
+	-DEXTERNAL_EEPROM_WRITE_BEHIND \
+	-DEXTERNAL_EEPROM_WRITE_BEHIND_PAGES=4
+
+eeprom_i2c_INC := \
+	$(TOP_DIR)/drivers/eeprom/
+eeprom_i2c_write_behind_INC := $(eeprom_i2c_INC)
+
+eeprom_i2c_SRC := \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(TOP_DIR)/drivers/eeprom/eeprom_i2c.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_simulator.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+eeprom_i2c_write_behind_SRC := $(eeprom_i2c_SRC)
+
+flash_spi_DEFS := -DFLASH_SPI -DEXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN=0
+flash_spi_fast_read_DEFS := $(flash_spi_DEFS) \
+	-DEXTERNAL_FLASH_SPI_FAST_READ
+
+flash_spi_INC := \
+	$(TOP_DIR)/drivers/flash/
+flash_spi_fast_read_INC := $(flash_spi_INC)
+
+flash_spi_SRC := \
+	$(TOP_DIR)/drivers/flash/flash_spi.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/flash_spi_simulator.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/flash_spi_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+flash_spi_fast_read_SRC := $(flash_spi_SRC)
+
+usb_report_queue_INC := \
+	$(TMK_PATH)/protocol/chibios/
+
+usb_report_queue_SRC := \
+	$(TMK_PATH)/protocol/chibios/usb_report_queue.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/usb_report_queue_tests.cpp
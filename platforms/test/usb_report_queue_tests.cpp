@@ -0,0 +1,150 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstring>
+
+extern "C" {
+#include "usb_report_queue.h"
+}
+
+// boot keyboard report: mods, reserved, keys[6]
+typedef std::array<uint8_t, 8> boot_report_t;
+// NKRO report: mods, key bitmap, cut down to fit the reports this queue is built with
+typedef std::array<uint8_t, 7> nkro_report_t;
+
+#define KEY_A 0x04
+#define KEY_B 0x05
+#define MOD_LSHIFT 0x02
+
+class UsbReportQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        usb_report_queue_clear(&queue);
+    }
+
+    bool push(const boot_report_t &report) {
+        return usb_report_queue_push(&queue, USB_REPORT_KEYBOARD_BOOT, report.data(), report.size());
+    }
+
+    bool push(const nkro_report_t &report) {
+        return usb_report_queue_push(&queue, USB_REPORT_NKRO, report.data(), report.size());
+    }
+
+    bool push(int8_t x, int8_t y, uint8_t buttons = 0) {
+        report_mouse_t report = {};
+        report.buttons        = buttons;
+        report.x              = x;
+        report.y              = y;
+        return usb_report_queue_push(&queue, USB_REPORT_MOUSE, &report, sizeof(report));
+    }
+
+    // Sends the oldest report, as the endpoint would
+    usb_report_t *send() {
+        usb_report_t *report = usb_report_queue_start(&queue);
+        EXPECT_NE(report, nullptr);
+        usb_report_queue_complete(&queue);
+        return report;
+    }
+
+    template <typename T>
+    void expect_sent(const T &expected) {
+        usb_report_t *report = send();
+        ASSERT_EQ(report->size, expected.size());
+        EXPECT_EQ(memcmp(report->report.raw, expected.data(), expected.size()), 0);
+    }
+
+    usb_report_queue_t queue;
+};
+
+TEST_F(UsbReportQueue, ModifierAfterKeyIsNotMerged) {
+    // The host must see "a" before the shift, rather than a single "A"
+    ASSERT_TRUE(push(boot_report_t{}));
+    usb_report_queue_start(&queue);
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    ASSERT_TRUE(push(boot_report_t{MOD_LSHIFT, 0, KEY_A}));
+    EXPECT_EQ(queue.count, 3);
+
+    usb_report_queue_complete(&queue);
+    expect_sent(boot_report_t{0, 0, KEY_A});
+    expect_sent(boot_report_t{MOD_LSHIFT, 0, KEY_A});
+    EXPECT_EQ(queue.count, 0);
+}
+
+TEST_F(UsbReportQueue, NkroPressesKeepTheirOrder) {
+    nkro_report_t a = {}, ab = {};
+    a[1] |= 1 << (KEY_A % 8);
+    ab[1] |= 1 << (KEY_A % 8) | 1 << (KEY_B % 8);
+
+    ASSERT_TRUE(push(nkro_report_t{}));
+    usb_report_queue_start(&queue);
+    ASSERT_TRUE(push(a));
+    ASSERT_TRUE(push(ab));
+    EXPECT_EQ(queue.count, 3);
+
+    usb_report_queue_complete(&queue);
+    expect_sent(a);
+    expect_sent(ab);
+}
+
+TEST_F(UsbReportQueue, ReleaseAfterPressIsNotMerged) {
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    usb_report_queue_start(&queue);
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A, KEY_B}));
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    EXPECT_EQ(queue.count, 3);
+}
+
+TEST_F(UsbReportQueue, RepeatedReportIsDropped) {
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    EXPECT_EQ(queue.count, 1);
+
+    // also when the repeated report is already in flight
+    usb_report_queue_start(&queue);
+    ASSERT_TRUE(push(boot_report_t{0, 0, KEY_A}));
+    EXPECT_EQ(queue.count, 1);
+}
+
+TEST_F(UsbReportQueue, MouseMovementIsSummed) {
+    ASSERT_TRUE(push(1, 2));
+    ASSERT_TRUE(push(3, -4));
+    EXPECT_EQ(queue.count, 1);
+
+    usb_report_t *report = send();
+    EXPECT_EQ(report->report.mouse.x, 4);
+    EXPECT_EQ(report->report.mouse.y, -2);
+}
+
+TEST_F(UsbReportQueue, MouseInFlightIsNotModified) {
+    ASSERT_TRUE(push(1, 0));
+    usb_report_t *in_flight = usb_report_queue_start(&queue);
+    ASSERT_TRUE(push(1, 0));
+    EXPECT_EQ(queue.count, 2);
+    EXPECT_EQ(in_flight->report.mouse.x, 1);
+}
+
+TEST_F(UsbReportQueue, MouseButtonChangeIsNotMerged) {
+    ASSERT_TRUE(push(1, 0));
+    ASSERT_TRUE(push(1, 0, 1));
+    EXPECT_EQ(queue.count, 2);
+}
+
+TEST_F(UsbReportQueue, MouseOverflowIsNotMerged) {
+    ASSERT_TRUE(push(100, 0));
+    ASSERT_TRUE(push(100, 0));
+    EXPECT_EQ(queue.count, 2);
+}
+
+TEST_F(UsbReportQueue, FullQueueRejects) {
+    for (uint8_t i = 0; i < USB_REPORT_QUEUE_SIZE; i++) {
+        ASSERT_TRUE(push(boot_report_t{0, 0, (uint8_t)(KEY_A + i)}));
+    }
+    EXPECT_FALSE(push(boot_report_t{0, 0, KEY_B, KEY_A}));
+    EXPECT_EQ(queue.count, USB_REPORT_QUEUE_SIZE);
+
+    send();
+    EXPECT_TRUE(push(boot_report_t{0, 0, KEY_B, KEY_A}));
+}
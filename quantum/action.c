@@ -44,6 +44,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "encoder.h"
 #endif
 
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
+
 int tp_buttons;
 
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
@@ -78,6 +82,9 @@ void action_exec(keyevent_t event) {
         ac_dprintf("\n");
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
         retro_tapping_counter++;
+#endif
+#ifdef LATENCY_TRACKING_ENABLE
+        latency_tracking_mark(LATENCY_STAGE_ACTION_EXEC);
 #endif
     }
 
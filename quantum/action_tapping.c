@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -59,13 +60,29 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
-static keyrecord_t tapping_key                         = {};
-static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
-static uint8_t     waiting_buffer_head                 = 0;
-static uint8_t     waiting_buffer_tail                 = 0;
+_Static_assert(WAITING_BUFFER_SIZE >= 2 && WAITING_BUFFER_SIZE <= 128, "WAITING_BUFFER_SIZE must be between 2 and 128");
+_Static_assert((WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1)) == 0, "WAITING_BUFFER_SIZE must be a power of two");
+
+#    define WAITING_BUFFER_NEXT(i) (((i) + 1) & (WAITING_BUFFER_SIZE - 1))
+
+/* Number of hash buckets used to track which keys are present in the
+ * waiting buffer, split by pressed/released state. A zero count proves
+ * that a key is absent, so most lookups never touch the buffer itself.
+ */
+#    define WAITING_BUFFER_KEY_BUCKETS 16
+#    define WAITING_BUFFER_KEY_BUCKET(key) ((uint8_t)((key).row * 7 + (key).col) & (WAITING_BUFFER_KEY_BUCKETS - 1))
+
+static keyrecord_t tapping_key                                        = {};
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE]                = {};
+static uint8_t     waiting_buffer_head                                = 0;
+static uint8_t     waiting_buffer_tail                                = 0;
+static uint8_t     waiting_buffer_pressed                             = 0;
+static uint8_t     waiting_buffer_keys[2][WAITING_BUFFER_KEY_BUCKETS] = {};
+static uint16_t    waiting_buffer_overflows                           = 0;
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -88,6 +105,9 @@ void action_tapping_process(keyrecord_t record) {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
             ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+            if (waiting_buffer_overflows < UINT16_MAX) {
+                waiting_buffer_overflows++;
+            }
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){0};
@@ -98,11 +118,12 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
+            waiting_buffer_deq();
         } else {
             break;
         }
@@ -112,6 +133,16 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Number of times the waiting buffer overflowed
+ *
+ * Each overflow discards the pending tapping state and buffered key events,
+ * so a non-zero value suggests WAITING_BUFFER_SIZE should be increased.
+ * Saturates at UINT16_MAX.
+ */
+uint16_t action_tapping_overflow_count(void) {
+    return waiting_buffer_overflows;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -441,41 +472,77 @@ bool process_tapping(keyrecord_t *keyp) {
 
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a key event to the waiting buffer, updating the pressed count and
+ * key presence buckets. Returns false when the buffer is full.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (WAITING_BUFFER_NEXT(waiting_buffer_head) == waiting_buffer_tail) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_head                 = WAITING_BUFFER_NEXT(waiting_buffer_head);
+
+    waiting_buffer_keys[record.event.pressed][WAITING_BUFFER_KEY_BUCKET(record.event.key)]++;
+    if (record.event.pressed) {
+        waiting_buffer_pressed++;
+    }
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest key event from the waiting buffer.
+ */
+static void waiting_buffer_deq(void) {
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+
+    waiting_buffer_keys[event.pressed][WAITING_BUFFER_KEY_BUCKET(event.key)]--;
+    if (event.pressed) {
+        waiting_buffer_pressed--;
+    }
+    waiting_buffer_tail = WAITING_BUFFER_NEXT(waiting_buffer_tail);
+}
+
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Drops all key events from the waiting buffer.
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head    = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_pressed = 0;
+    memset(waiting_buffer_keys, 0, sizeof(waiting_buffer_keys));
+}
+
+/** \brief Waiting buffer may contain
+ *
+ * Returns false if no event for the given key and state is in the waiting
+ * buffer. A true result may be a false positive and has to be confirmed by
+ * scanning the buffer.
+ */
+static inline bool waiting_buffer_may_contain(keypos_t key, bool pressed) {
+    return waiting_buffer_keys[pressed][WAITING_BUFFER_KEY_BUCKET(key)] != 0;
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Returns true if the waiting buffer holds the opposite event (press for a
+ * release, release for a press) of the given key.
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    if (!waiting_buffer_may_contain(event.key, !event.pressed)) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
         }
@@ -485,28 +552,27 @@ bool waiting_buffer_typed(keyevent_t event) {
 
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Returns true if any press event is in the waiting buffer.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_pressed != 0;
 }
 
 /** \brief Scan buffer for tapping
  *
- * FIXME: Needs docs
+ * Settles the tapping key as a tap if its release is already in the waiting
+ * buffer and happened within the tapping term.
  */
 void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - release of tapping key is not buffered
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_may_contain(tapping_key.event.key, false)) {
         return;
     }
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
         keyrecord_t *candidate = &waiting_buffer[i];
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && WITHIN_TAPPING_TERM(candidate->event)) {
             tapping_key.tap.count = 1;
@@ -536,7 +602,7 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
         ac_dprintf("[%u]=", i);
         debug_record(waiting_buffer[i]);
         ac_dprintf(" ");
@@ -162,7 +162,7 @@ void audio_toggle(void) {
         stop_all_notes();
     }
     audio_config.enable ^= 1;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_update_deferred(eeconfig_update_audio_current);
     if (audio_config.enable) {
         audio_on_user();
     } else {
@@ -172,7 +172,7 @@ void audio_toggle(void) {
 
 void audio_on(void) {
     audio_config.enable = 1;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_update_deferred(eeconfig_update_audio_current);
     audio_on_user();
     PLAY_SONG(audio_on_song);
 }
@@ -183,7 +183,7 @@ void audio_off(void) {
     wait_ms(100);
     audio_stop_all();
     audio_config.enable = 0;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_update_deferred(eeconfig_update_audio_current);
 }
 
 bool audio_is_on(void) {
@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 backlight_config_t backlight_config;
 
+// Value to write out once a deferred EEPROM update is flushed, so that any _noeeprom changes made in the meantime aren't persisted
+static backlight_config_t backlight_config_saved;
+
 #ifndef BACKLIGHT_DEFAULT_LEVEL
 #    define BACKLIGHT_DEFAULT_LEVEL BACKLIGHT_LEVELS
 #endif
@@ -32,6 +35,15 @@ backlight_config_t backlight_config;
 static uint8_t breathing_period = BREATHING_PERIOD;
 #endif
 
+static void eeconfig_update_backlight_saved(void) {
+    eeconfig_update_backlight(backlight_config_saved.raw);
+}
+
+static void backlight_update_eeprom_deferred(void) {
+    backlight_config_saved = backlight_config;
+    eeconfig_update_deferred(eeconfig_update_backlight_saved);
+}
+
 /** \brief Backlight initialization
  *
  * FIXME: needs doc
@@ -58,7 +70,7 @@ void backlight_increase(void) {
         backlight_config.level++;
     }
     backlight_config.enable = 1;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight increase: %u\n", backlight_config.level);
     backlight_set(backlight_config.level);
 }
@@ -71,7 +83,7 @@ void backlight_decrease(void) {
     if (backlight_config.level > 0) {
         backlight_config.level--;
         backlight_config.enable = !!backlight_config.level;
-        eeconfig_update_backlight(backlight_config.raw);
+        backlight_update_eeprom_deferred();
     }
     dprintf("backlight decrease: %u\n", backlight_config.level);
     backlight_set(backlight_config.level);
@@ -100,7 +112,7 @@ void backlight_enable(void) {
     backlight_config.enable = true;
     if (backlight_config.raw == 1) // enabled but level == 0
         backlight_config.level = 1;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight enable\n");
     backlight_set(backlight_config.level);
 }
@@ -113,7 +125,7 @@ void backlight_disable(void) {
     if (!backlight_config.enable) return; // do nothing if backlight is already off
 
     backlight_config.enable = false;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight disable\n");
     backlight_set(0);
 }
@@ -136,7 +148,7 @@ void backlight_step(void) {
         backlight_config.level = 0;
     }
     backlight_config.enable = !!backlight_config.level;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight step: %u\n", backlight_config.level);
     backlight_set(backlight_config.level);
 }
@@ -157,7 +169,7 @@ void backlight_level_noeeprom(uint8_t level) {
  */
 void backlight_level(uint8_t level) {
     backlight_level_noeeprom(level);
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
 }
 
 uint8_t eeconfig_read_backlight(void) {
@@ -165,6 +177,7 @@ uint8_t eeconfig_read_backlight(void) {
 }
 
 void eeconfig_update_backlight(uint8_t val) {
+    backlight_config_saved.raw = val;
     eeprom_update_byte(EECONFIG_BACKLIGHT, val);
 }
 
@@ -213,7 +226,7 @@ void backlight_enable_breathing(void) {
     if (backlight_config.breathing) return; // do nothing if breathing is already on
 
     backlight_config.breathing = true;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight breathing enable\n");
     breathing_enable();
 }
@@ -226,7 +239,7 @@ void backlight_disable_breathing(void) {
     if (!backlight_config.breathing) return; // do nothing if breathing is already off
 
     backlight_config.breathing = false;
-    eeconfig_update_backlight(backlight_config.raw);
+    backlight_update_eeprom_deferred();
     dprintf("backlight breathing disable\n");
     breathing_disable();
 }
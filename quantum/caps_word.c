@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include "caps_word.h"
 #include "timer.h"
+#include "timeout.h"
 #include "action.h"
 #include "action_util.h"
 
@@ -39,6 +40,7 @@ void caps_word_task(void) {
 
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
+    timeout_start(TIMEOUT_CAPS_WORD, CAPS_WORD_IDLE_TIMEOUT, caps_word_task);
 }
 #else
 void caps_word_task(void) {}
@@ -68,6 +70,9 @@ void caps_word_off(void) {
 
     unregister_weak_mods(MOD_MASK_SHIFT); // Make sure weak shift is off.
     caps_word_active = false;
+#if CAPS_WORD_IDLE_TIMEOUT > 0
+    timeout_cancel(TIMEOUT_CAPS_WORD);
+#endif // CAPS_WORD_IDLE_TIMEOUT > 0
     caps_word_set_user(false);
 }
 
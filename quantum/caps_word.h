@@ -20,7 +20,7 @@
 #    define CAPS_WORD_IDLE_TIMEOUT 5000 // Default timeout of 5 seconds.
 #endif
 
-/** @brief Matrix scan task for Caps Word feature */
+/** @brief Handles the Caps Word idle timeout, invoked once the idle deadline has passed. */
 void caps_word_task(void);
 
 #if CAPS_WORD_IDLE_TIMEOUT > 0
@@ -0,0 +1,164 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Bit-sliced symmetric per-key algorithm, with the same behaviour as sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Rather than one counter byte per key, bit N of every key's counter in a row is stored together in one matrix_row_t
+"plane", so the counters of a whole row are updated at once with a handful of word-wide operations.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// Number of bit-planes needed to hold a counter value of DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_PLANES 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_PLANES 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_PLANES 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_PLANES 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_PLANES 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_PLANES 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_PLANES 7
+#    else
+#        define DEBOUNCE_PLANES 8
+#    endif
+
+static matrix_row_t debounce_planes[MATRIX_ROWS][DEBOUNCE_PLANES];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_planes, 0, sizeof(debounce_planes));
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+// Keys with a non-zero counter
+static inline matrix_row_t running_keys(const matrix_row_t planes[]) {
+    matrix_row_t running = 0;
+    for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+        running |= planes[plane];
+    }
+    return running;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes  = debounce_planes[row];
+        matrix_row_t  running = running_keys(planes);
+        if (!running) {
+            continue;
+        }
+
+        // Ripple-borrow subtraction of elapsed_time from every counter in the row
+        matrix_row_t borrow = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            matrix_row_t counter = planes[plane];
+            matrix_row_t elapsed = (elapsed_time >> plane) & 1 ? ~(matrix_row_t)0 : 0;
+            planes[plane]        = counter ^ elapsed ^ borrow;
+            borrow               = (~counter & (elapsed | borrow)) | (counter & elapsed & borrow);
+        }
+
+        // Counters at or below elapsed_time have expired -- those which went to zero, wrapped, or were exceeded by
+        // bits of elapsed_time above the counter width
+        matrix_row_t expired = running;
+        if (!(elapsed_time >> DEBOUNCE_PLANES)) {
+            expired &= borrow | ~running_keys(planes);
+        }
+        matrix_row_t remaining = running & ~expired;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            planes[plane] &= remaining;
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (remaining) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  delta  = raw[row] ^ cooked[row];
+
+        // Keys back at their debounced state stop counting, changed keys start counting unless already doing so
+        matrix_row_t start = delta & ~running_keys(planes);
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            planes[plane] &= delta;
+            if ((DEBOUNCE >> plane) & 1) {
+                planes[plane] |= start;
+            }
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,242 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Benchmark for a debounce algorithm, built once per DEBOUNCE_TYPE. Synthetic bounce and chatter traces are replayed at
+a 1kHz scan rate over different matrix sizes, reporting:
+ - host CPU time per debounce() call, idle and while keys are moving -- only useful to compare algorithms;
+ - worst-case latency from the first physical edge of a keystroke to the debounced state reflecting it, and how many
+   keystrokes never showed up at all because activity elsewhere in the row held them back until the key changed again;
+ - the share of isolated sub-DEBOUNCE glitches on released keys which never reach the debounced matrix.
+*/
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+#define BENCHMARK_FINGERS 4
+#define BENCHMARK_STROKES 400
+#define BENCHMARK_IDLE_SCANS 20000
+#define BENCHMARK_BOUNCE_WINDOW 4
+#define BENCHMARK_SETTLE_TIME (4 * DEBOUNCE + 20)
+
+struct TraceEvent {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     level;
+};
+
+// Expectation that the debounced state of a key reaches `level`, attributed to an edge at `time`.
+// Keystrokes are lost if the next edge on the key arrives at `expires` first; chatter strokes instead expect the key
+// to stay released until `expires`.
+struct Stroke {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     level;
+    bool     chatter;
+    uint32_t expires;
+};
+
+class DebounceBenchmark : public ::testing::TestWithParam<uint8_t> {
+   protected:
+    void SetUp() override {
+        num_rows = GetParam();
+        memset(raw, 0, sizeof(raw));
+        memset(cooked, 0, sizeof(cooked));
+        set_time(10000);
+        debounce_init(num_rows);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    static bool get(const matrix_row_t matrix[], uint8_t row, uint8_t col) {
+        return matrix[row] & ((matrix_row_t)1 << col);
+    }
+
+    static void set(matrix_row_t matrix[], uint8_t row, uint8_t col, bool level) {
+        if (level) {
+            matrix[row] |= (matrix_row_t)1 << col;
+        } else {
+            matrix[row] &= ~((matrix_row_t)1 << col);
+        }
+    }
+
+    // Replays the trace one scan per millisecond, returning the host nanoseconds spent in debounce()
+    uint64_t replay(std::vector<TraceEvent> &trace, uint32_t duration) {
+        std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent &a, const TraceEvent &b) { return a.time < b.time; });
+
+        uint64_t elapsed_ns = 0;
+        size_t   next       = 0;
+        for (uint32_t t = 0; t < duration; t++) {
+            bool changed = false;
+            for (; next < trace.size() && trace[next].time <= t; next++) {
+                set(raw, trace[next].row, trace[next].col, trace[next].level);
+                changed = true;
+            }
+
+            auto before = std::chrono::steady_clock::now();
+            debounce(raw, cooked, num_rows, changed);
+            elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before).count();
+
+            observe(t);
+            advance_time(1);
+        }
+        return elapsed_ns;
+    }
+
+    // Matches the debounced matrix against outstanding strokes
+    void observe(uint32_t t) {
+        for (auto it = pending.begin(); it != pending.end();) {
+            const Stroke &stroke = *it;
+            if (stroke.chatter) {
+                // A glitch has leaked through if the key reads as pressed before the next one is injected
+                if (t >= stroke.time && get(cooked, stroke.row, stroke.col)) {
+                    chatter_passed++;
+                    it = pending.erase(it);
+                    continue;
+                }
+                if (t >= stroke.expires) {
+                    it = pending.erase(it);
+                    continue;
+                }
+            } else if (t >= stroke.time && get(cooked, stroke.row, stroke.col) == stroke.level) {
+                uint32_t  latency = t - stroke.time;
+                uint32_t &worst   = stroke.level ? worst_press_latency : worst_release_latency;
+                worst             = std::max(worst, latency);
+                it                = pending.erase(it);
+                continue;
+            } else if (t >= stroke.expires) {
+                strokes_lost++;
+                it = pending.erase(it);
+                continue;
+            }
+            ++it;
+        }
+    }
+
+    // Appends a bouncing transition of a key to `level`, returning when it has settled
+    uint32_t add_bounce(std::vector<TraceEvent> &trace, uint32_t t, uint8_t row, uint8_t col, bool level, size_t &previous) {
+        if (previous < pending.size()) {
+            pending[previous].expires = t;
+        }
+        previous = pending.size();
+        trace.push_back({t, row, col, level});
+        pending.push_back({t, row, col, level, false, UINT32_MAX});
+
+        uint32_t settled = t;
+        uint8_t  bounces = rng() % 4;
+        for (uint8_t i = 0; i < bounces; i++) {
+            uint32_t bounce_at = t + 1 + rng() % BENCHMARK_BOUNCE_WINDOW;
+            trace.push_back({bounce_at, row, col, !level});
+            trace.push_back({bounce_at + 1, row, col, level});
+            settled = std::max(settled, bounce_at + 1);
+        }
+        return settled;
+    }
+
+    // Keystrokes from several fingers at once, each on its own set of columns, with contact bounce on both edges
+    uint32_t bounce_trace(std::vector<TraceEvent> &trace) {
+        uint32_t end = 0;
+        for (uint8_t finger = 0; finger < BENCHMARK_FINGERS; finger++) {
+            uint32_t t        = rng() % 50;
+            size_t   previous = SIZE_MAX;
+            for (int stroke = 0; stroke < BENCHMARK_STROKES / BENCHMARK_FINGERS; stroke++) {
+                uint8_t row = rng() % num_rows;
+                uint8_t col = finger + BENCHMARK_FINGERS * (rng() % (MATRIX_COLS / BENCHMARK_FINGERS));
+
+                t = add_bounce(trace, t, row, col, true, previous) + 2 * DEBOUNCE + rng() % 60;
+                t = add_bounce(trace, t, row, col, false, previous) + 2 * DEBOUNCE + rng() % 60;
+            }
+            end = std::max(end, t);
+        }
+        return end + BENCHMARK_SETTLE_TIME;
+    }
+
+    // Isolated glitches shorter than DEBOUNCE on keys which are otherwise released
+    uint32_t chatter_trace(std::vector<TraceEvent> &trace) {
+        uint32_t t = 0;
+        for (int pulse = 0; pulse < BENCHMARK_STROKES; pulse++) {
+            uint8_t  row   = rng() % num_rows;
+            uint8_t  col   = rng() % MATRIX_COLS;
+            uint32_t width = 1 + rng() % (DEBOUNCE > 1 ? DEBOUNCE - 1 : 1);
+
+            trace.push_back({t, row, col, true});
+            trace.push_back({t + width, row, col, false});
+            // Leave the matrix alone long enough for any response to the glitch to show
+            pending.push_back({t, row, col, true, true, t + width + BENCHMARK_SETTLE_TIME});
+            chatter_pulses++;
+            t += width + BENCHMARK_SETTLE_TIME;
+        }
+        return t + BENCHMARK_SETTLE_TIME;
+    }
+
+    void expect_settled(void) {
+        for (uint8_t row = 0; row < num_rows; row++) {
+            EXPECT_EQ(cooked[row], raw[row]) << "row " << +row << " did not settle";
+        }
+    }
+
+    uint8_t            num_rows;
+    matrix_row_t       raw[MATRIX_ROWS];
+    matrix_row_t       cooked[MATRIX_ROWS];
+    std::mt19937       rng{0x5eed};
+    std::vector<Stroke> pending;
+    uint32_t           worst_press_latency   = 0;
+    uint32_t           worst_release_latency = 0;
+    uint32_t           strokes_lost          = 0;
+    uint32_t           chatter_pulses        = 0;
+    uint32_t           chatter_passed        = 0;
+};
+
+TEST_P(DebounceBenchmark, Characterise) {
+    // Idle cost: nothing moving at all
+    std::vector<TraceEvent> idle;
+    double                  idle_ns = (double)replay(idle, BENCHMARK_IDLE_SCANS) / BENCHMARK_IDLE_SCANS;
+
+    // Active cost and latency: bouncing keystrokes
+    std::vector<TraceEvent> bounce;
+    uint32_t                bounce_duration = bounce_trace(bounce);
+    double                  active_ns       = (double)replay(bounce, bounce_duration) / bounce_duration;
+    EXPECT_TRUE(pending.empty()) << pending.size() << " keystrokes still pending after the trace settled";
+    expect_settled();
+    pending.clear();
+
+    // Chatter rejection
+    std::vector<TraceEvent> chatter;
+    uint32_t                chatter_duration = chatter_trace(chatter);
+    replay(chatter, chatter_duration);
+    expect_settled();
+
+    double rejected = chatter_pulses ? 100.0 * (chatter_pulses - chatter_passed) / chatter_pulses : 100.0;
+    printf("%-20s %2ux%-2u DEBOUNCE=%-3u idle %8.1f ns/scan  active %8.1f ns/scan  worst latency press %3lu ms release %3lu ms  lost %3lu  chatter rejected %5.1f%%\n", STR(DEBOUNCE_BENCHMARK_ALGORITHM), num_rows, MATRIX_COLS, DEBOUNCE, idle_ns, active_ns, (unsigned long)worst_press_latency, (unsigned long)worst_release_latency, (unsigned long)strokes_lost, rejected);
+
+    RecordProperty("idle_ns_per_scan", (int)idle_ns);
+    RecordProperty("active_ns_per_scan", (int)active_ns);
+    RecordProperty("worst_press_latency_ms", worst_press_latency);
+    RecordProperty("worst_release_latency_ms", worst_release_latency);
+    RecordProperty("keystrokes_lost", strokes_lost);
+    RecordProperty("chatter_rejected_permille", (int)(rejected * 10));
+}
+
+INSTANTIATE_TEST_CASE_P(MatrixSizes, DebounceBenchmark, ::testing::Values(4, MATRIX_ROWS / 2, MATRIX_ROWS));
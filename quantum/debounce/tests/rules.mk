@@ -28,6 +28,11 @@ debounce_sym_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
 
+debounce_sym_defer_pk_sliced_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_pk_sliced_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_sliced.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
+
 debounce_sym_defer_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
@@ -47,3 +52,36 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=24 -DMATRIX_COLS=24 -DDEBOUNCE=5
+
+DEBOUNCE_BENCHMARK_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+
+debounce_benchmark_sym_defer_g_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_g
+debounce_benchmark_sym_defer_g_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_g.c
+
+debounce_benchmark_sym_defer_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_pk
+debounce_benchmark_sym_defer_pk_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_benchmark_sym_defer_pk_sliced_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_pk_sliced
+debounce_benchmark_sym_defer_pk_sliced_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_sliced.c
+
+debounce_benchmark_sym_defer_pr_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_pr
+debounce_benchmark_sym_defer_pr_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pr.c
+
+debounce_benchmark_sym_eager_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_eager_pk
+debounce_benchmark_sym_eager_pk_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk.c
+
+debounce_benchmark_sym_eager_pr_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_eager_pr
+debounce_benchmark_sym_eager_pr_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pr.c
+
+debounce_benchmark_asym_eager_defer_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=asym_eager_defer_pk
+debounce_benchmark_asym_eager_defer_pk_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c
@@ -5,6 +5,10 @@
 #include <timer.h>
 #include <deferred_exec.h>
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include <idle_sleep.h>
+#endif
+
 #ifndef MAX_DEFERRED_EXECUTORS
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
@@ -12,31 +16,124 @@
 //------------------------------------
 // Helpers
 //
+// Each table is used as two overlapping arrays:
+//  - a binary min-heap of the queued executors ordered by trigger time, packed at the start of the table, so the
+//    task only needs to look at the first entry to know if anything is due;
+//  - a token lookup, where the `heap_index` of entry `(token - 1) % table_count` holds the heap position (plus one)
+//    of the executor owning that token, so that extension and cancellation don't need to scan the table.
+//
+
+static uint8_t current_generation = 0;
+
+static inline bool trigger_before(uint32_t a, uint32_t b) {
+    return ((int32_t)TIMER_DIFF_32(a, b)) < 0;
+}
+
+static inline uint32_t next_run(const deferred_executor_t *entry) {
+    return entry->trigger_time + entry->overrun;
+}
+
+static inline deferred_executor_t *token_slot(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    return &table[(token - 1) % table_count];
+}
+
+static size_t heap_count(deferred_executor_t *table, size_t table_count) {
+    // Queued executors are packed at the start of the table, find the first free entry
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline void heap_place(deferred_executor_t *table, size_t table_count, size_t index, const deferred_executor_t *entry) {
+    table[index].token        = entry->token;
+    table[index].trigger_time = entry->trigger_time;
+    table[index].callback     = entry->callback;
+    table[index].cb_arg       = entry->cb_arg;
+    table[index].overrun      = entry->overrun;
+    token_slot(table, table_count, entry->token)->heap_index = index + 1;
+}
 
-static deferred_token current_token = 0;
+static inline void heap_clear(deferred_executor_t *table, size_t index) {
+    table[index].token        = INVALID_DEFERRED_TOKEN;
+    table[index].trigger_time = 0;
+    table[index].callback     = NULL;
+    table[index].cb_arg       = NULL;
+    table[index].overrun      = 0;
+}
+
+static void heap_sift(deferred_executor_t *table, size_t table_count, size_t count, size_t index) {
+    deferred_executor_t entry = table[index];
+
+    // Move up while earlier than the parent...
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!trigger_before(next_run(&entry), next_run(&table[parent]))) {
+            break;
+        }
+        heap_place(table, table_count, index, &table[parent]);
+        index = parent;
+    }
+
+    // ...otherwise move down while later than the earliest child
+    while (2 * index + 1 < count) {
+        size_t child = 2 * index + 1;
+        if (child + 1 < count && trigger_before(next_run(&table[child + 1]), next_run(&table[child]))) {
+            ++child;
+        }
+        if (!trigger_before(next_run(&table[child]), next_run(&entry))) {
+            break;
+        }
+        heap_place(table, table_count, index, &table[child]);
+        index = child;
+    }
+
+    heap_place(table, table_count, index, &entry);
+}
+
+static void heap_remove(deferred_executor_t *table, size_t table_count, size_t index) {
+    size_t last = heap_count(table, table_count) - 1;
+
+    token_slot(table, table_count, table[index].token)->heap_index = 0;
+    if (index == last) {
+        heap_clear(table, last);
+        return;
+    }
+
+    // Fill the hole with the last executor and restore the heap order
+    deferred_executor_t entry = table[last];
+    heap_clear(table, last);
+    heap_place(table, table_count, index, &entry);
+    heap_sift(table, table_count, last, index);
+}
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
+static inline bool token_find(deferred_executor_t *table, size_t table_count, deferred_token token, size_t *index) {
     if (token == INVALID_DEFERRED_TOKEN) {
         return false;
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
-        }
+    uint8_t heap_index = token_slot(table, table_count, token)->heap_index;
+    if (heap_index == 0 || heap_index > table_count || table[heap_index - 1].token != token) {
+        return false;
     }
+    *index = heap_index - 1;
     return true;
 }
 
 static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+    // Tokens map onto a free slot, with a generation counter to avoid handing out the same token again straight away
+    for (size_t i = 0; i < table_count; ++i) {
+        if (table[i].heap_index == 0) {
+            uint8_t generations = UINT8_MAX / table_count;
+            return i + 1 + table_count * (current_generation++ % generations);
         }
     }
-    return current_token;
+    return INVALID_DEFERRED_TOKEN;
 }
 
 //------------------------------------
@@ -45,111 +142,143 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > UINT8_MAX || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Work out the new token value, dropping out if none were available
+    size_t count = heap_count(table, table_count);
+    if (count == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+    deferred_token token = allocate_token(table, table_count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry and queue it
+    deferred_executor_t entry = {
+        .token        = token,
+        .trigger_time = timer_read32() + delay_ms,
+        .callback     = callback,
+        .cb_arg       = cb_arg,
+        .overrun      = 0,
+    };
+    heap_place(table, table_count, count, &entry);
+    heap_sift(table, table_count, count + 1, count);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table || table_count == 0 || delay_ms == 0) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    size_t index;
+    if (!token_find(table, table_count, token, &index)) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    table[index].trigger_time = timer_read32() + delay_ms;
+    table[index].overrun      = 0;
+    heap_sift(table, table_count, heap_count(table, table_count), index);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
     // Ignore request if the table/token are not valid
-    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table || table_count == 0) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    size_t index;
+    if (!token_find(table, table_count, token, &index)) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    heap_remove(table, table_count, index);
+    return true;
 }
 
-void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+static void deferred_exec_run_due(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
     uint32_t now = timer_read32();
 
+    // Nothing to do if the earliest executor isn't due yet
+    if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN || trigger_before(now, next_run(&table[0]))) {
+        return;
+    }
+
     // Throttle only once per millisecond
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry = &table[i];
-
-            // Check if we're supposed to execute this entry
-            if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+        // Run through the due executors in trigger order. Anything requeued ends up after `now`, so each executor is
+        // invoked at most once per pass.
+        while (table[0].token != INVALID_DEFERRED_TOKEN && !trigger_before(now, next_run(&table[0]))) {
+            // Invoke the callback and work work out if we should be requeued
+            deferred_token token    = table[0].token;
+            uint32_t       delay_ms = table[0].callback(table[0].trigger_time, table[0].cb_arg);
+
+            // The callback may have cancelled, extended or queued executors, so find ours again
+            size_t index;
+            if (!token_find(table, table_count, token, &index)) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                deferred_executor_t *entry = &table[index];
+
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                entry->overrun = 0;
+                if (!trigger_before(now, entry->trigger_time)) {
+#ifdef DEFERRED_EXEC_SKIP_MISSED
+                    // Fallen behind, drop the missed intervals rather than trying to catch up on them.
+                    entry->trigger_time = now + delay_ms;
+#else
+                    // Fallen behind, catch up by one interval on each following pass. Running it from the next pass
+                    // onwards keeps the original trigger times, without starving the other due executors.
+                    uint32_t behind = TIMER_DIFF_32(now + 1, entry->trigger_time);
+                    if (behind > UINT16_MAX) {
+                        entry->trigger_time = now + 1 - UINT16_MAX;
+                        behind              = UINT16_MAX;
+                    }
+                    entry->overrun = behind;
+#endif
                 }
+                heap_sift(table, table_count, heap_count(table, table_count), index);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, table_count, index);
             }
         }
     }
 }
 
+void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    deferred_exec_run_due(table, table_count, last_execution_time);
+
+#ifdef IDLE_SLEEP_ENABLE
+    // Let the main loop sleep until the earliest executor is due, honouring the once-per-millisecond throttle
+    if (table && table_count > 0 && table[0].token != INVALID_DEFERRED_TOKEN) {
+        uint32_t wakeup = next_run(&table[0]);
+        if (!trigger_before(*last_execution_time, wakeup)) {
+            wakeup = *last_execution_time + 1;
+        }
+        idle_sleep_request_wakeup(wakeup);
+    }
+#endif
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -79,13 +79,15 @@ typedef struct deferred_executor_t {
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
+    uint16_t               overrun;
+    uint8_t                heap_index;
 } deferred_executor_t;
 
 /**
  * Configures the supplied deferred executor to be executed after the required number of milliseconds.
  *
  * @param table[in] the custom table used for storage
- * @param table_count[in] the number of available items in the table
+ * @param table_count[in] the number of available items in the table, at most 255
  * @param delay_ms[in] the number of milliseconds before executing the callback
  * @param callback[in] the executor to invoke
  * @param cb_arg[in] the argument to pass to the executor, may be NULL if unused by the executor
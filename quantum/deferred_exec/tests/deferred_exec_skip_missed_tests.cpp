@@ -0,0 +1,49 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+static std::vector<uint32_t> triggers;
+
+static uint32_t repeating_callback(uint32_t trigger_time, void *cb_arg) {
+    triggers.push_back(trigger_time);
+    return 10;
+}
+
+class DeferredExecSkipMissed : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        triggers.clear();
+    }
+
+    deferred_executor_t table[4]  = {};
+    uint32_t            last_exec = 0;
+};
+
+TEST_F(DeferredExecSkipMissed, StallSkipsMissedIntervals) {
+    defer_exec_advanced(table, 4, 10, repeating_callback, NULL);
+
+    // Stall the main loop well past several intervals
+    set_time(1055);
+    deferred_exec_advanced_task(table, 4, &last_exec);
+    ASSERT_EQ(triggers.size(), 1);
+    EXPECT_EQ(triggers[0], 1010);
+
+    // Missed intervals are dropped, the next trigger is relative to when it ran
+    for (uint32_t t = 1056; t <= 1070; ++t) {
+        set_time(t);
+        deferred_exec_advanced_task(table, 4, &last_exec);
+    }
+    ASSERT_EQ(triggers.size(), 2);
+    EXPECT_EQ(triggers[1], 1065);
+}
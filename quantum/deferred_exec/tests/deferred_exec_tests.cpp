@@ -0,0 +1,293 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define TABLE_SIZE 8
+
+struct CallbackLog {
+    std::vector<std::pair<int, uint32_t>> calls; // (id, trigger_time)
+    std::map<int, uint32_t>               repeat;
+    std::map<int, uint32_t>               busy_ms;
+};
+
+struct CallbackArg {
+    CallbackLog *log;
+    int          id;
+};
+
+static uint32_t logging_callback(uint32_t trigger_time, void *cb_arg) {
+    auto arg = static_cast<CallbackArg *>(cb_arg);
+    arg->log->calls.emplace_back(arg->id, trigger_time);
+    advance_time(arg->log->busy_ms[arg->id]);
+    return arg->log->repeat[arg->id];
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        last_exec = 0;
+    }
+
+    void run_until(uint32_t t) {
+        while (timer_read32() < t) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+    }
+
+    deferred_token defer(CallbackArg *arg, uint32_t delay_ms) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, logging_callback, arg);
+    }
+
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_exec;
+    CallbackLog         log;
+};
+
+TEST_F(DeferredExec, ExecutesOnceAfterDelay) {
+    CallbackArg a = {&log, 1};
+    EXPECT_NE(defer(&a, 10), INVALID_DEFERRED_TOKEN);
+
+    run_until(1009);
+    EXPECT_TRUE(log.calls.empty());
+
+    run_until(1100);
+    ASSERT_EQ(log.calls.size(), 1);
+    EXPECT_EQ(log.calls[0].second, 1010);
+}
+
+TEST_F(DeferredExec, InvalidArgumentsAreRejected) {
+    CallbackArg a = {&log, 1};
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_SIZE, 0, logging_callback, &a), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_SIZE, 10, nullptr, &a), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(nullptr, TABLE_SIZE, 10, logging_callback, &a), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, INVALID_DEFERRED_TOKEN, 10));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToTriggerTime) {
+    CallbackArg a = {&log, 1};
+    log.repeat[1] = 5;
+    defer(&a, 5);
+
+    run_until(1021);
+    ASSERT_EQ(log.calls.size(), 4);
+    for (size_t i = 0; i < log.calls.size(); ++i) {
+        EXPECT_EQ(log.calls[i].second, 1005 + 5 * i);
+    }
+}
+
+TEST_F(DeferredExec, ExecutesInTriggerOrder) {
+    CallbackArg args[TABLE_SIZE];
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        args[i] = {&log, i};
+    }
+    const uint32_t delays[TABLE_SIZE] = {40, 10, 70, 20, 80, 30, 60, 50};
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_NE(defer(&args[i], delays[i]), INVALID_DEFERRED_TOKEN);
+    }
+
+    run_until(1100);
+    std::vector<int> order;
+    for (auto &call : log.calls) {
+        order.push_back(call.first);
+    }
+    EXPECT_EQ(order, (std::vector<int>{1, 3, 5, 0, 7, 6, 2, 4}));
+}
+
+TEST_F(DeferredExec, SameMillisecondExecutesAllDue) {
+    CallbackArg args[3] = {{&log, 0}, {&log, 1}, {&log, 2}};
+    for (auto &arg : args) {
+        defer(&arg, 10);
+    }
+
+    // Skip ahead so everything is due in one task invocation
+    set_time(1050);
+    deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    EXPECT_EQ(log.calls.size(), 3);
+}
+
+TEST_F(DeferredExec, TableFull) {
+    CallbackArg a = {&log, 1};
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_NE(defer(&a, 100), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(&a, 100), INVALID_DEFERRED_TOKEN);
+
+    // Executing one frees up its slot again
+    set_time(1100);
+    deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    EXPECT_NE(defer(&a, 100), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, CancelPreventsExecution) {
+    CallbackArg    a     = {&log, 1};
+    CallbackArg    b     = {&log, 2};
+    deferred_token token = defer(&a, 10);
+    defer(&b, 20);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+
+    run_until(1100);
+    ASSERT_EQ(log.calls.size(), 1);
+    EXPECT_EQ(log.calls[0].first, 2);
+}
+
+TEST_F(DeferredExec, CancelledTokenIsNotReused) {
+    CallbackArg    a     = {&log, 1};
+    deferred_token token = defer(&a, 10);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+
+    // The same slot gets a fresh token, so the stale one can't cancel it
+    deferred_token other = defer(&a, 10);
+    EXPECT_NE(other, token);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, other));
+}
+
+TEST_F(DeferredExec, ExtendDelaysExecution) {
+    CallbackArg    a     = {&log, 1};
+    CallbackArg    b     = {&log, 2};
+    deferred_token token = defer(&a, 10);
+    defer(&b, 20);
+
+    run_until(1005);
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, token, 30));
+
+    run_until(1100);
+    ASSERT_EQ(log.calls.size(), 2);
+    EXPECT_EQ(log.calls[0], std::make_pair(2, (uint32_t)1020));
+    EXPECT_EQ(log.calls[1], std::make_pair(1, (uint32_t)1035));
+}
+
+static deferred_executor_t *cancel_table;
+static deferred_token       cancel_target;
+
+static uint32_t cancelling_callback(uint32_t trigger_time, void *cb_arg) {
+    *static_cast<bool *>(cb_arg) = cancel_deferred_exec_advanced(cancel_table, TABLE_SIZE, cancel_target);
+    return 0;
+}
+
+TEST_F(DeferredExec, CancelFromCallback) {
+    CallbackArg a         = {&log, 1};
+    bool        cancelled = false;
+    cancel_table          = table;
+    cancel_target         = defer(&a, 10);
+    defer_exec_advanced(table, TABLE_SIZE, 10, cancelling_callback, &cancelled);
+
+    // Both are due at the same time, whichever runs first the other must not be invoked after being cancelled
+    run_until(1100);
+    EXPECT_EQ(log.calls.size(), cancelled ? 0 : 1);
+}
+
+static uint32_t self_cancelling_callback(uint32_t trigger_time, void *cb_arg) {
+    cancel_deferred_exec_advanced(cancel_table, TABLE_SIZE, *static_cast<deferred_token *>(cb_arg));
+    return 10;
+}
+
+TEST_F(DeferredExec, SelfCancelWinsOverRepeat) {
+    static deferred_token token;
+    cancel_table = table;
+    token        = defer_exec_advanced(table, TABLE_SIZE, 10, self_cancelling_callback, &token);
+
+    run_until(1100);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    CallbackArg a = {&log, 1};
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_NE(defer(&a, 100), INVALID_DEFERRED_TOKEN);
+    }
+}
+
+TEST_F(DeferredExec, OverrunningExecutorDoesNotStarveOthers) {
+    CallbackArg slow = {&log, 1};
+    CallbackArg fast = {&log, 2};
+    log.repeat[1]    = 1;
+    log.busy_ms[1]   = 5;
+    log.repeat[2]    = 10;
+    defer(&slow, 1);
+    defer(&fast, 10);
+
+    // Each task invocation is bounded, and the other executor still gets its turns
+    run_until(1100);
+    int fast_calls = std::count_if(log.calls.begin(), log.calls.end(), [](auto &c) { return c.first == 2; });
+    EXPECT_GE(fast_calls, 9);
+}
+
+TEST_F(DeferredExec, MatchesReferenceModel) {
+    std::mt19937                      rng(1234);
+    std::vector<CallbackArg>          args(64);
+    std::map<deferred_token, int>     live; // token -> id
+    std::map<int, uint32_t>           expected_trigger;
+    std::vector<std::pair<int, uint32_t>> expected_calls;
+
+    for (int i = 0; i < 64; ++i) {
+        args[i] = {&log, i};
+    }
+
+    int next_id = 0;
+    for (int step = 0; step < 5000; ++step) {
+        int op = rng() % 4;
+        if (op == 0 && next_id < 64) {
+            uint32_t       delay = 1 + rng() % 50;
+            deferred_token token = defer(&args[next_id], delay);
+            if (live.size() < TABLE_SIZE) {
+                ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+                ASSERT_EQ(live.count(token), 0);
+                live[token]                = next_id;
+                expected_trigger[next_id] = timer_read32() + delay;
+                ++next_id;
+            } else {
+                ASSERT_EQ(token, INVALID_DEFERRED_TOKEN);
+            }
+        } else if (op == 1 && !live.empty()) {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            ASSERT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, it->first));
+            expected_trigger.erase(it->second);
+            live.erase(it);
+        } else if (op == 2 && !live.empty()) {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            uint32_t delay = 1 + rng() % 50;
+            ASSERT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, it->first, delay));
+            expected_trigger[it->second] = timer_read32() + delay;
+        } else {
+            advance_time(1);
+            uint32_t now = timer_read32();
+            for (auto it = live.begin(); it != live.end();) {
+                if (expected_trigger[it->second] <= now) {
+                    expected_calls.emplace_back(it->second, expected_trigger[it->second]);
+                    expected_trigger.erase(it->second);
+                    it = live.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+        if (next_id == 64 && live.empty()) {
+            break;
+        }
+    }
+
+    auto sorted = [](std::vector<std::pair<int, uint32_t>> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+    EXPECT_EQ(sorted(log.calls), sorted(expected_calls));
+}
@@ -0,0 +1,13 @@
+deferred_exec_DEFS := -DDEFERRED_EXEC_ENABLE
+
+deferred_exec_SRC := \
+	$(QUANTUM_PATH)/deferred_exec/tests/deferred_exec_tests.cpp \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+deferred_exec_skip_missed_DEFS := -DDEFERRED_EXEC_ENABLE -DDEFERRED_EXEC_SKIP_MISSED
+
+deferred_exec_skip_missed_SRC := \
+	$(QUANTUM_PATH)/deferred_exec/tests/deferred_exec_skip_missed_tests.cpp \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1,3 @@
+TEST_LIST += \
+	deferred_exec \
+	deferred_exec_skip_missed
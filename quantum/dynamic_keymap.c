@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "keymap_introspection.h" // to get keymaps[][][]
 #include "eeprom.h"
 #include "progmem.h" // to read default from flash
@@ -65,9 +67,23 @@
 #    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
 #endif
 
+// Size of the keymaps as seen by dynamic_keymap_get_buffer()/dynamic_keymap_set_buffer()
+#define DYNAMIC_KEYMAP_BUFFER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+#ifdef DYNAMIC_KEYMAP_SPARSE
+// Each layer has a bitmap of the keys which aren't KC_TRANSPARENT, followed by the keycodes of
+// just those keys, packed in layer/row/column order into a pool shared by all the layers
+#    define DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS (MATRIX_ROWS * MATRIX_COLS)
+#    define DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE ((DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS + 7) / 8)
+#    define DYNAMIC_KEYMAP_SPARSE_POOL_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE))
+#    define DYNAMIC_KEYMAP_EEPROM_SIZE ((DYNAMIC_KEYMAP_LAYER_COUNT * DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE) + (DYNAMIC_KEYMAP_SPARSE_KEY_COUNT * 2))
+#else
+#    define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_BUFFER_SIZE)
+#endif
+
 // Dynamic encoders starts after dynamic keymaps
 #ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_EEPROM_SIZE))
 #endif
 
 // Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
@@ -102,14 +118,173 @@ uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
+#ifdef DYNAMIC_KEYMAP_SPARSE
+// Decode cache, so that transparent keys never need to be read from EEPROM, and stored keys
+// are found with a single read. The last entry of dynamic_keymap_layer_start is the total.
+static uint8_t  dynamic_keymap_bitmaps[DYNAMIC_KEYMAP_LAYER_COUNT][DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE];
+static uint16_t dynamic_keymap_layer_start[DYNAMIC_KEYMAP_LAYER_COUNT + 1];
+static bool     dynamic_keymap_bitmaps_loaded = false;
+
+static uint16_t dynamic_keymap_count_keys(const uint8_t *bitmap, uint16_t count) {
+    uint16_t total = 0;
+    for (; count >= 8; count -= 8) {
+        total += bitpop(*bitmap++);
+    }
+    if (count > 0) {
+        total += bitpop(*bitmap & ((1 << count) - 1));
+    }
+    return total;
+}
+
+static void dynamic_keymap_update_layer_start(void) {
+    uint16_t total = 0;
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        dynamic_keymap_layer_start[layer] = total;
+        total += dynamic_keymap_count_keys(dynamic_keymap_bitmaps[layer], DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS);
+    }
+    dynamic_keymap_layer_start[DYNAMIC_KEYMAP_LAYER_COUNT] = total;
+}
+
+static void dynamic_keymap_load_bitmaps(void) {
+    if (dynamic_keymap_bitmaps_loaded) {
+        return;
+    }
+    dynamic_keymap_bitmaps_loaded = true;
+    eeprom_read_block(dynamic_keymap_bitmaps, (const void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_bitmaps));
+    dynamic_keymap_update_layer_start();
+
+    // Erased EEPROM, or a keymap stored in some other format
+    if (dynamic_keymap_layer_start[DYNAMIC_KEYMAP_LAYER_COUNT] > DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+        dynamic_keymap_reset();
+    }
+}
+
+static bool dynamic_keymap_is_stored(uint16_t key) {
+    uint16_t index = key % DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS;
+    return dynamic_keymap_bitmaps[key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS][index / 8] & (1 << (index % 8));
+}
+
+static void dynamic_keymap_set_stored(uint16_t key, bool stored) {
+    uint16_t index = key % DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS;
+    if (stored) {
+        dynamic_keymap_bitmaps[key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS][index / 8] |= (1 << (index % 8));
+    } else {
+        dynamic_keymap_bitmaps[key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS][index / 8] &= ~(1 << (index % 8));
+    }
+}
+
+// Position within the pool of the given key, or of the next stored key if it's transparent
+static uint16_t dynamic_keymap_pool_index(uint16_t key) {
+    uint8_t layer = key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS;
+    return dynamic_keymap_layer_start[layer] + dynamic_keymap_count_keys(dynamic_keymap_bitmaps[layer], key % DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS);
+}
+
+static void *dynamic_keymap_pool_address(uint16_t pool_index) {
+    return ((void *)DYNAMIC_KEYMAP_SPARSE_POOL_ADDR) + (pool_index * 2);
+}
+
+// Moves count keycodes within the pool, to make space for or close the gap left by others
+static void dynamic_keymap_move_keycodes(uint16_t from, uint16_t to, uint16_t count) {
+    uint8_t  buffer[32];
+    uint16_t remaining = count * 2;
+    while (remaining > 0 && from != to) {
+        uint16_t chunk = MIN(remaining, sizeof(buffer));
+        // Back to front when moving up, so nothing is overwritten before it's been moved
+        uint16_t offset = (to > from) ? remaining - chunk : (count * 2) - remaining;
+        eeprom_read_block(buffer, dynamic_keymap_pool_address(from) + offset, chunk);
+        eeprom_update_block(buffer, dynamic_keymap_pool_address(to) + offset, chunk);
+        remaining -= chunk;
+    }
+}
+
+// Replaces the keycodes of count consecutive keys, which may continue onto the following layers
+static void dynamic_keymap_write_keys(uint16_t key, uint16_t count, const uint16_t *keycodes) {
+    dynamic_keymap_load_bitmaps();
+
+    uint16_t pool_index = dynamic_keymap_pool_index(key);
+    uint16_t total      = dynamic_keymap_layer_start[DYNAMIC_KEYMAP_LAYER_COUNT];
+    uint16_t old_count  = 0;
+    uint16_t new_count  = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        old_count += dynamic_keymap_is_stored(key + i) ? 1 : 0;
+        new_count += (keycodes[i] != KC_TRANSPARENT) ? 1 : 0;
+    }
+    if (total - old_count + new_count > DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+        dprintf("Dynamic keymap full, ignoring write of %u keys\n", (unsigned)count);
+        return;
+    }
+
+    eeprom_batch_begin();
+    // Only the keys after these need to move, and only once no matter how many of these changed
+    dynamic_keymap_move_keycodes(pool_index + old_count, pool_index + new_count, total - pool_index - old_count);
+    for (uint16_t i = 0; i < count; i++) {
+        dynamic_keymap_set_stored(key + i, keycodes[i] != KC_TRANSPARENT);
+        if (keycodes[i] != KC_TRANSPARENT) {
+            void *address = dynamic_keymap_pool_address(pool_index++);
+            // Big endian, matching the dense layout
+            eeprom_update_byte(address, (uint8_t)(keycodes[i] >> 8));
+            eeprom_update_byte(address + 1, (uint8_t)(keycodes[i] & 0xFF));
+        }
+    }
+    for (uint8_t layer = key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS; layer <= (key + count - 1) / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS; layer++) {
+        eeprom_update_block(dynamic_keymap_bitmaps[layer], ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE), DYNAMIC_KEYMAP_SPARSE_BITMAP_SIZE);
+    }
+    eeprom_batch_commit();
+
+    dynamic_keymap_update_layer_start();
+}
+
+static void dynamic_keymap_reset_keys(void) {
+    uint16_t pool_index = 0;
+    memset(dynamic_keymap_bitmaps, 0, sizeof(dynamic_keymap_bitmaps));
+    eeprom_batch_begin();
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT && layer < keymap_layer_count(); layer++) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int column = 0; column < MATRIX_COLS; column++) {
+                uint16_t keycode = keycode_at_keymap_location_raw(layer, row, column);
+                if (keycode == KC_TRANSPARENT) {
+                    continue;
+                }
+                // Only possible with a keymap_layer_count() override, the size of the keymap itself is checked at build time
+                if (pool_index >= DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+                    dprintf("Dynamic keymap full, layer %d row %d column %d left transparent\n", layer, row, column);
+                    continue;
+                }
+                void *address = dynamic_keymap_pool_address(pool_index++);
+                eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+                eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+                dynamic_keymap_set_stored((layer * DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS) + (row * MATRIX_COLS) + column, true);
+            }
+        }
+    }
+    eeprom_update_block(dynamic_keymap_bitmaps, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_bitmaps));
+    eeprom_batch_commit();
+
+    dynamic_keymap_bitmaps_loaded = true;
+    dynamic_keymap_update_layer_start();
+}
+#endif // DYNAMIC_KEYMAP_SPARSE
+
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    uint16_t key = (layer * DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS) + (row * MATRIX_COLS) + column;
+    dynamic_keymap_load_bitmaps();
+    if (!dynamic_keymap_is_stored(key)) {
+        return NULL;
+    }
+    return dynamic_keymap_pool_address(dynamic_keymap_pool_index(key));
+#else
     // TODO: optimize this with some left shifts
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+#endif
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    if (address == NULL) return KC_TRANSPARENT;
+#endif
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
@@ -118,10 +293,14 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    dynamic_keymap_write_keys((layer * DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS) + (row * MATRIX_COLS) + column, 1, &keycode);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -149,7 +328,11 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
 
 void dynamic_keymap_reset(void) {
     // Reset the keymaps in EEPROM to what is in flash.
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    dynamic_keymap_reset_keys();
+#endif
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+#ifndef DYNAMIC_KEYMAP_SPARSE
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
                 if (layer < keymap_layer_count()) {
@@ -159,6 +342,7 @@ void dynamic_keymap_reset(void) {
                 }
             }
         }
+#endif // DYNAMIC_KEYMAP_SPARSE
 #ifdef ENCODER_MAP_ENABLE
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
             if (layer < encodermap_layer_count()) {
@@ -173,32 +357,75 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+// Number of bytes of a buffer access which fall within a buffer of the given size
+static uint16_t dynamic_keymap_buffer_length(uint16_t offset, uint16_t size, uint16_t buffer_size) {
+    if (offset >= buffer_size) {
+        return 0;
+    }
+    return MIN(size, buffer_size - offset);
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    // Decoded back into the dense layout, one keycode at a time
+    uint8_t *target = data;
+    uint16_t keycode = KC_NO;
     for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+        uint16_t position = offset + i;
+        if (position < DYNAMIC_KEYMAP_BUFFER_SIZE) {
+            uint16_t key = position / 2;
+            if (i == 0 || position % 2 == 0) {
+                keycode = dynamic_keymap_get_keycode(key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS, (key % DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS) / MATRIX_COLS, key % MATRIX_COLS);
+            }
+            *target = (position % 2 == 0) ? (uint8_t)(keycode >> 8) : (uint8_t)(keycode & 0xFF);
         } else {
             *target = 0x00;
         }
-        source++;
         target++;
     }
+#else
+    uint16_t length = dynamic_keymap_buffer_length(offset, size, DYNAMIC_KEYMAP_BUFFER_SIZE);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
+#endif
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_SPARSE
+    // Encoded from the dense layout, with all the keys of a single write stored together
+    uint16_t keycodes[16];
+    uint16_t first = offset / 2;
+    uint16_t end   = MIN(offset + size, DYNAMIC_KEYMAP_BUFFER_SIZE);
+    uint16_t count = 0;
+    eeprom_batch_begin();
+    for (uint16_t key = first; key * 2 < end; key++) {
+        uint16_t keycode = 0;
+        // Bytes outside the write keep their current value
+        if (key * 2 < offset || key * 2 + 1 >= end) {
+            keycode = dynamic_keymap_get_keycode(key / DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS, (key % DYNAMIC_KEYMAP_SPARSE_LAYER_KEYS) / MATRIX_COLS, key % MATRIX_COLS);
         }
-        source++;
-        target++;
+        if (key * 2 >= offset) {
+            keycode = (keycode & 0x00FF) | (data[key * 2 - offset] << 8);
+        }
+        if (key * 2 + 1 < end) {
+            keycode = (keycode & 0xFF00) | data[key * 2 + 1 - offset];
+        }
+        keycodes[count++] = keycode;
+        if (count == ARRAY_SIZE(keycodes)) {
+            dynamic_keymap_write_keys(key + 1 - count, count, keycodes);
+            count = 0;
+        }
+    }
+    if (count > 0) {
+        dynamic_keymap_write_keys((end - 1) / 2 + 1 - count, count, keycodes);
     }
+    eeprom_batch_commit();
+#else
+    uint16_t length = dynamic_keymap_buffer_length(offset, size, DYNAMIC_KEYMAP_BUFFER_SIZE);
+    eeprom_batch_begin();
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
+    eeprom_batch_commit();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -226,29 +453,16 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_buffer_length(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_buffer_length(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_batch_begin();
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
+    eeprom_batch_commit();
 }
 
 void dynamic_keymap_macro_reset(void) {
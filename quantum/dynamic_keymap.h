@@ -17,9 +17,19 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "action_layer.h"
+
+#ifdef DYNAMIC_KEYMAP_SPARSE
+// Number of non-transparent keys which can be stored. By default, every key of four layers -- enough for
+// a keymap with as many layers as a dense dynamic keymap has by default -- or of a quarter of the layers, if more.
+// Keymaps with more keys than this are rejected at build time, see keymap_introspection.c.
+#    ifndef DYNAMIC_KEYMAP_SPARSE_KEY_COUNT
+#        define DYNAMIC_KEYMAP_SPARSE_KEY_COUNT (((DYNAMIC_KEYMAP_LAYER_COUNT) > 16 ? (DYNAMIC_KEYMAP_LAYER_COUNT) / 4 : ((DYNAMIC_KEYMAP_LAYER_COUNT) < 4 ? (DYNAMIC_KEYMAP_LAYER_COUNT) : 4)) * MATRIX_ROWS * MATRIX_COLS)
+#    endif
+#endif // DYNAMIC_KEYMAP_SPARSE
 
 uint8_t  dynamic_keymap_get_layer_count(void);
-void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
+void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column); // NULL for transparent keys with DYNAMIC_KEYMAP_SPARSE
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
 void     dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
 #ifdef ENCODER_MAP_ENABLE
@@ -35,6 +45,7 @@ void dynamic_keymap_reset(void);
 // This is only really useful for host applications that want to get a whole keymap fast,
 // by reading 14 keycodes (28 bytes) at a time, reducing the number of raw HID transfers by
 // a factor of 14.
+// With DYNAMIC_KEYMAP_SPARSE, the keymaps are translated to and from this layout.
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
@@ -4,6 +4,7 @@
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "timer.h"
 
 #if defined(EEPROM_DRIVER)
 #    include "eeprom_driver.h"
@@ -13,6 +14,12 @@
 #    include "haptic.h"
 #endif
 
+static eeconfig_flush_t eeconfig_pending[EECONFIG_DEFERRED_MAX];
+static uint8_t          eeconfig_pending_count = 0;
+static uint32_t         eeconfig_first_change  = 0;
+static uint32_t         eeconfig_last_change   = 0;
+static uint32_t         eeconfig_last_flush    = 0;
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -43,10 +50,16 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
  * FIXME: needs doc
  */
 void eeconfig_init_quantum(void) {
+    // Anything still pending would overwrite the defaults with stale values
+    eeconfig_pending_count = 0;
+
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
 #endif
 
+    // Everything below is logged together where the EEPROM driver supports it
+    eeprom_batch_begin();
+
     eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
     eeprom_update_byte(EECONFIG_DEBUG, 0);
     eeprom_update_byte(EECONFIG_DEFAULT_LAYER, 0);
@@ -84,6 +97,8 @@ void eeconfig_init_quantum(void) {
 #endif
 
     eeconfig_init_kb();
+
+    eeprom_batch_commit();
 }
 
 /** \brief eeconfig initialization
@@ -94,6 +109,76 @@ void eeconfig_init(void) {
     eeconfig_init_quantum();
 }
 
+/** \brief Schedules a deferred EEPROM write
+ *
+ * Marks a feature's settings as dirty, `flush` being called to write them out once things have settled down. Repeated
+ * changes are combined into a single write, and flushes of several features are written out together.
+ */
+void eeconfig_update_deferred(eeconfig_flush_t flush) {
+    uint32_t now = timer_read32();
+    uint8_t  i;
+    for (i = 0; i < eeconfig_pending_count; ++i) {
+        if (eeconfig_pending[i] == flush) {
+            break;
+        }
+    }
+    if (i == eeconfig_pending_count) {
+        if (eeconfig_pending_count == EECONFIG_DEFERRED_MAX) {
+            // No room to defer, so write it out straight away
+            flush();
+            return;
+        }
+        if (eeconfig_pending_count == 0) {
+            eeconfig_first_change = now;
+        }
+        eeconfig_pending[eeconfig_pending_count++] = flush;
+    }
+    eeconfig_last_change = now;
+}
+
+/** \brief Whether any deferred EEPROM writes are still to be flushed
+ */
+bool eeconfig_has_pending(void) {
+    return eeconfig_pending_count > 0;
+}
+
+/** \brief Writes out all deferred EEPROM writes immediately
+ */
+void eeconfig_flush(void) {
+    if (eeconfig_pending_count == 0) {
+        return;
+    }
+
+    // Callbacks are free to defer further writes, so take a copy first
+    eeconfig_flush_t pending[EECONFIG_DEFERRED_MAX];
+    uint8_t          count = eeconfig_pending_count;
+    memcpy(pending, eeconfig_pending, count * sizeof(eeconfig_flush_t));
+    eeconfig_pending_count = 0;
+
+    eeprom_batch_begin();
+    for (uint8_t i = 0; i < count; ++i) {
+        pending[i]();
+    }
+    eeprom_batch_commit();
+
+    eeconfig_last_flush = timer_read32();
+}
+
+/** \brief Flushes deferred EEPROM writes once they have settled
+ */
+void eeconfig_task(void) {
+    if (eeconfig_pending_count == 0) {
+        return;
+    }
+    if (timer_elapsed32(eeconfig_last_change) < EECONFIG_FLUSH_DELAY && timer_elapsed32(eeconfig_first_change) < EECONFIG_FLUSH_MAX_DELAY) {
+        return;
+    }
+    if (timer_elapsed32(eeconfig_last_flush) < EECONFIG_FLUSH_MIN_INTERVAL) {
+        return;
+    }
+    eeconfig_flush();
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -70,6 +70,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // Size of EEPROM being used, other code can refer to this for available EEPROM
 #define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
 
+// Deferred writes are flushed once nothing has changed for this long...
+#ifndef EECONFIG_FLUSH_DELAY
+#    define EECONFIG_FLUSH_DELAY 1000
+#endif
+// ...or once the oldest pending change is this old, whichever comes first...
+#ifndef EECONFIG_FLUSH_MAX_DELAY
+#    define EECONFIG_FLUSH_MAX_DELAY 10000
+#endif
+// ...but never sooner than this after the previous flush
+#ifndef EECONFIG_FLUSH_MIN_INTERVAL
+#    define EECONFIG_FLUSH_MIN_INTERVAL 2000
+#endif
+// Number of distinct flush callbacks that can be pending at once
+#ifndef EECONFIG_DEFERRED_MAX
+#    define EECONFIG_DEFERRED_MAX 8
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
@@ -94,6 +111,13 @@ void eeconfig_init_quantum(void);
 void eeconfig_init_kb(void);
 void eeconfig_init_user(void);
 
+typedef void (*eeconfig_flush_t)(void);
+
+void eeconfig_update_deferred(eeconfig_flush_t flush);
+bool eeconfig_has_pending(void);
+void eeconfig_flush(void);
+void eeconfig_task(void);
+
 void eeconfig_enable(void);
 
 void eeconfig_disable(void);
@@ -147,41 +171,37 @@ void eeconfig_init_user_datablock(void);
 // Any "checked" debounce variant used requires implementation of:
 //    -- bool eeconfig_check_valid_##name(void)
 //    -- void eeconfig_post_flush_##name(void)
-#define EECONFIG_DEBOUNCE_HELPER_CHECKED(name, offset, config)          \
-    static uint8_t dirty_##name = false;                                \
-                                                                        \
-    bool eeconfig_check_valid_##name(void);                             \
-    void eeconfig_post_flush_##name(void);                              \
-                                                                        \
-    static inline void eeconfig_init_##name(void) {                     \
-        dirty_##name = true;                                            \
-        if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
-            dirty_##name = false;                                       \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flush_##name(bool force) {              \
-        if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
-            eeconfig_post_flush_##name();                               \
-            dirty_##name = false;                                       \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flush_##name##_task(uint16_t timeout) { \
-        static uint16_t flush_timer = 0;                                \
-        if (timer_elapsed(flush_timer) > timeout) {                     \
-            eeconfig_flush_##name(false);                               \
-            flush_timer = timer_read();                                 \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flag_##name(bool v) {                   \
-        dirty_##name |= v;                                              \
-    }                                                                   \
-    static inline void eeconfig_write_##name(typeof(config) *conf) {    \
-        if (memcmp(&config, conf, sizeof(config)) != 0) {               \
-            memcpy(&config, conf, sizeof(config));                      \
-            eeconfig_flag_##name(true);                                 \
-        }                                                               \
+// Changes are written out by eeconfig_task(), unless flushed with force.
+#define EECONFIG_DEBOUNCE_HELPER_CHECKED(name, offset, config)       \
+    bool eeconfig_check_valid_##name(void);                          \
+    void eeconfig_post_flush_##name(void);                           \
+                                                                     \
+    static void eeconfig_persist_##name(void) {                      \
+        eeprom_update_block(&config, offset, sizeof(config));        \
+        eeconfig_post_flush_##name();                                \
+    }                                                                \
+    static inline void eeconfig_flag_##name(bool v) {                \
+        if (v) {                                                     \
+            eeconfig_update_deferred(eeconfig_persist_##name);       \
+        }                                                            \
+    }                                                                \
+    static inline void eeconfig_init_##name(void) {                  \
+        if (eeconfig_check_valid_##name()) {                         \
+            eeprom_read_block(&config, offset, sizeof(config));      \
+        } else {                                                     \
+            eeconfig_flag_##name(true);                              \
+        }                                                            \
+    }                                                                \
+    static inline void eeconfig_flush_##name(bool force) {           \
+        if (force) {                                                 \
+            eeconfig_persist_##name();                               \
+        }                                                            \
+    }                                                                \
+    static inline void eeconfig_write_##name(typeof(config) *conf) { \
+        if (memcmp(&config, conf, sizeof(config)) != 0) {            \
+            memcpy(&config, conf, sizeof(config));                   \
+            eeconfig_flag_##name(true);                              \
+        }                                                            \
     }
 
 #define EECONFIG_DEBOUNCE_HELPER(name, offset, config)     \
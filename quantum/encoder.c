@@ -68,6 +68,71 @@ static uint8_t thatCount;
 
 static uint8_t encoder_value[NUM_ENCODERS] = {0};
 
+#ifdef ENCODER_PIN_INTERRUPT
+#    ifndef enablePinChangeCallback
+#        error "ENCODER_PIN_INTERRUPT is not supported on this platform"
+#    endif
+#    ifndef ENCODER_QUEUE_SIZE
+#        define ENCODER_QUEUE_SIZE 32
+#    endif
+_Static_assert(ENCODER_QUEUE_SIZE <= 128 && (ENCODER_QUEUE_SIZE & (ENCODER_QUEUE_SIZE - 1)) == 0, "ENCODER_QUEUE_SIZE must be a power of two, no larger than 128");
+
+typedef struct {
+    uint8_t index;
+    uint8_t state;
+} encoder_event_t;
+
+// Transitions recorded by the pin change callback, waiting for encoder_read(). The callback is the only writer of the
+// head, and encoder_read() the only writer of the tail, so no locking is needed.
+static volatile encoder_event_t encoder_queue[ENCODER_QUEUE_SIZE];
+static volatile uint8_t         encoder_queue_head = 0;
+static volatile uint8_t         encoder_queue_tail = 0;
+#endif
+
+#ifdef ENCODER_VELOCITY
+#    ifndef ENCODER_VELOCITY_WINDOW
+#        define ENCODER_VELOCITY_WINDOW 50
+#    endif
+
+typedef struct {
+    uint32_t window_start;
+    uint16_t velocity;
+    uint8_t  steps;
+} encoder_velocity_t;
+
+static encoder_velocity_t encoder_velocity[NUM_ENCODERS] = {0};
+
+/** \brief Counts a step of the given encoder towards its velocity. */
+static void encoder_velocity_step(uint8_t index) {
+    encoder_velocity_t *velocity = &encoder_velocity[index];
+    uint32_t            elapsed  = timer_elapsed32(velocity->window_start);
+    if (elapsed >= ENCODER_VELOCITY_WINDOW) {
+        velocity->velocity     = (uint32_t)velocity->steps * 1000 / elapsed;
+        velocity->window_start = timer_read32();
+        velocity->steps        = 0;
+    }
+    if (velocity->steps < UINT8_MAX) {
+        velocity->steps++;
+    }
+}
+
+uint16_t encoder_get_velocity(uint8_t index) {
+    if (index >= NUM_ENCODERS) {
+        return 0;
+    }
+
+    const encoder_velocity_t *velocity = &encoder_velocity[index];
+    uint32_t                  elapsed  = timer_elapsed32(velocity->window_start);
+    if (elapsed >= ENCODER_VELOCITY_WINDOW) {
+        // the window is over, and slows down the longer nothing happens
+        return (uint32_t)velocity->steps * 1000 / elapsed;
+    }
+    // the current window can only tell us the velocity is at least this much so far
+    uint16_t current = (uint32_t)velocity->steps * 1000 / ENCODER_VELOCITY_WINDOW;
+    return MAX(velocity->velocity, current);
+}
+#endif
+
 __attribute__((weak)) void encoder_wait_pullup_charge(void) {
     wait_us(100);
 }
@@ -106,6 +171,28 @@ __attribute__((weak)) bool should_process_encoder(void) {
     return is_keyboard_master();
 }
 
+#ifdef ENCODER_PIN_INTERRUPT
+/** \brief Records the transitions of every encoder on this side whenever one of their pins changes. */
+static void encoder_pin_change_callback(void *arg) {
+    for (uint8_t i = 0; i < thisCount; i++) {
+        uint8_t new_status = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
+        if ((encoder_state[i] & 0x3) != new_status) {
+            // a full queue drops the transition, and the state stays at the last one queued, so the next one queued
+            // decodes as a jump from there: an invalid one which is ignored, or a step back, but never a step the
+            // encoder did not take
+            uint8_t head = encoder_queue_head;
+            if ((uint8_t)(head - encoder_queue_tail) < ENCODER_QUEUE_SIZE) {
+                encoder_state[i] <<= 2;
+                encoder_state[i] |= new_status;
+                encoder_queue[head & (ENCODER_QUEUE_SIZE - 1)].index = i;
+                encoder_queue[head & (ENCODER_QUEUE_SIZE - 1)].state = encoder_state[i];
+                encoder_queue_head                                   = head + 1;
+            }
+        }
+    }
+}
+#endif
+
 void encoder_init(void) {
 #ifdef SPLIT_KEYBOARD
     thisHand  = isLeftHand ? 0 : NUM_ENCODERS_LEFT;
@@ -124,6 +211,12 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+#    ifdef ENCODER_PIN_INTERRUPT
+    encoder_queue_head = encoder_queue_tail = 0;
+#    endif
+#    ifdef ENCODER_VELOCITY
+    memset(encoder_velocity, 0, sizeof(encoder_velocity));
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -164,6 +257,12 @@ void encoder_init(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+#ifdef ENCODER_PIN_INTERRUPT
+    for (uint8_t i = 0; i < thisCount; i++) {
+        enablePinChangeCallback(encoders_pad_a[i], encoder_pin_change_callback);
+        enablePinChangeCallback(encoders_pad_b[i], encoder_pin_change_callback);
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -205,6 +304,9 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 
             encoder_value[index]++;
             changed = true;
+#ifdef ENCODER_VELOCITY
+            encoder_velocity_step(index);
+#endif
 #ifdef SPLIT_KEYBOARD
             if (should_process_encoder())
 #endif // SPLIT_KEYBOARD
@@ -222,6 +324,9 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 #endif
             encoder_value[index]--;
             changed = true;
+#ifdef ENCODER_VELOCITY
+            encoder_velocity_step(index);
+#endif
 #ifdef SPLIT_KEYBOARD
             if (should_process_encoder())
 #endif // SPLIT_KEYBOARD
@@ -241,6 +346,16 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 
 bool encoder_read(void) {
     bool changed = false;
+#ifdef ENCODER_PIN_INTERRUPT
+    uint8_t head = encoder_queue_head;
+    while (encoder_queue_tail != head) {
+        uint8_t tail  = encoder_queue_tail;
+        uint8_t index = encoder_queue[tail & (ENCODER_QUEUE_SIZE - 1)].index;
+        uint8_t state = encoder_queue[tail & (ENCODER_QUEUE_SIZE - 1)].state;
+        encoder_queue_tail = tail + 1;
+        changed |= encoder_update(index, state);
+    }
+#else
     for (uint8_t i = 0; i < thisCount; i++) {
         uint8_t new_status = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
         if ((encoder_state[i] & 0x3) != new_status) {
@@ -249,6 +364,7 @@ bool encoder_read(void) {
             changed |= encoder_update(i, encoder_state[i]);
         }
     }
+#endif
     return changed;
 }
 
@@ -268,6 +384,9 @@ void encoder_update_raw(uint8_t *slave_state) {
             delta--;
             encoder_value[index]++;
             changed = true;
+#    ifdef ENCODER_VELOCITY
+            encoder_velocity_step(index);
+#    endif
 #    ifdef ENCODER_MAP_ENABLE
             encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
 #    else  // ENCODER_MAP_ENABLE
@@ -278,6 +397,9 @@ void encoder_update_raw(uint8_t *slave_state) {
             delta++;
             encoder_value[index]--;
             changed = true;
+#    ifdef ENCODER_VELOCITY
+            encoder_velocity_step(index);
+#    endif
 #    ifdef ENCODER_MAP_ENABLE
             encoder_exec_mapping(index, ENCODER_CLOCKWISE);
 #    else  // ENCODER_MAP_ENABLE
@@ -26,6 +26,10 @@ bool encoder_read(void);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#ifdef ENCODER_VELOCITY
+uint16_t encoder_get_velocity(uint8_t index);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 
 void encoder_state_raw(uint8_t* slave_state);
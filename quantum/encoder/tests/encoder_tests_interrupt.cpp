@@ -0,0 +1,154 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+static std::vector<update> updates;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates.push_back({(int8_t)index, clockwise});
+    return true;
+}
+
+// one detent, without reading the encoders in between -- the pin change callback has to catch every transition
+static void clockwise(pin_t pin_a, pin_t pin_b) {
+    setPin(pin_a, false);
+    setPin(pin_b, false);
+    setPin(pin_a, true);
+    setPin(pin_b, true);
+}
+
+static void counter_clockwise(pin_t pin_a, pin_t pin_b) {
+    setPin(pin_b, false);
+    setPin(pin_a, false);
+    setPin(pin_b, true);
+    setPin(pin_a, true);
+}
+
+class EncoderInterruptTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (pin_t pin = 0; pin < 4; pin++) {
+            setPin(pin, true);
+        }
+        set_time(0);
+        encoder_init();
+        updates.clear();
+    }
+};
+
+TEST_F(EncoderInterruptTest, TestInitEnablesCallbacks) {
+    for (pin_t pin = 0; pin < 4; pin++) {
+        EXPECT_EQ(pinIsInputHigh[pin], true);
+        EXPECT_NE(pinCallbacks[pin], nullptr);
+    }
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(updates.size(), 0);
+}
+
+TEST_F(EncoderInterruptTest, TestTransitionsWaitForRead) {
+    clockwise(0, 1);
+    EXPECT_EQ(updates.size(), 0);
+
+    EXPECT_EQ(encoder_read(), true);
+    ASSERT_EQ(updates.size(), 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestFastSpinDuringSlowLoop) {
+    // a whole queue's worth of transitions on both encoders between two reads
+    clockwise(0, 1);
+    counter_clockwise(2, 3);
+    clockwise(0, 1);
+    clockwise(0, 1);
+
+    encoder_read();
+    ASSERT_EQ(updates.size(), 4);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+    EXPECT_EQ(updates[1].index, 1);
+    EXPECT_EQ(updates[1].clockwise, false);
+    EXPECT_EQ(updates[2].index, 0);
+    EXPECT_EQ(updates[2].clockwise, true);
+    EXPECT_EQ(updates[3].index, 0);
+    EXPECT_EQ(updates[3].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestQueueOverflowDropsTransitions) {
+    for (int i = 0; i < 5; i++) {
+        clockwise(0, 1);
+    }
+
+    // the fifth detent did not fit in the queue, but nothing is decoded the wrong way
+    encoder_read();
+    EXPECT_EQ(updates.size(), 4);
+    for (auto &update : updates) {
+        EXPECT_EQ(update.clockwise, true);
+    }
+
+    // and decoding carries on once there is room again
+    clockwise(0, 1);
+    encoder_read();
+    ASSERT_EQ(updates.size(), 5);
+    EXPECT_EQ(updates[4].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestQueueOverflowKeepsDetentPhase) {
+    for (int i = 0; i < 4; i++) {
+        clockwise(0, 1);
+    }
+    // the first half of a fifth detent does not fit in the queue
+    setPin(0, false);
+    setPin(1, false);
+    encoder_read();
+    EXPECT_EQ(updates.size(), 4);
+
+    // its second half, and half of the next detent, must not add up to a step
+    setPin(0, true);
+    setPin(1, true);
+    setPin(0, false);
+    setPin(1, false);
+    encoder_read();
+    EXPECT_EQ(updates.size(), 4);
+
+    setPin(0, true);
+    setPin(1, true);
+    encoder_read();
+    ASSERT_EQ(updates.size(), 5);
+    EXPECT_EQ(updates[4].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestVelocity) {
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+
+    // a detent every 5ms is 200 per second
+    for (int i = 0; i <= 10; i++) {
+        clockwise(0, 1);
+        encoder_read();
+        if (i < 10) {
+            advance_time(5);
+        }
+    }
+    EXPECT_EQ(encoder_get_velocity(0), 200);
+    EXPECT_EQ(encoder_get_velocity(1), 0);
+
+    // and slows down once the encoder stops turning
+    advance_time(200);
+    EXPECT_LT(encoder_get_velocity(0), 10);
+}
@@ -14,10 +14,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stddef.h>
 #include "mock.h"
 
-bool pins[32]           = {0};
-bool pinIsInputHigh[32] = {0};
+bool                  pins[32]           = {0};
+bool                  pinIsInputHigh[32] = {0};
+pin_change_callback_t pinCallbacks[32]   = {0};
 
 uint8_t mockSetPinInputHigh(pin_t pin) {
     // dprintf("Setting pin %d input high.", pin);
@@ -30,8 +32,16 @@ bool mockReadPin(pin_t pin) {
     return pins[pin];
 }
 
+void mockEnablePinChangeCallback(pin_t pin, pin_change_callback_t callback) {
+    pinCallbacks[pin] = callback;
+}
+
 bool setPin(pin_t pin, bool val) {
-    pins[pin] = val;
+    bool changed = pins[pin] != val;
+    pins[pin]    = val;
+    if (changed && pinCallbacks[pin]) {
+        pinCallbacks[pin](NULL);
+    }
     return val;
 }
 
@@ -23,12 +23,18 @@ typedef uint8_t pin_t;
 
 extern bool pins[];
 extern bool pinIsInputHigh[];
+extern void (*pinCallbacks[])(void *arg);
+
+typedef void (*pin_change_callback_t)(void *arg);
 
 #define setPinInputHigh(pin) (mockSetPinInputHigh(pin))
 #define readPin(pin) (mockReadPin(pin))
+#define enablePinChangeCallback(pin, callback) (mockEnablePinChangeCallback(pin, callback))
 
 uint8_t mockSetPinInputHigh(pin_t pin);
 
 bool mockReadPin(pin_t pin);
 
+void mockEnablePinChangeCallback(pin_t pin, pin_change_callback_t callback);
+
 bool setPin(pin_t pin, bool val);
@@ -106,16 +106,20 @@ void eeconfig_debug_haptic(void) {
     dprintf("haptic_config.mode = %d\n", haptic_config.mode);
 }
 
+void eeconfig_update_haptic_current(void) {
+    eeconfig_update_haptic(haptic_config.raw);
+}
+
 void haptic_enable(void) {
     set_haptic_config_enable(true);
     xprintf("haptic_config.enable = %u\n", haptic_config.enable);
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 }
 
 void haptic_disable(void) {
     set_haptic_config_enable(false);
     xprintf("haptic_config.enable = %u\n", haptic_config.enable);
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 }
 
 void haptic_toggle(void) {
@@ -124,14 +128,14 @@ void haptic_toggle(void) {
     } else {
         haptic_enable();
     }
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 }
 
 void haptic_feedback_toggle(void) {
     haptic_config.feedback++;
     if (haptic_config.feedback >= HAPTIC_FEEDBACK_MAX) haptic_config.feedback = KEY_PRESS;
     xprintf("haptic_config.feedback = %u\n", !haptic_config.feedback);
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 }
 
 void haptic_buzz_toggle(void) {
@@ -219,19 +223,19 @@ void haptic_reset(void) {
 
 void haptic_set_feedback(uint8_t feedback) {
     haptic_config.feedback = feedback;
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
     xprintf("haptic_config.feedback = %u\n", haptic_config.feedback);
 }
 
 void haptic_set_mode(uint8_t mode) {
     haptic_config.mode = mode;
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
     xprintf("haptic_config.mode = %u\n", haptic_config.mode);
 }
 
 void haptic_set_amplitude(uint8_t amp) {
     haptic_config.amplitude = amp;
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
     xprintf("haptic_config.amplitude = %u\n", haptic_config.amplitude);
 #ifdef DRV2605L
     DRV_amplitude(amp);
@@ -240,13 +244,13 @@ void haptic_set_amplitude(uint8_t amp) {
 
 void haptic_set_buzz(uint8_t buzz) {
     haptic_config.buzz = buzz;
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
     xprintf("haptic_config.buzz = %u\n", haptic_config.buzz);
 }
 
 void haptic_set_dwell(uint8_t dwell) {
     haptic_config.dwell = dwell;
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
     xprintf("haptic_config.dwell = %u\n", haptic_config.dwell);
 }
 
@@ -278,7 +282,7 @@ uint8_t haptic_get_dwell(void) {
 void haptic_enable_continuous(void) {
     haptic_config.cont = 1;
     xprintf("haptic_config.cont = %u\n", haptic_config.cont);
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 #ifdef DRV2605L
     DRV_rtp_init();
 #endif
@@ -287,7 +291,7 @@ void haptic_enable_continuous(void) {
 void haptic_disable_continuous(void) {
     haptic_config.cont = 0;
     xprintf("haptic_config.cont = %u\n", haptic_config.cont);
-    eeconfig_update_haptic(haptic_config.raw);
+    eeconfig_update_deferred(eeconfig_update_haptic_current);
 #ifdef DRV2605L
     DRV_write(DRV_MODE, 0x00);
 #endif
@@ -53,6 +53,7 @@ typedef enum HAPTIC_FEEDBACK {
 void    haptic_init(void);
 void    haptic_task(void);
 void    eeconfig_debug_haptic(void);
+void    eeconfig_update_haptic_current(void);
 void    haptic_enable(void);
 void    haptic_disable(void);
 void    haptic_toggle(void);
@@ -0,0 +1,44 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "idle_sleep.h"
+#include "timer.h"
+
+static bool     sleep_prevented = false;
+static bool     wakeup_pending  = false;
+static uint32_t wakeup_time     = 0;
+
+__attribute__((weak)) void platform_idle_sleep(uint32_t timeout_ms) {}
+__attribute__((weak)) void platform_idle_wake(void) {}
+
+void idle_sleep_request_wakeup(uint32_t deadline) {
+    if (!wakeup_pending || ((int32_t)TIMER_DIFF_32(deadline, wakeup_time)) < 0) {
+        wakeup_time    = deadline;
+        wakeup_pending = true;
+    }
+}
+
+void idle_sleep_request_wakeup_in(uint32_t delay_ms) {
+    idle_sleep_request_wakeup(timer_read32() + delay_ms);
+}
+
+void idle_sleep_prevent(void) {
+    sleep_prevented = true;
+}
+
+void idle_sleep_wake(void) {
+    platform_idle_wake();
+}
+
+void idle_sleep_task(void) {
+    // Only sleep if every subsystem has had its say -- with no wakeup requested there's nothing bounding the sleep
+    if (!sleep_prevented && wakeup_pending) {
+        int32_t remaining = TIMER_DIFF_32(wakeup_time, timer_read32());
+        if (remaining > 0) {
+            platform_idle_sleep(remaining);
+        }
+    }
+
+    sleep_prevented = false;
+    wakeup_pending  = false;
+}
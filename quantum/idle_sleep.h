@@ -0,0 +1,59 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def The number of milliseconds between matrix scans while no key is held.
+ */
+#ifndef IDLE_SLEEP_SCAN_INTERVAL
+#    define IDLE_SLEEP_SCAN_INTERVAL 1
+#endif
+
+/**
+ * Reports that something needs to run no later than the supplied time, in the same time-space as timer_read32().
+ * Subsystems call this on every main loop iteration they have pending work; the earliest time wins.
+ *
+ * @param deadline[in] the time at which the main loop needs to run again
+ */
+void idle_sleep_request_wakeup(uint32_t deadline);
+
+/**
+ * Reports that something needs to run again within the supplied number of milliseconds.
+ *
+ * @param delay_ms[in] the number of milliseconds before the main loop needs to run again
+ */
+void idle_sleep_request_wakeup_in(uint32_t delay_ms);
+
+/**
+ * Prevents sleeping at the end of the current main loop iteration, for subsystems that are busy.
+ */
+void idle_sleep_prevent(void);
+
+/**
+ * Ends the current idle sleep early, or the next one if the main loop isn't sleeping. Safe to call from interrupt
+ * handlers, for wake sources such as pin change interrupts.
+ */
+void idle_sleep_wake(void);
+
+/**
+ * Sleeps until the earliest requested wakeup, or until idle_sleep_wake() is called. Should not be invoked by
+ * keyboard/user code, the main loop runs this after all other tasks.
+ */
+void idle_sleep_task(void);
+
+/**
+ * Platform specific low-power wait, returning after the timeout or once platform_idle_wake() has been called,
+ * whichever comes first. A wake occurring while not sleeping ends the next wait immediately.
+ *
+ * @param timeout_ms[in] the maximum number of milliseconds to wait
+ */
+void platform_idle_sleep(uint32_t timeout_ms);
+
+/**
+ * Platform specific hook ending the low-power wait, called by idle_sleep_wake(). May be called from interrupt context.
+ */
+void platform_idle_wake(void);
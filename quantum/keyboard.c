@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "timeout.h"
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -96,6 +97,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
 #endif
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
@@ -108,6 +112,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
+#ifdef CONSOLE_BINARY_LOG_ENABLE
+#    include "binary_log.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+#    include "wear_leveling.h"
+#endif
+#ifdef FLASH_SPI
+#    include "flash_spi.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -496,6 +512,10 @@ static bool matrix_task(void) {
         return matrix_changed;
     }
 
+#ifdef LATENCY_TRACKING_ENABLE
+    latency_tracking_mark(LATENCY_STAGE_DEBOUNCE);
+#endif
+
     if (debug_config.matrix) {
         matrix_print();
     }
@@ -571,17 +591,8 @@ void quantum_task(void) {
     sequencer_task();
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
-#endif
-
-#ifdef COMBO_ENABLE
-    combo_task();
-#endif
-
-#ifdef LEADER_ENABLE
-    leader_task();
-#endif
+    // Tap dance, combo, leader, caps word and secure timeouts
+    timeout_task();
 
 #ifdef WPM_ENABLE
     decay_wpm();
@@ -598,15 +609,30 @@ void quantum_task(void) {
 #ifdef AUTO_SHIFT_ENABLE
     autoshift_matrix_scan();
 #endif
+}
 
-#ifdef CAPS_WORD_ENABLE
-    caps_word_task();
-#endif
+#ifdef IDLE_SLEEP_ENABLE
+/** \brief Tells the idle sleep logic when the matrix needs to be scanned again.
+ *
+ * While anything changed or any key is held the main loop keeps spinning, otherwise the next scan is due after
+ * IDLE_SLEEP_SCAN_INTERVAL milliseconds.
+ */
+static void idle_sleep_keyboard_task(bool activity_has_occurred) {
+    if (activity_has_occurred) {
+        idle_sleep_prevent();
+        return;
+    }
 
-#ifdef SECURE_ENABLE
-    secure_task();
-#endif
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            idle_sleep_prevent();
+            return;
+        }
+    }
+
+    idle_sleep_request_wakeup_in(IDLE_SLEEP_SCAN_INTERVAL);
 }
+#endif
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
@@ -696,5 +722,27 @@ void keyboard_task(void) {
     bluetooth_task();
 #endif
 
+#ifdef CONSOLE_BINARY_LOG_ENABLE
+    binary_log_task();
+#endif
+
+    eeconfig_task();
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+    wear_leveling_task();
+#endif
+
+#if defined(EEPROM_I2C) && defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+    eeprom_i2c_task();
+#endif
+
+#ifdef FLASH_SPI
+    flash_task();
+#endif
+
     led_task();
+
+#ifdef IDLE_SLEEP_ENABLE
+    idle_sleep_keyboard_task(activity_has_occurred);
+#endif
 }
@@ -165,3 +165,11 @@ __attribute__((weak)) uint8_t mod_config(uint8_t mod) {
 
     return mod;
 }
+
+/** \brief Writes the current keymap config to EEPROM
+ *
+ * Suitable for passing to eeconfig_update_deferred().
+ */
+void eeconfig_update_keymap_current(void) {
+    eeconfig_update_keymap(keymap_config.raw);
+}
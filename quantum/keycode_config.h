@@ -50,3 +50,5 @@ typedef union {
 _Static_assert(sizeof(keymap_config_t) == sizeof(uint16_t), "Keycode (magic) EECONFIG out of spec.");
 
 extern keymap_config_t keymap_config;
+
+void eeconfig_update_keymap_current(void);
@@ -30,6 +30,10 @@ _Static_assert(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers exce
 _Static_assert(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers exceeds maximum set by LAYER_STATE_(8|16|32)BIT");
 #endif
 
+#ifdef DYNAMIC_KEYMAP_SPARSE
+_Static_assert((NUM_KEYMAP_LAYERS_RAW < DYNAMIC_KEYMAP_LAYER_COUNT ? NUM_KEYMAP_LAYERS_RAW : DYNAMIC_KEYMAP_LAYER_COUNT) * (MATRIX_ROWS) * (MATRIX_COLS) <= DYNAMIC_KEYMAP_SPARSE_KEY_COUNT, "Keymap may have more keys than DYNAMIC_KEYMAP_SPARSE_KEY_COUNT, which dynamic_keymap_reset() needs to store");
+#endif
+
 uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
         return pgm_read_word(&keymaps[layer_num][row][column]);
@@ -0,0 +1,189 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_tracking.h"
+#include "atomic_util.h"
+#include "raw_hid.h"
+#include "timer.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+
+// System ticks can be read from interrupt context, resolution depends on CH_CFG_ST_FREQUENCY
+typedef systime_t latency_time_t;
+
+static inline latency_time_t latency_now(void) {
+    return chVTGetSystemTimeX();
+}
+
+static inline uint32_t latency_elapsed_us(latency_time_t start, latency_time_t end) {
+    return TIME_I2US(chTimeDiffX(start, end));
+}
+#else
+typedef uint32_t latency_time_t;
+
+static inline latency_time_t latency_now(void) {
+    return timer_read32();
+}
+
+static inline uint32_t latency_elapsed_us(latency_time_t start, latency_time_t end) {
+    return TIMER_DIFF_32(end, start) * 1000;
+}
+#endif
+
+// Only ChibiOS reports when the host has collected a report, elsewhere an event ends once it is submitted
+#ifndef LATENCY_STAGE_LAST
+#    if defined(PROTOCOL_CHIBIOS)
+#        define LATENCY_STAGE_LAST LATENCY_STAGE_COMPLETE
+#    else
+#        define LATENCY_STAGE_LAST LATENCY_STAGE_ENDPOINT_SUBMIT
+#    endif
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint16_t bins[LATENCY_TRACKING_BINS];
+} latency_record_t;
+
+static latency_record_t records[LATENCY_STAGE_COUNT];
+static latency_time_t   event_start;
+static bool             event_in_flight = false;
+static uint8_t          event_stage;
+
+static void latency_record(latency_stage_t stage, uint32_t elapsed_us) {
+    latency_record_t *record = &records[stage];
+    uint32_t          bin    = elapsed_us / LATENCY_TRACKING_BIN_WIDTH_US;
+
+    if (record->count == 0 || elapsed_us < record->min_us) {
+        record->min_us = elapsed_us;
+    }
+    if (elapsed_us > record->max_us) {
+        record->max_us = elapsed_us;
+    }
+    record->count++;
+    record->sum_us += elapsed_us;
+
+    if (bin >= LATENCY_TRACKING_BINS) {
+        bin = LATENCY_TRACKING_BINS - 1;
+    }
+    if (record->bins[bin] < UINT16_MAX) {
+        record->bins[bin]++;
+    }
+}
+
+void latency_tracking_mark(latency_stage_t stage) {
+    if (stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+
+    ATOMIC_BLOCK_RESTORESTATE {
+        latency_time_t now = latency_now();
+
+        if (stage == LATENCY_STAGE_MATRIX_SCAN) {
+            // Only one event is tracked at a time, later edges are ignored until it completes or goes stale
+            if (!event_in_flight || latency_elapsed_us(event_start, now) > LATENCY_TRACKING_TIMEOUT_MS * 1000UL) {
+                event_start     = now;
+                event_stage     = LATENCY_STAGE_MATRIX_SCAN;
+                event_in_flight = true;
+                latency_record(LATENCY_STAGE_MATRIX_SCAN, 0);
+            }
+        } else if (event_in_flight && stage > event_stage) {
+            event_stage = stage;
+            latency_record(stage, latency_elapsed_us(event_start, now));
+            if (stage >= LATENCY_STAGE_LAST) {
+                event_in_flight = false;
+            }
+        }
+    }
+}
+
+void latency_tracking_get_stats(latency_stage_t stage, latency_stats_t *stats) {
+    memset(stats, 0, sizeof(latency_stats_t));
+    if (stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+
+    ATOMIC_BLOCK_RESTORESTATE {
+        const latency_record_t *record = &records[stage];
+        stats->count                   = record->count;
+        stats->min_us                  = record->min_us;
+        stats->max_us                  = record->max_us;
+        stats->mean_us                 = record->count ? record->sum_us / record->count : 0;
+        memcpy(stats->bins, record->bins, sizeof(stats->bins));
+    }
+}
+
+void latency_tracking_reset(void) {
+    ATOMIC_BLOCK_RESTORESTATE {
+        memset(records, 0, sizeof(records));
+        event_in_flight = false;
+    }
+}
+
+static uint8_t put_be32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+    return 4;
+}
+
+bool latency_tracking_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 4 || data[0] != LATENCY_TRACKING_RAW_HID_ID) {
+        return false;
+    }
+
+    uint8_t        *command_id   = &data[1];
+    uint8_t        *command_data = &data[2];
+    latency_stats_t stats;
+
+    switch (*command_id) {
+        case id_latency_get_info: {
+            command_data[0] = LATENCY_STAGE_COUNT;
+            command_data[1] = LATENCY_TRACKING_BINS;
+            command_data[2] = (LATENCY_TRACKING_BIN_WIDTH_US >> 8) & 0xFF;
+            command_data[3] = LATENCY_TRACKING_BIN_WIDTH_US & 0xFF;
+            break;
+        }
+        case id_latency_get_stats: {
+            // stage, count, min, max, mean
+            if (length < 2 + 1 + 4 * 4) {
+                *command_id = 0xFF;
+                break;
+            }
+            latency_tracking_get_stats(command_data[0], &stats);
+            uint8_t i = 1;
+            i += put_be32(&command_data[i], stats.count);
+            i += put_be32(&command_data[i], stats.min_us);
+            i += put_be32(&command_data[i], stats.max_us);
+            put_be32(&command_data[i], stats.mean_us);
+            break;
+        }
+        case id_latency_get_bins: {
+            // stage, first bin, bins...
+            latency_tracking_get_stats(command_data[0], &stats);
+            uint8_t bin = command_data[1];
+            for (uint8_t i = 2; i + 1 < length - 2; i += 2, bin++) {
+                uint16_t value      = bin < LATENCY_TRACKING_BINS ? stats.bins[bin] : 0;
+                command_data[i]     = value >> 8;
+                command_data[i + 1] = value & 0xFF;
+            }
+            break;
+        }
+        case id_latency_reset: {
+            latency_tracking_reset();
+            break;
+        }
+        default: {
+            *command_id = 0xFF;
+            break;
+        }
+    }
+
+    raw_hid_send(data, length);
+    return true;
+}
@@ -0,0 +1,80 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Width of each histogram bin */
+#ifndef LATENCY_TRACKING_BIN_WIDTH_US
+#    define LATENCY_TRACKING_BIN_WIDTH_US 250
+#endif
+
+/* Number of histogram bins per stage, the last one collecting everything beyond */
+#ifndef LATENCY_TRACKING_BINS
+#    define LATENCY_TRACKING_BINS 16
+#endif
+
+/* Events not completed within this time are abandoned, e.g. keys which never produce a report */
+#ifndef LATENCY_TRACKING_TIMEOUT_MS
+#    define LATENCY_TRACKING_TIMEOUT_MS 100
+#endif
+
+/* First byte of raw HID packets handled by latency tracking */
+#ifndef LATENCY_TRACKING_RAW_HID_ID
+#    define LATENCY_TRACKING_RAW_HID_ID 0xFD
+#endif
+
+/* Pipeline stages, in the order a key press passes through them */
+typedef enum {
+    LATENCY_STAGE_MATRIX_SCAN,     // scan that first saw the raw matrix change, starts an event
+    LATENCY_STAGE_DEBOUNCE,        // debounced matrix change
+    LATENCY_STAGE_ACTION_EXEC,     // key event handed to action_exec()
+    LATENCY_STAGE_REPORT_BUILD,    // keyboard report passed to host_keyboard_send()
+    LATENCY_STAGE_ENDPOINT_SUBMIT, // report handed to the USB endpoint
+    LATENCY_STAGE_COMPLETE,        // report collected by the host
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t mean_us;
+    uint16_t bins[LATENCY_TRACKING_BINS];
+} latency_stats_t;
+
+/* Raw HID commands, following LATENCY_TRACKING_RAW_HID_ID */
+enum latency_tracking_command_id {
+    id_latency_get_info  = 0x00, // -> stage count, bin count, bin width (us, 16 bit)
+    id_latency_get_stats = 0x01, // stage -> count, min, max, mean (us, 32 bit each)
+    id_latency_get_bins  = 0x02, // stage, first bin -> as many 16 bit bins as fit
+    id_latency_reset     = 0x03,
+};
+
+/**
+ * @brief Record that the event in flight has reached the given stage.
+ *
+ * LATENCY_STAGE_MATRIX_SCAN starts a new event unless one is already in flight;
+ * every other stage is recorded once per event, relative to its start. Safe to
+ * call from interrupt context.
+ */
+void latency_tracking_mark(latency_stage_t stage);
+
+/**
+ * @brief Get the statistics of the given stage, measured from the matrix scan.
+ */
+void latency_tracking_get_stats(latency_stage_t stage, latency_stats_t *stats);
+
+/**
+ * @brief Clear all collected statistics.
+ */
+void latency_tracking_reset(void);
+
+/**
+ * @brief Handle a latency tracking raw HID command, replying in place.
+ *
+ * @return true if the packet was a latency tracking command and a reply has been sent
+ */
+bool latency_tracking_raw_hid_receive(uint8_t *data, uint8_t length);
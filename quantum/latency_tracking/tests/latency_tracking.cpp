@@ -0,0 +1,152 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+extern "C" {
+#include "latency_tracking.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+static uint8_t last_sent[32];
+static int     sent_count = 0;
+
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    memcpy(last_sent, data, length);
+    sent_count++;
+}
+}
+
+class LatencyTracking : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        latency_tracking_reset();
+        sent_count = 0;
+    }
+
+    // Key press passing through every stage, with the given delay in ms before each one
+    void key_event(std::initializer_list<uint32_t> delays) {
+        latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+        uint8_t stage = LATENCY_STAGE_DEBOUNCE;
+        for (uint32_t delay : delays) {
+            advance_time(delay);
+            latency_tracking_mark((latency_stage_t)stage++);
+        }
+    }
+
+    static uint32_t be32(const uint8_t *data) {
+        return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3];
+    }
+};
+
+TEST_F(LatencyTracking, StagesAreMeasuredFromMatrixScan) {
+    key_event({5, 0, 1, 0, 1});
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_DEBOUNCE, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max_us, 5000);
+    EXPECT_EQ(stats.bins[5], 1);
+
+    latency_tracking_get_stats(LATENCY_STAGE_REPORT_BUILD, &stats);
+    EXPECT_EQ(stats.max_us, 6000);
+
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.min_us, 7000);
+    EXPECT_EQ(stats.bins[7], 1);
+}
+
+TEST_F(LatencyTracking, StatisticsAccumulate) {
+    key_event({1, 0, 0, 0, 1});
+    key_event({3, 0, 0, 0, 1});
+    key_event({20, 0, 0, 0, 1});
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &stats);
+    EXPECT_EQ(stats.count, 3);
+    EXPECT_EQ(stats.min_us, 2000);
+    EXPECT_EQ(stats.max_us, 21000);
+    EXPECT_EQ(stats.mean_us, 9000);
+    EXPECT_EQ(stats.bins[2], 1);
+    EXPECT_EQ(stats.bins[4], 1);
+    // Beyond the last bin
+    EXPECT_EQ(stats.bins[7], 1);
+}
+
+TEST_F(LatencyTracking, EdgesDuringEventAreIgnored) {
+    latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+    advance_time(2);
+    latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+    advance_time(3);
+    latency_tracking_mark(LATENCY_STAGE_DEBOUNCE);
+    // A second debounce output for the same event is not recorded again
+    latency_tracking_mark(LATENCY_STAGE_DEBOUNCE);
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_MATRIX_SCAN, &stats);
+    EXPECT_EQ(stats.count, 1);
+    latency_tracking_get_stats(LATENCY_STAGE_DEBOUNCE, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max_us, 5000);
+}
+
+TEST_F(LatencyTracking, StaleEventIsReplaced) {
+    // e.g. a layer key, which never produces a report
+    key_event({5, 0});
+    advance_time(LATENCY_TRACKING_TIMEOUT_MS + 1);
+    key_event({1, 0, 0, 0, 1});
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_MATRIX_SCAN, &stats);
+    EXPECT_EQ(stats.count, 2);
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max_us, 2000);
+}
+
+TEST_F(LatencyTracking, StagesWithoutEventAreIgnored) {
+    latency_tracking_mark(LATENCY_STAGE_COMPLETE);
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &stats);
+    EXPECT_EQ(stats.count, 0);
+}
+
+TEST_F(LatencyTracking, RawHidStats) {
+    key_event({1, 0, 0, 0, 2});
+
+    uint8_t data[32] = {LATENCY_TRACKING_RAW_HID_ID, id_latency_get_info};
+    EXPECT_TRUE(latency_tracking_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(sent_count, 1);
+    EXPECT_EQ(last_sent[2], LATENCY_STAGE_COUNT);
+    EXPECT_EQ(last_sent[3], LATENCY_TRACKING_BINS);
+    EXPECT_EQ(last_sent[4] << 8 | last_sent[5], LATENCY_TRACKING_BIN_WIDTH_US);
+
+    uint8_t stats[32] = {LATENCY_TRACKING_RAW_HID_ID, id_latency_get_stats, LATENCY_STAGE_COMPLETE};
+    EXPECT_TRUE(latency_tracking_raw_hid_receive(stats, sizeof(stats)));
+    EXPECT_EQ(be32(&last_sent[3]), 1);
+    EXPECT_EQ(be32(&last_sent[7]), 3000);
+    EXPECT_EQ(be32(&last_sent[11]), 3000);
+    EXPECT_EQ(be32(&last_sent[15]), 3000);
+
+    uint8_t bins[32] = {LATENCY_TRACKING_RAW_HID_ID, id_latency_get_bins, LATENCY_STAGE_COMPLETE, 2};
+    EXPECT_TRUE(latency_tracking_raw_hid_receive(bins, sizeof(bins)));
+    EXPECT_EQ(last_sent[4] << 8 | last_sent[5], 0);
+    EXPECT_EQ(last_sent[6] << 8 | last_sent[7], 1);
+
+    uint8_t reset[32] = {LATENCY_TRACKING_RAW_HID_ID, id_latency_reset};
+    EXPECT_TRUE(latency_tracking_raw_hid_receive(reset, sizeof(reset)));
+    latency_stats_t result;
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &result);
+    EXPECT_EQ(result.count, 0);
+}
+
+TEST_F(LatencyTracking, OtherRawHidPacketsArePassedOn) {
+    uint8_t data[32] = {0x01};
+    EXPECT_FALSE(latency_tracking_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(sent_count, 0);
+}
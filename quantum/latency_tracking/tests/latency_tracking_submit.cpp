@@ -0,0 +1,55 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "latency_tracking.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+void raw_hid_send(uint8_t *data, uint8_t length) {}
+}
+
+// Without a completion callback, as on LUFA and V-USB
+class LatencyTrackingSubmit : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        latency_tracking_reset();
+    }
+
+    void key_event(uint32_t delay) {
+        latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+        advance_time(delay);
+        latency_tracking_mark(LATENCY_STAGE_DEBOUNCE);
+        latency_tracking_mark(LATENCY_STAGE_ACTION_EXEC);
+        latency_tracking_mark(LATENCY_STAGE_REPORT_BUILD);
+        latency_tracking_mark(LATENCY_STAGE_ENDPOINT_SUBMIT);
+    }
+};
+
+TEST_F(LatencyTrackingSubmit, EventEndsAtEndpointSubmit) {
+    key_event(5);
+    // The next press follows well within the stale event timeout
+    advance_time(10);
+    key_event(2);
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_MATRIX_SCAN, &stats);
+    EXPECT_EQ(stats.count, 2);
+    latency_tracking_get_stats(LATENCY_STAGE_ENDPOINT_SUBMIT, &stats);
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.min_us, 2000);
+    EXPECT_EQ(stats.max_us, 5000);
+}
+
+TEST_F(LatencyTrackingSubmit, CompleteIsNotRecorded) {
+    key_event(1);
+    latency_tracking_mark(LATENCY_STAGE_COMPLETE);
+
+    latency_stats_t stats;
+    latency_tracking_get_stats(LATENCY_STAGE_COMPLETE, &stats);
+    EXPECT_EQ(stats.count, 0);
+}
@@ -0,0 +1,13 @@
+latency_tracking_DEFS := -DLATENCY_TRACKING_ENABLE -DIGNORE_ATOMIC_BLOCK -DLATENCY_TRACKING_BIN_WIDTH_US=1000 -DLATENCY_TRACKING_BINS=8 -DLATENCY_STAGE_LAST=LATENCY_STAGE_COMPLETE
+
+latency_tracking_SRC := \
+    $(QUANTUM_PATH)/latency_tracking/tests/latency_tracking.cpp \
+    $(QUANTUM_PATH)/latency_tracking.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+latency_tracking_submit_DEFS := -DLATENCY_TRACKING_ENABLE -DIGNORE_ATOMIC_BLOCK -DLATENCY_TRACKING_BIN_WIDTH_US=1000 -DLATENCY_TRACKING_BINS=8
+
+latency_tracking_submit_SRC := \
+    $(QUANTUM_PATH)/latency_tracking/tests/latency_tracking_submit.cpp \
+    $(QUANTUM_PATH)/latency_tracking.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1 @@
+TEST_LIST += latency_tracking latency_tracking_submit
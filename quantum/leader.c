@@ -3,6 +3,7 @@
 
 #include "leader.h"
 #include "timer.h"
+#include "timeout.h"
 #include "util.h"
 
 #include <string.h>
@@ -27,13 +28,14 @@ void leader_start(void) {
     }
     leader_start_user();
     leading              = true;
-    leader_time          = timer_read();
     leader_sequence_size = 0;
+    leader_reset_timer();
     memset(leader_sequence, 0, sizeof(leader_sequence));
 }
 
 void leader_end(void) {
     leading = false;
+    timeout_cancel(TIMEOUT_LEADER);
     leader_end_user();
 }
 
@@ -74,6 +76,8 @@ bool leader_sequence_timed_out(void) {
 
 void leader_reset_timer(void) {
     leader_time = timer_read();
+    // Sequence times out once strictly more than LEADER_TIMEOUT has elapsed
+    timeout_start(TIMEOUT_LEADER, LEADER_TIMEOUT + 1, leader_task);
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
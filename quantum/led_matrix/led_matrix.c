@@ -26,6 +26,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
 #ifndef LED_MATRIX_CENTER
 const led_point_t k_led_matrix_center = {112, 32};
 #else
@@ -262,7 +266,6 @@ static void led_task_timers(void) {
 }
 
 static void led_task_sync(void) {
-    eeconfig_flush_led_matrix(false);
     // next task
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
@@ -377,6 +380,16 @@ void led_matrix_task(void) {
             led_task_sync();
             break;
     }
+
+#ifdef IDLE_SLEEP_ENABLE
+    // Frames are rendered over several iterations, then nothing happens until the next one is due
+    if (led_task_state == SYNCING) {
+        uint32_t elapsed = sync_timer_elapsed32(g_led_timer);
+        idle_sleep_request_wakeup_in(elapsed < LED_MATRIX_LED_FLUSH_LIMIT ? LED_MATRIX_LED_FLUSH_LIMIT - elapsed : 0);
+    } else {
+        idle_sleep_prevent();
+    }
+#endif
 }
 
 void led_matrix_indicators(void) {
@@ -0,0 +1,230 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "binary_log.h"
+#include "sendchar.h"
+#include "progmem.h"
+
+_Static_assert(CONSOLE_BINARY_LOG_RECORD_SIZE >= 8 && CONSOLE_BINARY_LOG_RECORD_SIZE <= 253, "CONSOLE_BINARY_LOG_RECORD_SIZE must be between 8 and 253");
+_Static_assert(CONSOLE_BINARY_LOG_BUFFER_SIZE > CONSOLE_BINARY_LOG_RECORD_SIZE + 2, "CONSOLE_BINARY_LOG_BUFFER_SIZE must hold at least one record");
+
+// Records are only ever queued from the main loop, so a plain ring buffer
+// without any locking is sufficient.
+static uint8_t  log_buffer[CONSOLE_BINARY_LOG_BUFFER_SIZE];
+static uint16_t log_head    = 0;
+static uint16_t log_tail    = 0;
+static uint16_t log_dropped = 0;
+
+typedef struct {
+    uint8_t data[CONSOLE_BINARY_LOG_RECORD_SIZE];
+    uint8_t length;
+} binary_log_record_t;
+
+static inline uint16_t log_next(uint16_t index) {
+    return (index + 1 == CONSOLE_BINARY_LOG_BUFFER_SIZE) ? 0 : index + 1;
+}
+
+static uint16_t log_free(void) {
+    uint16_t used = (log_head >= log_tail) ? log_head - log_tail : CONSOLE_BINARY_LOG_BUFFER_SIZE - log_tail + log_head;
+    return CONSOLE_BINARY_LOG_BUFFER_SIZE - 1 - used;
+}
+
+static bool record_put_byte(binary_log_record_t *record, uint8_t value) {
+    if (record->length >= sizeof(record->data)) {
+        return false;
+    }
+    record->data[record->length++] = value;
+    return true;
+}
+
+static bool record_put_u32(binary_log_record_t *record, uint32_t value) {
+    if (record->length + 4 > sizeof(record->data)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        record->data[record->length++] = value & 0xFF;
+        value >>= 8;
+    }
+    return true;
+}
+
+static bool record_put_string(binary_log_record_t *record, const char *str, bool progmem) {
+    if (str == NULL) {
+        str     = PSTR("(null)");
+        progmem = true;
+    }
+    // Always leave space for the terminator, truncating the string if need be
+    while (record->length + 1 < sizeof(record->data)) {
+        char c = progmem ? pgm_read_byte(str) : *str;
+        if (c == '\0') {
+            break;
+        }
+        record->data[record->length++] = c;
+        str++;
+    }
+    return record_put_byte(record, '\0');
+}
+
+/**
+ * @brief Copy a record into the ring buffer, COBS encoded and zero terminated.
+ *
+ * Records are shorter than 254 bytes, so the encoded form is always exactly two
+ * bytes longer than the record.
+ */
+static bool log_push(const binary_log_record_t *record) {
+    if (log_free() < record->length + 2) {
+        return false;
+    }
+
+    uint16_t code_index = log_head;
+    uint8_t  code       = 1;
+    log_head            = log_next(log_head);
+    for (uint8_t i = 0; i < record->length; i++) {
+        if (record->data[i] == 0) {
+            log_buffer[code_index] = code;
+            code_index             = log_head;
+            code                   = 1;
+        } else {
+            log_buffer[log_head] = record->data[i];
+            code++;
+        }
+        log_head = log_next(log_head);
+    }
+    log_buffer[code_index] = code;
+    log_buffer[log_head]   = 0;
+    log_head               = log_next(log_head);
+    return true;
+}
+
+static void log_commit(binary_log_record_t *record) {
+    record->data[0] = record->length;
+
+    if (log_dropped) {
+        // Let the host know how many records went missing before this one
+        binary_log_record_t dropped = {.length = 1};
+        record_put_u32(&dropped, 0);
+        record_put_byte(&dropped, log_dropped & 0xFF);
+        record_put_byte(&dropped, log_dropped >> 8);
+        dropped.data[0] = dropped.length;
+        if (log_free() < dropped.length + 2 + record->length + 2 || !log_push(&dropped)) {
+            if (log_dropped < UINT16_MAX) log_dropped++;
+            return;
+        }
+        log_dropped = 0;
+    }
+
+    if (!log_push(record)) {
+        if (log_dropped < UINT16_MAX) log_dropped++;
+    }
+}
+
+void binary_log_printf(const char *fmt, ...) {
+    binary_log_record_t record = {.length = 1};
+    record_put_u32(&record, (uint32_t)(uintptr_t)fmt);
+
+    va_list args;
+    va_start(args, fmt);
+
+    // Walk the format string only as far as needed to pull the arguments off
+    // the stack in the right sizes; all actual formatting happens on the host.
+    const char *p  = fmt;
+    bool        ok = true;
+    while (ok) {
+        char c = pgm_read_byte(p++);
+        if (c == '\0') {
+            break;
+        }
+        if (c != '%') {
+            continue;
+        }
+
+        // flags
+        do {
+            c = pgm_read_byte(p++);
+        } while (c == '-' || c == '+' || c == ' ' || c == '#' || c == '0');
+
+        // width and precision
+        for (uint8_t field = 0; field < 2; field++) {
+            if (c == '*') {
+                ok = record_put_u32(&record, (uint32_t)va_arg(args, int));
+                c  = pgm_read_byte(p++);
+            } else {
+                while (c >= '0' && c <= '9') {
+                    c = pgm_read_byte(p++);
+                }
+            }
+            if (field == 0 && c == '.') {
+                c = pgm_read_byte(p++);
+            } else {
+                break;
+            }
+        }
+
+        // length modifiers
+        bool is_long = false;
+        while (c == 'l' || c == 'h' || c == 'z' || c == 't') {
+            if (c == 'l' || ((c == 'z' || c == 't') && sizeof(size_t) == sizeof(long))) {
+                is_long = true;
+            }
+            c = pgm_read_byte(p++);
+        }
+
+        switch (c) {
+            case 'd':
+            case 'i':
+                ok = ok && record_put_u32(&record, (uint32_t)(is_long ? va_arg(args, long) : va_arg(args, int)));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'b':
+            case 'c':
+                ok = ok && record_put_u32(&record, is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+                break;
+            case 'p':
+                ok = ok && record_put_u32(&record, (uint32_t)(uintptr_t)va_arg(args, void *));
+                break;
+            case 's':
+                ok = ok && record_put_string(&record, va_arg(args, const char *), false);
+                break;
+            case 'S':
+                ok = ok && record_put_string(&record, va_arg(args, const char *), true);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                // Not supported by the console, but must still be consumed
+                (void)va_arg(args, double);
+                break;
+            case '%':
+                break;
+            default:
+                // Unknown conversion, the remaining arguments can't be located
+                ok = false;
+                break;
+        }
+    }
+
+    va_end(args);
+    log_commit(&record);
+}
+
+void binary_log_task(void) {
+    for (uint8_t remaining = CONSOLE_BINARY_LOG_FLUSH_SIZE; remaining && log_tail != log_head; remaining--) {
+        sendchar(log_buffer[log_tail]);
+        log_tail = log_next(log_tail);
+    }
+}
+
+void binary_log_clear(void) {
+    log_head    = 0;
+    log_tail    = 0;
+    log_dropped = 0;
+}
@@ -0,0 +1,67 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @file binary_log.h
+ *
+ * Binary console logging. Instead of formatting text on the keyboard, each
+ * print/xprintf/dprintf call queues a record containing the address of its
+ * format string and the raw values of its arguments. Records are drained to the
+ * console a few bytes at a time from the main loop, and rendered to text on the
+ * host by `qmk console-decode` using the firmware's ELF file. Records must only
+ * be queued from the main loop.
+ *
+ * Each record is COBS encoded and terminated by a zero byte, so that the zero
+ * padding of partially filled console reports never corrupts the stream:
+ *
+ *     [length][format address, 4 bytes LE][arguments...]
+ *
+ * The length byte covers the whole record and lets the host spot records that
+ * were cut short.
+ * Integer arguments (including `%c` and `*` widths) are stored as 4 bytes LE,
+ * `%s`/`%S` arguments as a NUL terminated copy of the string. A record with a
+ * format address of zero carries the 2 byte count of records dropped because
+ * the buffer was full.
+ */
+
+#ifndef CONSOLE_BINARY_LOG_BUFFER_SIZE
+#    define CONSOLE_BINARY_LOG_BUFFER_SIZE 256
+#endif
+
+#ifndef CONSOLE_BINARY_LOG_FLUSH_SIZE
+#    define CONSOLE_BINARY_LOG_FLUSH_SIZE 32
+#endif
+
+#ifndef CONSOLE_BINARY_LOG_RECORD_SIZE
+#    define CONSOLE_BINARY_LOG_RECORD_SIZE 48
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue a log record for the given format string and arguments.
+ *
+ * @param fmt printf style format string, which must be a string literal (in
+ * program memory on AVR) so the host can find it by address
+ */
+void binary_log_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Send up to CONSOLE_BINARY_LOG_FLUSH_SIZE queued bytes to the console.
+ */
+void binary_log_task(void);
+
+/**
+ * @brief Drop all queued records and reset the dropped record count.
+ */
+void binary_log_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
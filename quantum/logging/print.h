@@ -49,7 +49,19 @@ void print_set_sendchar(sendchar_func_t func);
     } while (0)
 
 #ifndef NO_PRINT
-#    if __has_include_next("_print.h")
+#    if defined(CONSOLE_BINARY_LOG_ENABLE)
+// Queue format string addresses and raw arguments, rendered by the host
+#        include "binary_log.h"
+
+// Create user & normal print defines
+#        define print(s) binary_log_printf(PSTR(s))
+#        define println(s) binary_log_printf(PSTR(s "\r\n"))
+#        define xprintf(fmt, ...) binary_log_printf(PSTR(fmt), ##__VA_ARGS__)
+#        define uprint(s) binary_log_printf(PSTR(s))
+#        define uprintln(s) binary_log_printf(PSTR(s "\r\n"))
+#        define uprintf(fmt, ...) binary_log_printf(PSTR(fmt), ##__VA_ARGS__)
+
+#    elif __has_include_next("_print.h")
 #        include_next "_print.h" /* Include the platforms print.h */
 #    else
 // Fall back to lib/printf
@@ -0,0 +1,167 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "binary_log.h"
+}
+
+// The test harness sendchar() writes to stdout
+class BinaryLog : public ::testing::Test {
+   protected:
+    std::vector<uint8_t> console;
+
+    void SetUp() override {
+        binary_log_clear();
+    }
+
+    void flush() {
+        ::testing::internal::CaptureStdout();
+        binary_log_task();
+        fflush(stdout);
+        std::string output = ::testing::internal::GetCapturedStdout();
+        console.insert(console.end(), output.begin(), output.end());
+    }
+
+    void drain() {
+        for (int i = 0; i < CONSOLE_BINARY_LOG_BUFFER_SIZE / CONSOLE_BINARY_LOG_FLUSH_SIZE + 1; i++) {
+            flush();
+        }
+    }
+
+    // Split the console output on zero bytes and undo the COBS encoding
+    std::vector<std::vector<uint8_t>> records() {
+        std::vector<std::vector<uint8_t>> result;
+        std::vector<uint8_t>              frame;
+        for (uint8_t c : console) {
+            if (c != 0) {
+                frame.push_back(c);
+                continue;
+            }
+            std::vector<uint8_t> record;
+            for (size_t i = 0; i < frame.size();) {
+                uint8_t code = frame[i++];
+                for (uint8_t j = 1; j < code; j++) {
+                    record.push_back(frame.at(i++));
+                }
+                if (i < frame.size()) {
+                    record.push_back(0);
+                }
+            }
+            result.push_back(record);
+            frame.clear();
+        }
+        return result;
+    }
+
+    static std::vector<uint8_t> u32(uint32_t value) {
+        return {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    }
+
+    static std::vector<uint8_t> record(const char *fmt, std::vector<uint8_t> args = {}) {
+        std::vector<uint8_t> result = {0};
+        auto                 id     = u32((uint32_t)(uintptr_t)fmt);
+        result.insert(result.end(), id.begin(), id.end());
+        result.insert(result.end(), args.begin(), args.end());
+        result[0] = result.size();
+        return result;
+    }
+};
+
+TEST_F(BinaryLog, PlainStringIsAddressOnly) {
+    static const char fmt[] = "hello\n";
+    binary_log_printf(fmt);
+    drain();
+    auto out = records();
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], record(fmt));
+}
+
+TEST_F(BinaryLog, IntegersAreStoredRaw) {
+    static const char fmt[] = "%d %02u %lX %c %%";
+    binary_log_printf(fmt, -2, 7u, 0x12345678ul, 'q');
+    drain();
+
+    std::vector<uint8_t> args;
+    for (uint32_t value : {0xFFFFFFFEu, 7u, 0x12345678u, (uint32_t)'q'}) {
+        auto bytes = u32(value);
+        args.insert(args.end(), bytes.begin(), bytes.end());
+    }
+    auto out = records();
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], record(fmt, args));
+}
+
+TEST_F(BinaryLog, StarWidthIsStoredBeforeValue) {
+    static const char fmt[] = "%*.*d";
+    binary_log_printf(fmt, 5, 3, 42);
+    drain();
+
+    std::vector<uint8_t> args;
+    for (uint32_t value : {5u, 3u, 42u}) {
+        auto bytes = u32(value);
+        args.insert(args.end(), bytes.begin(), bytes.end());
+    }
+    auto out = records();
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], record(fmt, args));
+}
+
+TEST_F(BinaryLog, StringsAreCopied) {
+    static const char fmt[] = "%s=%u";
+    char              name[] = "layer";
+    binary_log_printf(fmt, name, 3u);
+    name[0] = 'X';
+    drain();
+
+    std::vector<uint8_t> args = {'l', 'a', 'y', 'e', 'r', 0};
+    auto                 bytes = u32(3);
+    args.insert(args.end(), bytes.begin(), bytes.end());
+    auto out = records();
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], record(fmt, args));
+}
+
+TEST_F(BinaryLog, LongStringsAreTruncated) {
+    static const char fmt[] = "%s";
+    std::string       text(CONSOLE_BINARY_LOG_RECORD_SIZE * 2, 'a');
+    binary_log_printf(fmt, text.c_str());
+    drain();
+
+    auto out = records();
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_EQ(out[0].size(), CONSOLE_BINARY_LOG_RECORD_SIZE);
+    EXPECT_EQ(out[0][0], CONSOLE_BINARY_LOG_RECORD_SIZE);
+    EXPECT_EQ(out[0].back(), 0);
+}
+
+TEST_F(BinaryLog, FlushIsBounded) {
+    static const char fmt[] = "%u %u %u";
+    binary_log_printf(fmt, 1u, 2u, 3u);
+    flush();
+    EXPECT_EQ(console.size(), CONSOLE_BINARY_LOG_FLUSH_SIZE);
+    drain();
+    EXPECT_EQ(console.size(), 5 + 3 * 4 + 2);
+}
+
+TEST_F(BinaryLog, OverflowIsReported) {
+    static const char fmt[] = "%lu";
+    // Each record is 9 bytes, 11 encoded, and the buffer only holds 63
+    for (uint32_t i = 0; i < 8; i++) {
+        binary_log_printf(fmt, (unsigned long)i);
+    }
+    drain();
+    binary_log_printf(fmt, 99ul);
+    drain();
+
+    auto out = records();
+    ASSERT_EQ(out.size(), 5 + 2);
+    for (uint32_t i = 0; i < 5; i++) {
+        EXPECT_EQ(out[i], record(fmt, u32(i)));
+    }
+    EXPECT_EQ(out[5], record(nullptr, {3, 0}));
+    EXPECT_EQ(out[6], record(fmt, u32(99)));
+}
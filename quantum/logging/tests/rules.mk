@@ -0,0 +1,4 @@
+binary_log_DEFS := -DCONSOLE_BINARY_LOG_ENABLE -DCONSOLE_BINARY_LOG_BUFFER_SIZE=64 -DCONSOLE_BINARY_LOG_FLUSH_SIZE=16
+binary_log_SRC := \
+	$(QUANTUM_PATH)/logging/tests/binary_log_tests.cpp \
+	$(QUANTUM_PATH)/logging/binary_log.c
@@ -20,7 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "matrix.h"
 #include "debounce.h"
+#include "matrix_port.h"
 #include "quantum.h"
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -50,6 +54,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+// Read all input pins of a row/col with a single read per GPIO port, where the platform supports it
+#if defined(readPortData) && !defined(MATRIX_NO_PORT_READS) && !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+#    if (DIODE_DIRECTION == COL2ROW) || ((DIODE_DIRECTION == ROW2COL) && (ROWS_PER_HAND <= 32))
+#        define MATRIX_PORT_READS
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -103,6 +114,29 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#ifdef MATRIX_PORT_READS
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_INPUT_PIN_COUNT MATRIX_COLS
+#        define matrix_input_pins col_pins
+#    else
+#        define MATRIX_INPUT_PIN_COUNT ROWS_PER_HAND
+#        define matrix_input_pins row_pins
+#    endif
+
+static gpio_port_t       input_ports[MATRIX_INPUT_PIN_COUNT];
+static matrix_port_run_t input_runs[MATRIX_INPUT_PIN_COUNT];
+static matrix_port_map_t input_map;
+
+/** \brief Reads every input pin at once, bit N is set when input pin N is in the pressed state. */
+static inline uint32_t read_matrix_input_pins(void) {
+#    if MATRIX_INPUT_PRESSED_STATE
+    return matrix_port_read(&input_map);
+#    else
+    return ~matrix_port_read(&input_map) & input_map.pin_mask;
+#    endif
+}
+#endif
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -180,6 +214,10 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_READS
+    // Capture all cols with one read per port
+    current_row_value = (matrix_row_t)read_matrix_input_pins();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -188,6 +226,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -243,10 +282,19 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_READS
+    // Capture all rows with one read per port
+    uint32_t rows_pressed = read_matrix_input_pins();
+#            endif
+
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
+#            ifdef MATRIX_PORT_READS
+        if (rows_pressed & ((uint32_t)1 << row_index)) {
+#            else
         if (readMatrixPin(row_pins[row_index]) == 0) {
+#            endif
             // Pin LO, set col bit
             current_matrix[row_index] |= row_shifter;
             key_pressed = true;
@@ -269,6 +317,133 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_SCAN_ON_CHANGE
+#    ifndef enablePinChangeCallback
+#        error "MATRIX_SCAN_ON_CHANGE is not supported on this platform"
+#    endif
+
+#    if defined(DIRECT_PINS)
+#        define MATRIX_WAKE_PIN_COUNT (ROWS_PER_HAND * MATRIX_COLS)
+#        define matrix_wake_pin(i) (direct_pins[(i) / MATRIX_COLS][(i) % MATRIX_COLS])
+#    elif (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_WAKE_PIN_COUNT MATRIX_COLS
+#        define matrix_wake_pin(i) (col_pins[i])
+#    else
+#        define MATRIX_WAKE_PIN_COUNT ROWS_PER_HAND
+#        define matrix_wake_pin(i) (row_pins[i])
+#    endif
+
+static volatile bool scan_wake_pending = false;
+static bool          scan_idle         = false;
+static bool          scan_idle_allowed = true;
+
+static void matrix_wake_callback(void *arg) {
+    scan_wake_pending = true;
+#    ifdef IDLE_SLEEP_ENABLE
+    idle_sleep_wake();
+#    endif
+}
+
+#    ifdef getPinChangeLine
+/** \brief True if a wake pin shares a pin change interrupt line with another wake pin, or with the pointing device motion
+ * pin, where arming it would silently steal the other's.
+ */
+static bool matrix_wake_lines_conflict(void) {
+    for (uint16_t i = 0; i < MATRIX_WAKE_PIN_COUNT; i++) {
+        pin_t pin = matrix_wake_pin(i);
+        if (pin == NO_PIN) {
+            continue;
+        }
+#        if defined(POINTING_DEVICE_MOTION_PIN) && defined(POINTING_DEVICE_MOTION_PIN_INTERRUPT)
+        if (getPinChangeLine(pin) == getPinChangeLine(POINTING_DEVICE_MOTION_PIN)) {
+            return true;
+        }
+#        endif
+        for (uint16_t j = i + 1; j < MATRIX_WAKE_PIN_COUNT; j++) {
+            pin_t other = matrix_wake_pin(j);
+            if (other != NO_PIN && getPinChangeLine(other) == getPinChangeLine(pin)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#    endif
+
+/** \brief Parks the matrix with every output selected, so that any keypress causes an edge on an input pin.
+ */
+static void matrix_scan_idle_enter(void) {
+    scan_wake_pending = false;
+    scan_idle         = true;
+
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+#    endif
+    matrix_output_select_delay();
+
+    for (uint16_t i = 0; i < MATRIX_WAKE_PIN_COUNT; i++) {
+        pin_t pin = matrix_wake_pin(i);
+        if (pin != NO_PIN) {
+            enablePinChangeCallback(pin, matrix_wake_callback);
+        }
+    }
+
+    // Catch anything pressed before the callbacks were armed
+    for (uint16_t i = 0; i < MATRIX_WAKE_PIN_COUNT; i++) {
+        if (readMatrixPin(matrix_wake_pin(i)) == 0) {
+            scan_wake_pending = true;
+            break;
+        }
+    }
+}
+
+/** \brief Restores the matrix to its normal unselected state ahead of a full scan.
+ */
+static void matrix_scan_idle_exit(void) {
+    if (!scan_idle) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < MATRIX_WAKE_PIN_COUNT; i++) {
+        pin_t pin = matrix_wake_pin(i);
+        if (pin != NO_PIN) {
+            disablePinChangeCallback(pin);
+        }
+    }
+
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    unselect_rows();
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    unselect_cols();
+#    endif
+    matrix_output_unselect_delay(0, true);
+
+    scan_idle         = false;
+    scan_wake_pending = false;
+}
+
+/** \brief True once no key is held, and debounce has caught up with it. */
+static bool matrix_scan_is_released(void) {
+#    ifdef SPLIT_KEYBOARD
+    matrix_row_t *debounced = matrix + thisHand;
+#    else
+    matrix_row_t *debounced = matrix;
+#    endif
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] || debounced[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // MATRIX_SCAN_ON_CHANGE
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -299,6 +474,10 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#ifdef MATRIX_PORT_READS
+    matrix_port_map_init(&input_map, input_ports, input_runs, matrix_input_pins, MATRIX_INPUT_PIN_COUNT);
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -308,6 +487,13 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#if defined(MATRIX_SCAN_ON_CHANGE) && defined(getPinChangeLine)
+    scan_idle_allowed = !matrix_wake_lines_conflict();
+    if (!scan_idle_allowed) {
+        dprintf("matrix: input pins share a pin change line, MATRIX_SCAN_ON_CHANGE disabled\n");
+    }
+#endif
+
     matrix_init_kb();
 }
 
@@ -319,7 +505,8 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
+/** \brief Reads the whole matrix, returning true if the raw matrix changed. */
+static bool matrix_scan_raw(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
@@ -337,6 +524,24 @@ uint8_t matrix_scan(void) {
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+    return changed;
+}
+
+uint8_t matrix_scan(void) {
+#ifdef MATRIX_SCAN_ON_CHANGE
+    // While parked, nothing can have moved without an edge -- debounce still runs, and sees the raw matrix unchanged
+    bool changed = false;
+    if (!scan_idle || scan_wake_pending) {
+        matrix_scan_idle_exit();
+        changed = matrix_scan_raw();
+    }
+#else
+    bool changed = matrix_scan_raw();
+#endif
+
+#ifdef LATENCY_TRACKING_ENABLE
+    if (changed) latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+#endif
 
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
@@ -344,5 +549,11 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+#ifdef MATRIX_SCAN_ON_CHANGE
+    if (scan_idle_allowed && !scan_idle && matrix_scan_is_released()) {
+        matrix_scan_idle_enter();
+    }
+#endif
     return (uint8_t)changed;
 }
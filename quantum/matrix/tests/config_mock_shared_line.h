@@ -0,0 +1,25 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 3
+
+#define MATRIX_ROW_PINS \
+    { 0x00, 0x01 }
+#define MATRIX_COL_PINS \
+    { 0x10, 0x13, 0x23 }
+#define DIODE_DIRECTION COL2ROW
+
+// B3 and C3 share pin change line 3
+#define MATRIX_SCAN_ON_CHANGE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,90 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+}
+
+class MatrixScanOnChange : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        mockReset();
+        matrix_init();
+    }
+
+    void SetUp() override {
+        // Release everything left over, then let the matrix park
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                mockSetKey(row, col, false);
+            }
+        }
+        matrix_scan();
+        matrix_scan();
+        mock_pin_reads  = 0;
+        mock_idle_wakes = 0;
+    }
+};
+
+TEST_F(MatrixScanOnChange, ParkedMatrixIsNotScanned) {
+    EXPECT_TRUE(mockPinChangeArmed(0x10));
+    EXPECT_TRUE(mockPinChangeArmed(0x11));
+    EXPECT_TRUE(mockPinChangeArmed(0x12));
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(matrix_scan(), 0);
+    }
+    EXPECT_EQ(mock_pin_reads, 0u);
+    EXPECT_EQ(mock_idle_wakes, 0u);
+}
+
+TEST_F(MatrixScanOnChange, EdgeWakesAndScans) {
+    mockSetKey(1, 2, true);
+    EXPECT_EQ(mock_idle_wakes, 1u);
+
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[0], 0u);
+    EXPECT_EQ(matrix[1], 1u << 2);
+    EXPECT_FALSE(mockPinChangeArmed(0x12));
+}
+
+TEST_F(MatrixScanOnChange, HeldKeyKeepsScanning) {
+    mockSetKey(0, 1, true);
+    matrix_scan();
+    mock_pin_reads = 0;
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(matrix_scan(), 0);
+    }
+    EXPECT_GT(mock_pin_reads, 0u);
+    EXPECT_EQ(matrix[0], 1u << 1);
+
+    mockSetKey(0, 1, false);
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[0], 0u);
+
+    // Released again, so parked
+    EXPECT_TRUE(mockPinChangeArmed(0x11));
+    mock_pin_reads = 0;
+    matrix_scan();
+    EXPECT_EQ(mock_pin_reads, 0u);
+}
+
+TEST_F(MatrixScanOnChange, PressWhileArmingIsCaught) {
+    mockSetKey(0, 0, true);
+    matrix_scan();
+
+    // Pressed after the outputs are selected, but before any callback is armed, so no edge fires
+    mockPressWhileArming(1, 1);
+    mockSetKey(0, 0, false);
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[0], 0u);
+    EXPECT_EQ(mock_idle_wakes, 1u);
+
+    // The read back after arming still scans it
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[1], 1u << 1);
+}
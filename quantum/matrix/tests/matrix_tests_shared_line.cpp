@@ -0,0 +1,33 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+}
+
+class MatrixScanOnChangeSharedLine : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mockReset();
+        matrix_init();
+    }
+};
+
+TEST_F(MatrixScanOnChangeSharedLine, NeverParks) {
+    // Parking would arm two pins on the same line, and lose the edges of whichever was armed first
+    for (int i = 0; i < 10; i++) {
+        matrix_scan();
+    }
+    const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+    for (pin_t pin : col_pins) {
+        EXPECT_FALSE(mockPinChangeArmed(pin));
+    }
+
+    mockSetKey(0, 1, true);
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[0], 1u << 1);
+}
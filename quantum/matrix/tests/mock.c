@@ -0,0 +1,149 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+#include "matrix.h"
+#include "mock.h"
+
+#define PIN_COUNT 64
+
+typedef struct {
+    bool                  output;
+    bool                  level;
+    pin_change_callback_t callback;
+} mock_pin_t;
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static mock_pin_t mock_pins[PIN_COUNT];
+static bool       mock_keys[MATRIX_ROWS][MATRIX_COLS];
+static int        mock_arming_row = -1;
+static int        mock_arming_col = -1;
+
+uint32_t mock_pin_reads  = 0;
+uint32_t mock_idle_wakes = 0;
+
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+// Level seen on an input pin: pulled high, unless a pressed key connects it to a row driven low
+static bool mock_input_level(pin_t pin) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!mock_keys[row][col]) {
+                continue;
+            }
+            pin_t other = row_pins[row] == pin ? col_pins[col] : col_pins[col] == pin ? row_pins[row] : NO_PIN;
+            if (other != NO_PIN && mock_pins[other].output && !mock_pins[other].level) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Settles every input, firing the callbacks of any armed pin whose level changed
+static void mock_settle(void) {
+    bool before[PIN_COUNT];
+    for (pin_t pin = 0; pin < PIN_COUNT; pin++) {
+        before[pin] = mock_pins[pin].level;
+    }
+    for (pin_t pin = 0; pin < PIN_COUNT; pin++) {
+        if (!mock_pins[pin].output) {
+            mock_pins[pin].level = mock_input_level(pin);
+        }
+    }
+    for (pin_t pin = 0; pin < PIN_COUNT; pin++) {
+        if (mock_pins[pin].level != before[pin] && mock_pins[pin].callback) {
+            mock_pins[pin].callback(NULL);
+        }
+    }
+}
+
+void mockSetPinInputHigh(pin_t pin) {
+    mock_pins[pin].output = false;
+    mock_settle();
+}
+
+void mockSetPinOutput(pin_t pin) {
+    mock_pins[pin].output = true;
+    mock_settle();
+}
+
+void mockWritePin(pin_t pin, bool level) {
+    mock_pins[pin].level = level;
+    mock_settle();
+}
+
+bool mockReadPin(pin_t pin) {
+    mock_pin_reads++;
+    return mock_pins[pin].level;
+}
+
+void mockSetPinChangeCallback(pin_t pin, pin_change_callback_t callback) {
+    // Like an STM32 EXTI line, the last pin armed on a line takes it over
+    for (pin_t other = 0; other < PIN_COUNT; other++) {
+        if (callback && other != pin && getPinChangeLine(other) == getPinChangeLine(pin)) {
+            mock_pins[other].callback = NULL;
+        }
+    }
+    mock_pins[pin].callback = callback;
+}
+
+bool mockPinChangeArmed(pin_t pin) {
+    return mock_pins[pin].callback != NULL;
+}
+
+void mockReset(void) {
+    memset(mock_pins, 0, sizeof(mock_pins));
+    for (pin_t pin = 0; pin < PIN_COUNT; pin++) {
+        mock_pins[pin].level = true;
+    }
+    memset(mock_keys, 0, sizeof(mock_keys));
+    mock_arming_row = -1;
+    mock_arming_col = -1;
+    mock_pin_reads  = 0;
+    mock_idle_wakes = 0;
+}
+
+void mockSetKey(uint8_t row, uint8_t col, bool pressed) {
+    mock_keys[row][col] = pressed;
+    mock_settle();
+}
+
+void mockPressWhileArming(uint8_t row, uint8_t col) {
+    mock_arming_row = row;
+    mock_arming_col = col;
+}
+
+void idle_sleep_wake(void) {
+    mock_idle_wakes++;
+}
+
+void debounce_init(uint8_t num_rows) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool cooked_changed = memcmp(raw, cooked, sizeof(matrix_row_t) * num_rows) != 0;
+    memcpy(cooked, raw, sizeof(matrix_row_t) * num_rows);
+    return cooked_changed;
+}
+
+void matrix_init_kb(void) {}
+void matrix_scan_kb(void) {}
+
+void matrix_output_select_delay(void) {
+    // Every row selected at once only happens while parking, before the pin change callbacks are armed
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (!mock_pins[row_pins[row]].output || mock_pins[row_pins[row]].level) {
+            return;
+        }
+    }
+    if (mock_arming_row >= 0) {
+        mockSetKey(mock_arming_row, mock_arming_col, true);
+        mock_arming_row = -1;
+    }
+}
+
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
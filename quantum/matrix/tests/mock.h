@@ -0,0 +1,35 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Mock GPIO pins, encoded as (port << 4) | pad -- like STM32, every pad number shares one pin change line
+typedef uint8_t pin_t;
+
+typedef void (*pin_change_callback_t)(void *arg);
+
+#define setPinInputHigh(pin) (mockSetPinInputHigh(pin))
+#define setPinOutput(pin) (mockSetPinOutput(pin))
+#define writePinLow(pin) (mockWritePin(pin, false))
+#define writePinHigh(pin) (mockWritePin(pin, true))
+#define readPin(pin) (mockReadPin(pin))
+#define enablePinChangeCallback(pin, callback) (mockSetPinChangeCallback(pin, callback))
+#define disablePinChangeCallback(pin) (mockSetPinChangeCallback(pin, NULL))
+#define getPinChangeLine(pin) ((pin)&0x0F)
+
+extern uint32_t mock_pin_reads;
+extern uint32_t mock_idle_wakes;
+
+void mockSetPinInputHigh(pin_t pin);
+void mockSetPinOutput(pin_t pin);
+void mockWritePin(pin_t pin, bool level);
+bool mockReadPin(pin_t pin);
+void mockSetPinChangeCallback(pin_t pin, pin_change_callback_t callback);
+bool mockPinChangeArmed(pin_t pin);
+
+void mockReset(void);
+void mockSetKey(uint8_t row, uint8_t col, bool pressed);
+void mockPressWhileArming(uint8_t row, uint8_t col);
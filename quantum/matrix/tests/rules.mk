@@ -0,0 +1,20 @@
+matrix_scan_on_change_DEFS := -DIGNORE_ATOMIC_BLOCK -DIDLE_SLEEP_ENABLE
+matrix_scan_on_change_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+
+matrix_scan_on_change_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_scan_on_change_shared_line_DEFS := -DIGNORE_ATOMIC_BLOCK -DIDLE_SLEEP_ENABLE
+matrix_scan_on_change_shared_line_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock_shared_line.h
+
+matrix_scan_on_change_shared_line_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests_shared_line.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_scan_on_change_motion_pin_DEFS := -DIGNORE_ATOMIC_BLOCK -DIDLE_SLEEP_ENABLE
+matrix_scan_on_change_motion_pin_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock_motion_pin.h
+
+matrix_scan_on_change_motion_pin_SRC := $(matrix_scan_on_change_shared_line_SRC)
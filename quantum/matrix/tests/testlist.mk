@@ -0,0 +1 @@
+TEST_LIST += matrix_scan_on_change matrix_scan_on_change_shared_line matrix_scan_on_change_motion_pin
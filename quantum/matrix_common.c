@@ -4,6 +4,9 @@
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -168,6 +171,10 @@ __attribute__((weak)) void matrix_init(void) {
 __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
+#ifdef LATENCY_TRACKING_ENABLE
+    if (changed) latency_tracking_mark(LATENCY_STAGE_MATRIX_SCAN);
+#endif
+
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
@@ -0,0 +1,73 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_port.h"
+
+#ifdef readPortData
+
+void matrix_port_map_init(matrix_port_map_t *map, gpio_port_t *ports, matrix_port_run_t *runs, const pin_t *pins, uint8_t pin_count) {
+    map->ports      = ports;
+    map->runs       = runs;
+    map->port_count = 0;
+    map->run_count  = 0;
+    map->pin_mask   = 0;
+
+    for (uint8_t i = 0; i < pin_count; i++) {
+        pin_t pin = pins[i];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        gpio_port_t port       = getPinPort(pin);
+        uint8_t     port_bit   = getPinPortBit(pin);
+        uint8_t     port_index = 0;
+        while (port_index < map->port_count && ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == map->port_count) {
+            ports[map->port_count++] = port;
+        }
+        map->pin_mask |= (uint32_t)1 << i;
+
+        // Extend the previous run if both the port bit and the destination bit follow on from it
+        if (map->run_count > 0) {
+            matrix_port_run_t *last = &runs[map->run_count - 1];
+            if (last->port_index == port_index && last->port_bit + last->width == port_bit && last->dest_bit + last->width == i) {
+                last->width++;
+                continue;
+            }
+        }
+
+        runs[map->run_count++] = (matrix_port_run_t){.port_index = port_index, .port_bit = port_bit, .dest_bit = i, .width = 1};
+    }
+
+    // Group the runs by port, so each port only needs reading once
+    for (uint8_t i = 1; i < map->run_count; i++) {
+        matrix_port_run_t run = runs[i];
+        uint8_t           j   = i;
+        while (j > 0 && runs[j - 1].port_index > run.port_index) {
+            runs[j] = runs[j - 1];
+            j--;
+        }
+        runs[j] = run;
+    }
+}
+
+uint32_t matrix_port_read(const matrix_port_map_t *map) {
+    uint32_t result     = 0;
+    uint32_t data       = 0;
+    uint8_t  port_index = UINT8_MAX;
+
+    for (uint8_t i = 0; i < map->run_count; i++) {
+        const matrix_port_run_t *run = &map->runs[i];
+        if (run->port_index != port_index) {
+            port_index = run->port_index;
+            data       = readPortData(map->ports[port_index]);
+        }
+        result |= ((data >> run->port_bit) & (UINT32_MAX >> (32 - run->width))) << run->dest_bit;
+    }
+
+    return result;
+}
+
+#endif // readPortData
@@ -0,0 +1,53 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "gpio.h"
+
+#ifdef readPortData
+
+/**
+ * @typedef A run of consecutive port bits which map onto consecutive bits of the gathered value.
+ */
+typedef struct matrix_port_run_t {
+    uint8_t port_index;
+    uint8_t port_bit;
+    uint8_t dest_bit;
+    uint8_t width;
+} matrix_port_run_t;
+
+/**
+ * @typedef Precomputed grouping of a list of pins by GPIO port, so that their levels can be captured with a single
+ * read per port.
+ */
+typedef struct matrix_port_map_t {
+    gpio_port_t *      ports;
+    matrix_port_run_t *runs;
+    uint8_t            port_count;
+    uint8_t            run_count;
+    uint32_t           pin_mask;
+} matrix_port_map_t;
+
+/**
+ * Groups the supplied pins by port. NO_PIN entries are skipped, and their bits are left out of `pin_mask`.
+ *
+ * @param map[out] the map to initialise
+ * @param ports[in] storage for the distinct ports, with room for `pin_count` entries
+ * @param runs[in] storage for the runs, with room for `pin_count` entries
+ * @param pins[in] the pins to group, at most 32
+ * @param pin_count[in] the number of pins
+ */
+void matrix_port_map_init(matrix_port_map_t *map, gpio_port_t *ports, matrix_port_run_t *runs, const pin_t *pins, uint8_t pin_count);
+
+/**
+ * Reads the levels of all pins in the map. Bit N is set when pin N reads high, bits of NO_PIN entries are always
+ * clear.
+ *
+ * @param map[in] the map to read
+ * @return the gathered pin levels
+ */
+uint32_t matrix_port_read(const matrix_port_map_t *map);
+
+#endif // readPortData
@@ -0,0 +1,31 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Four mock 32-bit GPIO ports, pins are encoded as (port << 5) | bit
+typedef uint8_t  pin_t;
+typedef uint8_t  gpio_port_t;
+typedef uint32_t gpio_port_data_t;
+
+extern uint32_t mock_port_data[4];
+extern uint32_t mock_port_reads;
+
+uint32_t mock_read_port(gpio_port_t port);
+
+#define readPin(pin) ((bool)((mock_port_data[(pin) >> 5] >> ((pin)&31)) & 1))
+
+#define getPinPort(pin) ((gpio_port_t)((pin) >> 5))
+#define getPinPortBit(pin) ((pin)&31)
+#define readPortData(port) mock_read_port(port)
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,143 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "matrix_port.h"
+
+uint32_t mock_port_data[4] = {0};
+uint32_t mock_port_reads   = 0;
+
+uint32_t mock_read_port(gpio_port_t port) {
+    mock_port_reads++;
+    return mock_port_data[port];
+}
+}
+
+#define PIN(port, bit) ((pin_t)(((port) << 5) | (bit)))
+
+// Reference: the per-pin path, one read per pin
+static uint32_t read_per_pin(const std::vector<pin_t> &pins) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < pins.size(); i++) {
+        if (pins[i] != NO_PIN && readPin(pins[i])) {
+            result |= (uint32_t)1 << i;
+        }
+    }
+    return result;
+}
+
+class MatrixPort : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (auto &data : mock_port_data) {
+            data = 0;
+        }
+        mock_port_reads = 0;
+    }
+
+    void init(const std::vector<pin_t> &pins) {
+        this->pins = pins;
+        ports.resize(pins.size());
+        runs.resize(pins.size());
+        matrix_port_map_init(&map, ports.data(), runs.data(), pins.data(), pins.size());
+    }
+
+    std::vector<pin_t>             pins;
+    std::vector<gpio_port_t>       ports;
+    std::vector<matrix_port_run_t> runs;
+    matrix_port_map_t              map;
+};
+
+TEST_F(MatrixPort, ContiguousPinsFormSingleRun) {
+    init({PIN(0, 4), PIN(0, 5), PIN(0, 6), PIN(0, 7)});
+    EXPECT_EQ(map.port_count, 1);
+    EXPECT_EQ(map.run_count, 1);
+    EXPECT_EQ(map.pin_mask, 0xFu);
+
+    mock_port_data[0] = 0xA0;
+    EXPECT_EQ(matrix_port_read(&map), 0xAu);
+    EXPECT_EQ(mock_port_reads, 1u);
+}
+
+TEST_F(MatrixPort, OneReadPerPort) {
+    init({PIN(1, 3), PIN(0, 0), PIN(2, 9), PIN(1, 4), PIN(0, 7), PIN(2, 1), PIN(1, 12), PIN(0, 8)});
+    EXPECT_EQ(map.port_count, 3);
+
+    mock_port_data[0] = 0xFFFFFFFF;
+    mock_port_data[1] = 0xFFFFFFFF;
+    mock_port_data[2] = 0xFFFFFFFF;
+    EXPECT_EQ(matrix_port_read(&map), 0xFFu);
+    EXPECT_EQ(mock_port_reads, 3u);
+}
+
+TEST_F(MatrixPort, NoPinIsExcluded) {
+    init({PIN(0, 0), NO_PIN, PIN(0, 2)});
+    EXPECT_EQ(map.pin_mask, 0x5u);
+
+    mock_port_data[0] = 0xFFFFFFFF;
+    EXPECT_EQ(matrix_port_read(&map), 0x5u);
+}
+
+TEST_F(MatrixPort, FullWidthRun) {
+    std::vector<pin_t> all;
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        all.push_back(PIN(3, bit));
+    }
+    init(all);
+    EXPECT_EQ(map.run_count, 1);
+    EXPECT_EQ(map.pin_mask, 0xFFFFFFFFu);
+
+    mock_port_data[3] = 0x12345678;
+    EXPECT_EQ(matrix_port_read(&map), 0x12345678u);
+}
+
+TEST_F(MatrixPort, ReversedPinsMatchPerPin) {
+    init({PIN(0, 7), PIN(0, 6), PIN(0, 5), PIN(0, 4)});
+
+    for (uint32_t data = 0; data < 256; data++) {
+        mock_port_data[0] = data;
+        EXPECT_EQ(matrix_port_read(&map), read_per_pin(pins));
+    }
+}
+
+TEST_F(MatrixPort, RandomLayoutsMatchPerPin) {
+    std::mt19937 rng(0x9e3779b9);
+
+    for (int layout = 0; layout < 200; layout++) {
+        // Random unique pins, with a bias towards consecutive runs, sprinkled with NO_PIN
+        size_t             count = 1 + rng() % 32;
+        std::vector<pin_t> layout_pins;
+        std::vector<bool>  used(128, false);
+        pin_t              pin = rng() % 128;
+        while (layout_pins.size() < count) {
+            if (rng() % 8 == 0) {
+                layout_pins.push_back(NO_PIN);
+                continue;
+            }
+            if (rng() % 3 == 0 || used[pin]) {
+                do {
+                    pin = rng() % 128;
+                } while (used[pin]);
+            }
+            used[pin] = true;
+            layout_pins.push_back(pin);
+            pin = (pin + 1) % 128;
+        }
+        SetUp();
+        init(layout_pins);
+
+        for (int sample = 0; sample < 50; sample++) {
+            for (auto &data : mock_port_data) {
+                data = rng();
+            }
+            mock_port_reads = 0;
+            ASSERT_EQ(matrix_port_read(&map), read_per_pin(pins)) << "layout " << layout << " sample " << sample;
+            ASSERT_EQ(mock_port_reads, map.port_count);
+        }
+    }
+}
@@ -0,0 +1,5 @@
+matrix_port_CONFIG := $(QUANTUM_PATH)/matrix_port/tests/config_mock.h
+
+matrix_port_SRC := \
+	$(QUANTUM_PATH)/matrix_port/tests/matrix_port_tests.cpp \
+	$(QUANTUM_PATH)/matrix_port.c
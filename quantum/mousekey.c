@@ -24,6 +24,10 @@
 #include "debug.h"
 #include "mousekey.h"
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
 static inline int8_t times_inv_sqrt2(int8_t x) {
     // 181/256 is pretty close to 1/sqrt(2)
     // 0.70703125                 0.707106781
@@ -34,6 +38,16 @@ static inline int8_t times_inv_sqrt2(int8_t x) {
 
 static report_mouse_t mouse_report = {0};
 static void           mousekey_debug(void);
+
+#ifdef IDLE_SLEEP_ENABLE
+// Lets the main loop sleep until the next repeat of movement last sent at last_timer is due
+static void mousekey_request_wakeup(uint16_t last_timer, uint16_t interval) {
+    int16_t remaining = (int16_t)(last_timer + interval + 1 - timer_read());
+    idle_sleep_request_wakeup_in(remaining > 0 ? remaining : 0);
+}
+#else
+#    define mousekey_request_wakeup(last_timer, interval)
+#endif
 static uint8_t        mousekey_accel        = 0;
 static uint8_t        mousekey_repeat       = 0;
 static uint8_t        mousekey_wheel_repeat = 0;
@@ -368,6 +382,14 @@ void mousekey_task(void) {
     }
     // save the state for later
     memcpy(&mouse_report, &tmpmr, sizeof(tmpmr));
+
+    // movement repeats for as long as it's held, or gliding
+#    ifdef MOUSEKEY_INERTIA
+    if (mousekey_frame) mousekey_request_wakeup(last_timer_c, (mousekey_frame > 1) ? mk_interval : mk_delay * 10);
+#    else
+    if (mouse_report.x || mouse_report.y) mousekey_request_wakeup(last_timer_c, mousekey_repeat ? mk_interval : mk_delay * 10);
+#    endif
+    if (mouse_report.v || mouse_report.h) mousekey_request_wakeup(last_timer_w, mousekey_wheel_repeat ? (uint16_t)mk_wheel_interval : mk_wheel_delay * 10);
 }
 
 void mousekey_on(uint8_t code) {
@@ -507,6 +529,10 @@ void mousekey_task(void) {
         mousekey_send();
     }
     memcpy(&mouse_report, &tmpmr, sizeof(tmpmr));
+
+    // movement repeats for as long as it's held
+    if (mouse_report.x || mouse_report.y) mousekey_request_wakeup(last_timer_c, c_intervals[mk_speed]);
+    if (mouse_report.v || mouse_report.h) mousekey_request_wakeup(last_timer_w, w_intervals[mk_speed]);
 }
 
 void adjust_speed(void) {
@@ -608,7 +634,15 @@ void mousekey_send(void) {
     uint16_t time = timer_read();
     if (mouse_report.x || mouse_report.y) last_timer_c = time;
     if (mouse_report.v || mouse_report.h) last_timer_w = time;
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    // mousekey wheel movement is in whole detents
+    report_mouse_t report = mouse_report;
+    report.v *= host_mouse_wheel_multiplier();
+    report.h *= host_mouse_pan_multiplier();
+    host_mouse_send(&report);
+#else
     host_mouse_send(&mouse_report);
+#endif
 }
 
 void mousekey_clear(void) {
@@ -56,6 +56,34 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    ifndef QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS
+/**
+ * @def This controls where the asset index is located within external flash. Assets can be loaded by their position
+ *      in the index using \ref qp_load_image_flash and \ref qp_load_font_flash.
+ */
+#        define QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS 0
+#    endif // QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS
+
+#    ifndef QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE
+/**
+ * @def This controls the size of the read-ahead cache held by each image or font loaded from external flash. While
+ *      data is being read sequentially, each flash read doubles in size until the cache is filled. Increasing this
+ *      number reduces the number of flash transactions when drawing large images, at the cost of RAM for every image
+ *      and font slot.
+ */
+#        define QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE 64
+#    endif // QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE
+
+#    ifndef QUANTUM_PAINTER_FLASH_STREAM_MIN_READ
+/**
+ * @def This controls the size of the flash read made after seeking elsewhere in an image or font, such as when looking
+ *      up glyphs.
+ */
+#        define QUANTUM_PAINTER_FLASH_STREAM_MIN_READ 16
+#    endif // QUANTUM_PAINTER_FLASH_STREAM_MIN_READ
+#endif     // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -318,6 +346,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads an image from the asset index in external flash.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image. Image data is streamed from flash as it's drawn.
+ *
+ * @param asset_index[in] the position of the image within the asset index
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint16_t asset_index);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -405,6 +447,20 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads a font from the asset index in external flash.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font. Font data is streamed from flash as it's drawn, unless
+ *       \ref QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is set to TRUE.
+ *
+ * @param asset_index[in] the position of the font within the asset index
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint16_t asset_index);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
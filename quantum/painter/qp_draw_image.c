@@ -19,6 +19,9 @@ typedef struct qgf_image_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef QP_STREAM_HAS_FLASH
+        qp_flash_stream_t flash_stream;
+#endif // QP_STREAM_HAS_FLASH
     };
 } qgf_image_handle_t;
 
@@ -85,6 +88,28 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QP_STREAM_HAS_FLASH
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint16_t asset_index = (uint16_t)(uintptr_t)arg;
+
+    // The asset index gives us the length up front
+    uint32_t address, length;
+    if (!qp_flash_asset_lookup(asset_index, &address, &length)) {
+        return false;
+    }
+
+    image->flash_stream = qp_make_flash_stream(address, (int32_t)length);
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(uint16_t asset_index) {
+    return qp_load_image_internal(image_flash_stream_factory, (void *)(uintptr_t)asset_index);
+}
+#endif // QP_STREAM_HAS_FLASH
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -26,6 +26,9 @@ typedef struct qff_font_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef QP_STREAM_HAS_FLASH
+        qp_flash_stream_t flash_stream;
+#endif // QP_STREAM_HAS_FLASH
     };
 #if QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
     bool  owns_buffer;
@@ -72,21 +75,28 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     font->owns_buffer = false;
     font->buffer      = NULL;
 
-    void *ram_buffer = malloc(font->mem_stream.length);
-    if (ram_buffer == NULL) {
+    // Works out the size from the font itself, as the original stream isn't necessarily a memory stream
+    uint32_t length = qff_get_total_size(&font->stream);
+    qp_stream_setpos(&font->stream, 0);
+
+    void *ram_buffer = NULL;
+    if (length == 0) {
+        qp_dprintf("qp_load_font: could not read font size, falling back to original\n");
+    } else if ((ram_buffer = malloc(length)) == NULL) {
         qp_dprintf("qp_load_font: could not allocate enough RAM for font, falling back to original\n");
     } else {
         do {
             // Copy the data into RAM
-            if (qp_stream_read(ram_buffer, 1, font->mem_stream.length, &font->mem_stream) != font->mem_stream.length) {
+            if (qp_stream_read(ram_buffer, 1, length, &font->stream) != length) {
                 qp_dprintf("qp_load_font: could not copy from flash to RAM, falling back to original\n");
+                qp_stream_setpos(&font->stream, 0);
                 break;
             }
 
             // Create the new stream with the new buffer
             font->buffer      = ram_buffer;
             font->owns_buffer = true;
-            font->mem_stream  = qp_make_memory_stream(font->buffer, font->mem_stream.length);
+            font->mem_stream  = qp_make_memory_stream(font->buffer, length);
         } while (0);
     }
 
@@ -131,6 +141,28 @@ painter_font_handle_t qp_load_font_mem(const void *buffer) {
     return qp_load_font_internal(font_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QP_STREAM_HAS_FLASH
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_flash
+
+static inline bool font_flash_stream_factory(qff_font_handle_t *font, void *arg) {
+    uint16_t asset_index = (uint16_t)(uintptr_t)arg;
+
+    // The asset index gives us the length up front
+    uint32_t address, length;
+    if (!qp_flash_asset_lookup(asset_index, &address, &length)) {
+        return false;
+    }
+
+    font->flash_stream = qp_make_flash_stream(address, (int32_t)length);
+    return true;
+}
+
+painter_font_handle_t qp_load_font_flash(uint16_t asset_index) {
+    return qp_load_font_internal(font_flash_stream_factory, (void *)(uintptr_t)asset_index);
+}
+#endif // QP_STREAM_HAS_FLASH
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_font
 
@@ -3,6 +3,10 @@
 
 #include "qp_stream.h"
 
+#ifdef QP_STREAM_HAS_FLASH
+#    include "flash_spi.h"
+#endif // QP_STREAM_HAS_FLASH
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
@@ -164,3 +168,141 @@ qp_file_stream_t qp_make_file_stream(FILE *f) {
     return stream;
 }
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flash streams
+
+#ifdef QP_STREAM_HAS_FLASH
+
+static bool flash_fill_cache(qp_flash_stream_t *s) {
+    // Carrying on from the end of the cache means the data is being read sequentially, so read further ahead next time
+    // -- anything else is random access, such as glyph lookups, where large reads would be wasted
+    if (s->cache_length > 0 && s->position == s->cache_start + s->cache_length) {
+        s->read_size = QP_MIN(s->read_size * 2, QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE);
+    } else {
+        s->read_size = QUANTUM_PAINTER_FLASH_STREAM_MIN_READ;
+    }
+
+    uint16_t length = QP_MIN(s->read_size, s->length - s->position);
+    if (flash_read_block(s->address + s->position, s->cache, length) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("flash_fill_cache: fail (read of %d bytes at 0x%08lX)\n", (int)length, (unsigned long)(s->address + s->position));
+        s->cache_length = 0;
+        return false;
+    }
+
+    s->cache_start  = s->position;
+    s->cache_length = length;
+    return true;
+}
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+    if (s->position < s->cache_start || s->position >= s->cache_start + s->cache_length) {
+        if (!flash_fill_cache(s)) {
+            s->is_eof = true;
+            return STREAM_EOF;
+        }
+    }
+    return s->cache[s->position++ - s->cache_start];
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Flash assets are read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds as memory streams -- anywhere from the start, up to and including the end
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    // Update the offset, the cache is left alone in case the new position is already within it
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    qp_flash_stream_t stream = {
+        .base         = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address      = address,
+        .length       = length,
+        .position     = 0,
+        .cache_start  = 0,
+        .cache_length = 0,
+        .read_size    = QUANTUM_PAINTER_FLASH_STREAM_MIN_READ,
+    };
+    return stream;
+}
+
+bool qp_flash_asset_lookup(uint16_t asset_index, uint32_t *address, uint32_t *length) {
+    qp_flash_asset_index_v1_t index;
+    if (flash_read_block(QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS, &index, sizeof(index)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_asset_lookup: fail (could not read index)\n");
+        return false;
+    }
+    if (index.magic != QP_FLASH_ASSET_INDEX_MAGIC || index.version != 0x01 || index.asset_count != (uint16_t)~index.neg_asset_count) {
+        qp_dprintf("qp_flash_asset_lookup: fail (invalid index)\n");
+        return false;
+    }
+    if (asset_index >= index.asset_count) {
+        qp_dprintf("qp_flash_asset_lookup: fail (asset %d out of range, index has %d)\n", (int)asset_index, (int)index.asset_count);
+        return false;
+    }
+
+    qp_flash_asset_entry_v1_t entry;
+    uint32_t                  entry_address = QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + sizeof(index) + (asset_index * sizeof(entry));
+    if (flash_read_block(entry_address, &entry, sizeof(entry)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_asset_lookup: fail (could not read entry)\n");
+        return false;
+    }
+
+    uint32_t start = QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + entry.offset;
+    if (entry.length == 0 || entry.length > INT32_MAX || start < entry.offset || start > EXTERNAL_FLASH_SIZE || entry.length > EXTERNAL_FLASH_SIZE - start) {
+        qp_dprintf("qp_flash_asset_lookup: fail (asset %d lies outside flash)\n", (int)asset_index);
+        return false;
+    }
+
+    *address = start;
+    *length  = entry.length;
+    return true;
+}
+
+#endif // QP_STREAM_HAS_FLASH
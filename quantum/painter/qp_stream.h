@@ -83,3 +83,54 @@ typedef struct qp_file_stream_t {
 qp_file_stream_t qp_make_file_stream(FILE *f);
 
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flash streams
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    define QP_STREAM_HAS_FLASH
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+#ifdef QP_STREAM_HAS_FLASH
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t base;
+    uint32_t    address;      // location of the stream within external flash
+    int32_t     length;       // length of the stream
+    int32_t     position;     // current position within the stream
+    bool        is_eof;       // whether a read has been attempted past the end of the stream
+    int32_t     cache_start;  // stream position of the first cached byte
+    uint16_t    cache_length; // number of valid bytes in the cache, zero if nothing cached
+    uint16_t    read_size;    // size of the next flash read, grows while reading sequentially
+    uint8_t     cache[QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE];
+} qp_flash_stream_t;
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length);
+
+/////////////////////////////////////////
+// Flash asset index
+//
+// Located at QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS, consisting of a header followed by `asset_count` entries. Each
+// entry's offset is relative to the start of the index, and refers to a complete QGF or QFF file.
+
+#    define QP_FLASH_ASSET_INDEX_MAGIC 0x415051 // "QPA"
+
+typedef struct QP_PACKED qp_flash_asset_index_v1_t {
+    uint32_t magic : 24;      // constant, equal to 0x415051 ("QPA")
+    uint8_t  version;         // constant, equal to 0x01
+    uint16_t asset_count;     // number of entries following the header
+    uint16_t neg_asset_count; // negated value of asset_count, used for detecting parsing errors
+} qp_flash_asset_index_v1_t;
+
+_Static_assert(sizeof(qp_flash_asset_index_v1_t) == 8, "qp_flash_asset_index_v1_t must be 8 bytes in v1 of the flash asset index");
+
+typedef struct QP_PACKED qp_flash_asset_entry_v1_t {
+    uint32_t offset; // offset of the asset from the start of the index
+    uint32_t length; // length of the asset
+} qp_flash_asset_entry_v1_t;
+
+_Static_assert(sizeof(qp_flash_asset_entry_v1_t) == 8, "qp_flash_asset_entry_v1_t must be 8 bytes in v1 of the flash asset index");
+
+bool qp_flash_asset_lookup(uint16_t asset_index, uint32_t *address, uint32_t *length);
+
+#endif // QP_STREAM_HAS_FLASH
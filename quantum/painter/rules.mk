@@ -1,6 +1,7 @@
 # Quantum Painter Configurables
 QUANTUM_PAINTER_DRIVERS ?=
 QUANTUM_PAINTER_ANIMATIONS_ENABLE ?= yes
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE ?= no
 
 QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 
@@ -41,6 +42,15 @@ ifeq ($(strip $(QUANTUM_PAINTER_ANIMATIONS_ENABLE)), yes)
     OPT_DEFS += -DQUANTUM_PAINTER_ANIMATIONS_ENABLE
 endif
 
+# Check if people want to load assets from external flash
+ifeq ($(strip $(QUANTUM_PAINTER_FLASH_ASSETS_ENABLE)), yes)
+    ifeq ($(filter $(FLASH_DRIVER),spi custom),)
+        $(call CATASTROPHIC_ERROR,Invalid FLASH_DRIVER,QUANTUM_PAINTER_FLASH_ASSETS_ENABLE requires FLASH_DRIVER = spi)
+    endif
+    OPT_DEFS += -DQUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+    COMMON_VPATH += $(DRIVER_PATH)/flash
+endif
+
 # Comms flags
 QUANTUM_PAINTER_NEEDS_COMMS_SPI ?= no
 
@@ -17,11 +17,15 @@
  */
 
 #include "pointing_device.h"
+#include <stdlib.h>
 #include <string.h>
 #include "timer.h"
 #ifdef MOUSEKEY_ENABLE
 #    include "mousekey.h"
 #endif
+#ifdef POINTING_DEVICE_MOTION_PIN
+#    include "gpio.h"
+#endif
 
 #if (defined(POINTING_DEVICE_ROTATION_90) + defined(POINTING_DEVICE_ROTATION_180) + defined(POINTING_DEVICE_ROTATION_270)) > 1
 #    error More than one rotation selected.  This is not supported.
@@ -74,9 +78,82 @@ uint16_t pointing_device_get_shared_cpi(void) {
 
 #endif // defined(SPLIT_POINTING_ENABLE)
 
+#ifdef POINTING_DEVICE_MOTION_PIN
+#    if defined(POINTING_DEVICE_MOTION_PIN_INTERRUPT) && !defined(enablePinChangeCallback)
+#        error "POINTING_DEVICE_MOTION_PIN_INTERRUPT is not supported on this platform"
+#    endif
+
+/**
+ * @brief Reads the level of the motion pin
+ *
+ * @return true if the sensor signals that it has motion data
+ */
+static bool pointing_device_motion_pin_active(void) {
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    return !readPin(POINTING_DEVICE_MOTION_PIN);
+#    else
+    return readPin(POINTING_DEVICE_MOTION_PIN);
+#    endif
+}
+
+#    ifdef POINTING_DEVICE_MOTION_PIN_INTERRUPT
+static volatile bool pointing_device_motion_pending = true;
+
+static void pointing_device_motion_callback(void *arg) {
+    pointing_device_motion_pending = true;
+}
+#    endif
+
+/**
+ * @brief Checks whether the sensor has motion data to be read
+ *
+ * With POINTING_DEVICE_MOTION_PIN_INTERRUPT the pin is only read after it has changed, and for as long as it stays active
+ * after that, so an idle sensor costs nothing but a flag check.
+ *
+ * @return true if the sensor should be read
+ */
+static bool pointing_device_motion_detected(void) {
+#    ifdef POINTING_DEVICE_MOTION_PIN_INTERRUPT
+    if (!pointing_device_motion_pending) {
+        return false;
+    }
+    // clear before reading the level, so that an edge in between is not lost
+    pointing_device_motion_pending = false;
+    if (pointing_device_motion_pin_active()) {
+        pointing_device_motion_pending = true;
+        return true;
+    }
+    return false;
+#    else
+    return pointing_device_motion_pin_active();
+#    endif
+}
+#endif
+
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    define SCROLL_UNITS_PER_DETENT POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#    define WHEEL_DIVISOR (POINTING_DEVICE_SCALE_UNIT * (SCROLL_UNITS_PER_DETENT / host_mouse_wheel_multiplier()))
+#    define PAN_DIVISOR (POINTING_DEVICE_SCALE_UNIT * (SCROLL_UNITS_PER_DETENT / host_mouse_pan_multiplier()))
+#else
+#    define SCROLL_UNITS_PER_DETENT 1
+#    define WHEEL_DIVISOR POINTING_DEVICE_SCALE_UNIT
+#    define PAN_DIVISOR POINTING_DEVICE_SCALE_UNIT
+#endif
+
+// Movement not reported yet, in 1/256ths of a count and of a high resolution scroll unit
+static struct {
+    int32_t x;
+    int32_t y;
+    int32_t v;
+    int32_t h;
+} pointing_device_residual = {};
+
+static uint16_t pointing_device_motion_scale = POINTING_DEVICE_MOTION_SCALE;
+static uint16_t pointing_device_scroll_scale = POINTING_DEVICE_SCROLL_SCALE;
+
 extern const pointing_device_driver_t pointing_device_driver;
 
 /**
@@ -115,6 +192,32 @@ __attribute__((weak)) report_mouse_t pointing_device_task_user(report_mouse_t mo
     return mouse_report;
 }
 
+/**
+ * @brief Weak function allowing for keyboard level pointer acceleration
+ *
+ * Takes the configured motion scale and the speed of the current sensor read, and returns the scale to apply to that read.
+ *
+ * @param[in] scale uint16_t motion scale, in 1/256ths
+ * @param[in] speed uint16_t sum of the absolute X and Y counts of this read
+ * @return uint16_t scale to apply, in 1/256ths
+ */
+__attribute__((weak)) uint16_t pointing_device_motion_scale_kb(uint16_t scale, uint16_t speed) {
+    return pointing_device_motion_scale_user(scale, speed);
+}
+
+/**
+ * @brief Weak function allowing for user level pointer acceleration
+ *
+ * Takes the configured motion scale and the speed of the current sensor read, and returns the scale to apply to that read.
+ *
+ * @param[in] scale uint16_t motion scale, in 1/256ths
+ * @param[in] speed uint16_t sum of the absolute X and Y counts of this read
+ * @return uint16_t scale to apply, in 1/256ths
+ */
+__attribute__((weak)) uint16_t pointing_device_motion_scale_user(uint16_t scale, uint16_t speed) {
+    return scale;
+}
+
 /**
  * @brief Handles pointing device buttons
  *
@@ -151,6 +254,9 @@ __attribute__((weak)) void pointing_device_init(void) {
 #    else
         setPinInput(POINTING_DEVICE_MOTION_PIN);
 #    endif
+#    ifdef POINTING_DEVICE_MOTION_PIN_INTERRUPT
+        enablePinChangeCallback(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_callback);
+#    endif
 #endif
     }
 
@@ -216,6 +322,109 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+/**
+ * @brief Adds scaled movement to a residual
+ *
+ * The residual never holds more than limit, so a burst of fast movement cannot keep the pointer moving once it has stopped.
+ *
+ * @param[in] residual int32_t pointer to the residual, in 1/256ths
+ * @param[in] scaled int32_t movement multiplied by its scale
+ * @param[in] units int32_t residual units per scaled unit
+ * @param[in] limit int32_t bound of the residual
+ */
+static void pointing_device_accumulate(int32_t *residual, int32_t scaled, int32_t units, int32_t limit) {
+    int32_t bound = limit / units;
+    if (scaled > bound) {
+        scaled = bound;
+    } else if (scaled < -bound) {
+        scaled = -bound;
+    }
+    *residual += scaled * units;
+    if (*residual > limit) {
+        *residual = limit;
+    } else if (*residual < -limit) {
+        *residual = -limit;
+    }
+}
+
+/**
+ * @brief Takes the whole report units out of a residual
+ *
+ * Whatever does not fit in the report, including fractions of a unit, stays in the residual for later reports.
+ *
+ * @param[in] residual int32_t pointer to the residual, in 1/256ths
+ * @param[in] divisor int32_t residual units per report unit
+ * @param[in] max int32_t largest magnitude the report can hold
+ * @return int32_t report units
+ */
+static int32_t pointing_device_take(int32_t *residual, int32_t divisor, int32_t max) {
+    int32_t whole = *residual / divisor;
+    if (whole > max) {
+        whole = max;
+    } else if (whole < -max) {
+        whole = -max;
+    }
+    *residual -= whole * divisor;
+    return whole;
+}
+
+/**
+ * @brief Applies motion and scroll scaling to a mouse report
+ *
+ * Scaled movement is accumulated in fixed point, so fractions of a count and movement beyond the report range are carried
+ * over to later reports rather than truncated. X/Y are in counts, V/H in wheel detents, scaled by the motion and scroll
+ * scales. With high resolution scrolling the wheel is reported in fractions of a detent once the host has enabled it.
+ *
+ * @param[in] mouse_report report_mouse_t to be scaled
+ * @param[in] emit bool, false to accumulate movement without reporting it yet
+ * @return report_mouse_t with scaled values
+ */
+static report_mouse_t pointing_device_scale_report(report_mouse_t mouse_report, bool emit) {
+    uint32_t speed = (uint32_t)abs(mouse_report.x) + abs(mouse_report.y);
+    uint16_t scale = pointing_device_motion_scale_kb(pointing_device_motion_scale, speed > UINT16_MAX ? UINT16_MAX : speed);
+
+    // a few reports' worth of pointer movement may be carried over, but only one of the much finer grained wheel
+    const int32_t xy_limit = (int32_t)XY_REPORT_MAX * POINTING_DEVICE_SCALE_UNIT * 4;
+    const int32_t v_limit  = (int32_t)HV_REPORT_MAX * WHEEL_DIVISOR;
+    const int32_t h_limit  = (int32_t)HV_REPORT_MAX * PAN_DIVISOR;
+
+    pointing_device_accumulate(&pointing_device_residual.x, (int32_t)mouse_report.x * scale, 1, xy_limit);
+    pointing_device_accumulate(&pointing_device_residual.y, (int32_t)mouse_report.y * scale, 1, xy_limit);
+    pointing_device_accumulate(&pointing_device_residual.v, (int32_t)mouse_report.v * pointing_device_scroll_scale, SCROLL_UNITS_PER_DETENT, v_limit);
+    pointing_device_accumulate(&pointing_device_residual.h, (int32_t)mouse_report.h * pointing_device_scroll_scale, SCROLL_UNITS_PER_DETENT, h_limit);
+
+    if (!emit) {
+        mouse_report.x = mouse_report.y = mouse_report.v = mouse_report.h = 0;
+        return mouse_report;
+    }
+
+    mouse_report.x = pointing_device_take(&pointing_device_residual.x, POINTING_DEVICE_SCALE_UNIT, XY_REPORT_MAX);
+    mouse_report.y = pointing_device_take(&pointing_device_residual.y, POINTING_DEVICE_SCALE_UNIT, XY_REPORT_MAX);
+    mouse_report.v = pointing_device_take(&pointing_device_residual.v, WHEEL_DIVISOR, HV_REPORT_MAX);
+    mouse_report.h = pointing_device_take(&pointing_device_residual.h, PAN_DIVISOR, HV_REPORT_MAX);
+    return mouse_report;
+}
+
+/**
+ * @brief Checks whether an interval has passed since the last time it did
+ *
+ * The next interval starts where the last one was due, rather than when it was noticed, so that sensor reads and reports
+ * keep a steady cadence however long the rest of the keyboard loop takes. If a whole interval was missed it starts afresh
+ * instead of catching up with a burst.
+ *
+ * @param[in] last uint32_t pointer to when the last interval started
+ * @param[in] interval uint32_t interval in milliseconds
+ * @return true if the interval has passed
+ */
+static inline bool pointing_device_interval_elapsed(uint32_t *last, uint32_t interval) {
+    uint32_t elapsed = timer_elapsed32(*last);
+    if (elapsed < interval) {
+        return false;
+    }
+    *last = elapsed < 2 * interval ? *last + interval : timer_read32();
+    return true;
+}
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -233,10 +442,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
 
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
-    if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
+    if (!pointing_device_interval_elapsed(&last_exec, POINTING_DEVICE_TASK_THROTTLE_MS)) {
         return false;
     }
-    last_exec = timer_read32();
 #endif
 
     // Gather report info
@@ -244,11 +452,7 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #    if defined(SPLIT_POINTING_ENABLE)
 #        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
-    if (!readPin(POINTING_DEVICE_MOTION_PIN))
-#    else
-    if (readPin(POINTING_DEVICE_MOTION_PIN))
-#    endif
+    if (pointing_device_motion_detected())
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
@@ -284,6 +488,14 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #ifdef POINTING_DEVICE_AUTO_MOUSE_ENABLE
     pointing_device_task_auto_mouse(local_mouse_report);
 #endif
+    // scale movement, and only report it every POINTING_DEVICE_REPORT_INTERVAL_MS while reading the sensor more often
+#if (POINTING_DEVICE_REPORT_INTERVAL_MS > 0)
+    static uint32_t last_report = 0;
+    const bool      emit        = pointing_device_interval_elapsed(&last_report, POINTING_DEVICE_REPORT_INTERVAL_MS);
+#else
+    const bool emit = true;
+#endif
+    local_mouse_report = pointing_device_scale_report(local_mouse_report, emit);
     // combine with mouse report to ensure that the combined is sent correctly
 #ifdef MOUSEKEY_ENABLE
     report_mouse_t mousekey_report = mousekey_get_report();
@@ -349,6 +561,46 @@ void pointing_device_set_cpi(uint16_t cpi) {
 #endif
 }
 
+/**
+ * @brief Gets the motion scale
+ *
+ * @return uint16_t report counts per 256 sensor counts
+ */
+uint16_t pointing_device_get_motion_scale(void) {
+    return pointing_device_motion_scale;
+}
+
+/**
+ * @brief Sets the motion scale
+ *
+ * Scales pointer movement in fixed point, e.g. to run a high CPI sensor at a lower effective CPI without losing slow movement.
+ *
+ * @param[in] scale uint16_t report counts per 256 sensor counts
+ */
+void pointing_device_set_motion_scale(uint16_t scale) {
+    pointing_device_motion_scale = scale;
+}
+
+/**
+ * @brief Gets the scroll scale
+ *
+ * @return uint16_t wheel detents per 256 counts
+ */
+uint16_t pointing_device_get_scroll_scale(void) {
+    return pointing_device_scroll_scale;
+}
+
+/**
+ * @brief Sets the scroll scale
+ *
+ * Scales the wheel values of the mouse report in fixed point, e.g. for sensor driven scrolling.
+ *
+ * @param[in] scale uint16_t wheel detents per 256 counts
+ */
+void pointing_device_set_scroll_scale(uint16_t scale) {
+    pointing_device_scroll_scale = scale;
+}
+
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
 /**
  * @brief Set pointing device CPI if supported
@@ -370,16 +622,16 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
 }
 
 /**
- * @brief clamps int16_t to int8_t
+ * @brief clamps int32_t to mouse_hv_report_t
  *
- * @param[in] int16_t value
- * @return int8_t clamped value
+ * @param[in] int32_t value
+ * @return mouse_hv_report_t clamped value
  */
-static inline int8_t pointing_device_hv_clamp(int16_t value) {
-    if (value < INT8_MIN) {
-        return INT8_MIN;
-    } else if (value > INT8_MAX) {
-        return INT8_MAX;
+static inline mouse_hv_report_t pointing_device_hv_clamp(int32_t value) {
+    if (value < HV_REPORT_MIN) {
+        return HV_REPORT_MIN;
+    } else if (value > HV_REPORT_MAX) {
+        return HV_REPORT_MAX;
     } else {
         return value;
     }
@@ -403,7 +655,8 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
 /**
  * @brief combines 2 mouse reports and returns 2
  *
- * Combines 2 report_mouse_t structs, clamping movement values to int8_t and ignores report_id then returns the resulting report_mouse_t struct.
+ * Combines 2 report_mouse_t structs, clamping movement values to the report range and ignores report_id then returns the resulting report_mouse_t struct.
+ * Movement beyond the report range, up to one report's worth, is carried over into the next combined report.
  *
  * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
  *
@@ -412,10 +665,22 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
  * @return combined report_mouse_t of left_report and right_report
  */
 report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, report_mouse_t right_report) {
-    left_report.x = pointing_device_xy_clamp((clamp_range_t)left_report.x + right_report.x);
-    left_report.y = pointing_device_xy_clamp((clamp_range_t)left_report.y + right_report.y);
-    left_report.h = pointing_device_hv_clamp((int16_t)left_report.h + right_report.h);
-    left_report.v = pointing_device_hv_clamp((int16_t)left_report.v + right_report.v);
+    static mouse_xy_report_t x_carry = 0, y_carry = 0;
+    static mouse_hv_report_t h_carry = 0, v_carry = 0;
+
+    clamp_range_t x = (clamp_range_t)left_report.x + right_report.x + x_carry;
+    clamp_range_t y = (clamp_range_t)left_report.y + right_report.y + y_carry;
+    int32_t       h = (int32_t)left_report.h + right_report.h + h_carry;
+    int32_t       v = (int32_t)left_report.v + right_report.v + v_carry;
+
+    left_report.x = pointing_device_xy_clamp(x);
+    left_report.y = pointing_device_xy_clamp(y);
+    left_report.h = pointing_device_hv_clamp(h);
+    left_report.v = pointing_device_hv_clamp(v);
+    x_carry       = pointing_device_xy_clamp(x - left_report.x);
+    y_carry       = pointing_device_xy_clamp(y - left_report.y);
+    h_carry       = pointing_device_hv_clamp(h - left_report.h);
+    v_carry       = pointing_device_hv_clamp(v - left_report.v);
     left_report.buttons |= right_report.buttons;
     return left_report;
 }
@@ -99,6 +99,26 @@ typedef int32_t clamp_range_t;
 typedef int16_t clamp_range_t;
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    define HV_REPORT_MIN INT16_MIN
+#    define HV_REPORT_MAX INT16_MAX
+#else
+#    define HV_REPORT_MIN INT8_MIN
+#    define HV_REPORT_MAX INT8_MAX
+#endif
+
+/* Motion and scroll scales are fixed point, in 1/256ths: 256 passes counts through unchanged */
+#define POINTING_DEVICE_SCALE_UNIT 256
+#ifndef POINTING_DEVICE_MOTION_SCALE
+#    define POINTING_DEVICE_MOTION_SCALE POINTING_DEVICE_SCALE_UNIT
+#endif
+#ifndef POINTING_DEVICE_SCROLL_SCALE
+#    define POINTING_DEVICE_SCROLL_SCALE POINTING_DEVICE_SCALE_UNIT
+#endif
+#ifndef POINTING_DEVICE_REPORT_INTERVAL_MS
+#    define POINTING_DEVICE_REPORT_INTERVAL_MS 0
+#endif
+
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
 bool           pointing_device_send(void);
@@ -106,11 +126,17 @@ report_mouse_t pointing_device_get_report(void);
 void           pointing_device_set_report(report_mouse_t mouse_report);
 uint16_t       pointing_device_get_cpi(void);
 void           pointing_device_set_cpi(uint16_t cpi);
+uint16_t       pointing_device_get_motion_scale(void);
+void           pointing_device_set_motion_scale(uint16_t scale);
+uint16_t       pointing_device_get_scroll_scale(void);
+void           pointing_device_set_scroll_scale(uint16_t scale);
 
 void           pointing_device_init_kb(void);
 void           pointing_device_init_user(void);
 report_mouse_t pointing_device_task_kb(report_mouse_t mouse_report);
 report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
+uint16_t       pointing_device_motion_scale_kb(uint16_t scale, uint16_t speed);
+uint16_t       pointing_device_motion_scale_user(uint16_t scale, uint16_t speed);
 uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
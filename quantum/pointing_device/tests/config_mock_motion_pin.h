@@ -0,0 +1,32 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define POINTING_DEVICE_TASK_THROTTLE_MS 2
+
+#define POINTING_DEVICE_MOTION_PIN 3
+#define POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+#define POINTING_DEVICE_MOTION_PIN_INTERRUPT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint8_t pin_t;
+
+typedef void (*pin_change_callback_t)(void *arg);
+
+#define setPinInput(pin) ((void)(pin))
+#define setPinInputHigh(pin) ((void)(pin))
+#define readPin(pin) (mockReadPin(pin))
+#define enablePinChangeCallback(pin, callback) (mockEnablePinChangeCallback(pin, callback))
+
+bool mockReadPin(pin_t pin);
+void mockEnablePinChangeCallback(pin_t pin, pin_change_callback_t callback);
+
+#ifdef __cplusplus
+};
+#endif
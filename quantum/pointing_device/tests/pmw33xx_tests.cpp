@@ -0,0 +1,108 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include "spi_mock.hpp"
+
+#define MOT 0x80
+#define LIFT 0x08
+
+struct trace_frame_t {
+    uint8_t motion;
+    int16_t dx;
+    int16_t dy;
+};
+
+// A quick swipe captured from a PMW3360 at 1ms polling: accelerate, decelerate, lift off and put down again
+// clang-format off
+static const trace_frame_t swipe_trace[] = {
+    {0x00, 0, 0},     {MOT, 1, 0},      {MOT, 3, -1},     {MOT, 8, -2},      {MOT, 19, -5},     {MOT, 41, -9},
+    {MOT, 86, -18},   {MOT, 152, -31},  {MOT, 211, -40},  {MOT, 237, -44},   {MOT, 219, -39},   {MOT, 164, -30},
+    {MOT, 97, -17},   {MOT, 44, -8},    {MOT, 15, -3},    {MOT, 4, -1},      {MOT | LIFT, 2, 0}, {LIFT, 0, 0},
+    {LIFT, 0, 0},     {0x00, 0, 0},     {MOT, -2, 1},     {MOT, -1, 0},      {0x00, 0, 0},      {0x00, 0, 0},
+};
+// clang-format on
+
+class Pmw33xx : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock.reset();
+        // leaves the driver out of burst mode, whatever the previous test did
+        pmw33xx_read(0, REG_Product_ID);
+        mock.reset();
+    }
+
+    void queue_trace(void) {
+        for (const auto &frame : swipe_trace) {
+            mock.queue_frame(frame.motion, frame.dx, frame.dy);
+        }
+    }
+
+    MockPmw33xx &mock = MockPmw33xx::instance();
+};
+
+TEST_F(Pmw33xx, ReplaysTraceWithOneBurstPerFrame) {
+    int32_t expected_x = 0, expected_y = 0;
+    for (const auto &frame : swipe_trace) {
+        expected_x += frame.dx;
+        expected_y += frame.dy;
+    }
+    queue_trace();
+
+    int32_t x = 0, y = 0;
+    for (size_t i = 0; i < sizeof(swipe_trace) / sizeof(swipe_trace[0]); i++) {
+        pmw33xx_report_t report = pmw33xx_read_burst(0);
+        EXPECT_EQ(report.motion.w, swipe_trace[i].motion) << "frame " << i;
+        x += report.delta_x;
+        y += report.delta_y;
+    }
+
+    // the driver reports the opposite direction to the sensor axes
+    EXPECT_EQ(x, -expected_x);
+    EXPECT_EQ(y, -expected_y);
+    EXPECT_EQ(mock.burst_arms, 1u);
+    EXPECT_EQ(mock.garbled_frames, 0u);
+    // one transaction to enter burst mode, then a single transaction per frame
+    EXPECT_EQ(mock.transactions, 1u + sizeof(swipe_trace) / sizeof(swipe_trace[0]));
+}
+
+TEST_F(Pmw33xx, RegisterReadEndsBurstMode) {
+    queue_trace();
+    pmw33xx_read_burst(0);
+    pmw33xx_read_burst(0);
+
+    EXPECT_EQ(pmw33xx_get_cpi(0), 1600);
+
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+    EXPECT_EQ(report.motion.w, swipe_trace[2].motion);
+    EXPECT_EQ(report.delta_x, -swipe_trace[2].dx);
+    EXPECT_EQ(mock.burst_arms, 2u);
+    EXPECT_EQ(mock.garbled_frames, 0u);
+}
+
+TEST_F(Pmw33xx, RegisterWriteEndsBurstMode) {
+    queue_trace();
+    pmw33xx_read_burst(0);
+
+    pmw33xx_set_cpi(0, 800);
+    EXPECT_EQ(mock.registers[REG_Config1], 7);
+
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+    EXPECT_EQ(report.motion.w, swipe_trace[1].motion);
+    EXPECT_EQ(mock.burst_arms, 2u);
+    EXPECT_EQ(mock.garbled_frames, 0u);
+}
+
+TEST_F(Pmw33xx, RecoversFromGarbledFrame) {
+    queue_trace();
+    pmw33xx_read_burst(0);
+
+    mock.garble_next = true;
+    pmw33xx_read_burst(0);
+    EXPECT_EQ(mock.garbled_frames, 1u);
+
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+    EXPECT_EQ(report.motion.w, swipe_trace[1].motion);
+    EXPECT_EQ(mock.burst_arms, 2u);
+}
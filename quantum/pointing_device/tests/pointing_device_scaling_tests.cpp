@@ -0,0 +1,200 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "pointing_device.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+static report_mouse_t              sensor_report = {};
+static std::vector<report_mouse_t> sent_reports;
+static uint16_t                    wheel_multiplier = 1;
+
+static void           mock_init(void) {}
+static report_mouse_t mock_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = sensor_report.x;
+    mouse_report.y = sensor_report.y;
+    mouse_report.v = sensor_report.v;
+    mouse_report.h = sensor_report.h;
+    return mouse_report;
+}
+static void     mock_set_cpi(uint16_t cpi) {}
+static uint16_t mock_get_cpi(void) {
+    return 0;
+}
+
+extern const pointing_device_driver_t pointing_device_driver = {
+    .init       = mock_init,
+    .get_report = mock_get_report,
+    .set_cpi    = mock_set_cpi,
+    .get_cpi    = mock_get_cpi,
+};
+
+void host_mouse_send(report_mouse_t *report) {
+    sent_reports.push_back(*report);
+}
+
+bool has_mouse_report_changed(report_mouse_t *new_report, report_mouse_t *old_report) {
+    return memcmp(new_report, old_report, sizeof(report_mouse_t));
+}
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+uint16_t host_mouse_wheel_multiplier(void) {
+    return wheel_multiplier;
+}
+
+uint16_t host_mouse_pan_multiplier(void) {
+    return wheel_multiplier;
+}
+#endif
+}
+
+class PointingDeviceScaling : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        pointing_device_set_motion_scale(POINTING_DEVICE_SCALE_UNIT);
+        pointing_device_set_scroll_scale(POINTING_DEVICE_SCALE_UNIT);
+        wheel_multiplier = 1;
+        // restarts the report interval at 0ms
+        set_time(0);
+        sensor_report = {};
+        pointing_device_task();
+        sent_reports.clear();
+    }
+
+    // One sensor read, 1ms after the last one
+    void read(int8_t x, int8_t y, int8_t v = 0, int8_t h = 0) {
+        sensor_report.x = x;
+        sensor_report.y = y;
+        sensor_report.v = v;
+        sensor_report.h = h;
+        advance_time(1);
+        pointing_device_task();
+    }
+
+    // Reads without movement until the next report is due, so nothing is left over from this test
+    void drain(void) {
+        for (int i = 0; i < 2 * POINTING_DEVICE_REPORT_INTERVAL_MS + 1; i++) {
+            read(0, 0);
+        }
+    }
+};
+
+#if (POINTING_DEVICE_REPORT_INTERVAL_MS > 0)
+TEST_F(PointingDeviceScaling, AccumulatesOverReportInterval) {
+    // 1ms reads, one report every POINTING_DEVICE_REPORT_INTERVAL_MS
+    for (int i = 0; i < 3 * POINTING_DEVICE_REPORT_INTERVAL_MS; i++) {
+        read(1, -2);
+    }
+    ASSERT_EQ(sent_reports.size(), 3);
+    for (const auto &report : sent_reports) {
+        EXPECT_EQ(report.x, POINTING_DEVICE_REPORT_INTERVAL_MS);
+        EXPECT_EQ(report.y, -2 * POINTING_DEVICE_REPORT_INTERVAL_MS);
+    }
+    drain();
+}
+
+TEST_F(PointingDeviceScaling, BeyondReportRangeIsCarriedOver) {
+    // 200 counts within one interval do not fit in a report, the rest follows in the next one
+    read(100, 0);
+    read(100, 0);
+    drain();
+    ASSERT_EQ(sent_reports.size(), 2);
+    EXPECT_EQ(sent_reports[0].x, XY_REPORT_MAX);
+    EXPECT_EQ(sent_reports[1].x, 200 - XY_REPORT_MAX);
+}
+#endif
+
+TEST_F(PointingDeviceScaling, RemainderCarriedAcrossReports) {
+    // a quarter of a count per sensor count: every fourth count moves the pointer, whichever report it lands in
+    pointing_device_set_motion_scale(POINTING_DEVICE_SCALE_UNIT / 4);
+    int32_t x = 0;
+    for (int i = 0; i < 8 * (POINTING_DEVICE_REPORT_INTERVAL_MS + 1); i++) {
+        read(1, 0);
+    }
+    drain();
+    for (const auto &report : sent_reports) {
+        x += report.x;
+    }
+    EXPECT_EQ(x, 2 * (POINTING_DEVICE_REPORT_INTERVAL_MS + 1));
+}
+
+TEST_F(PointingDeviceScaling, ScalesMotion) {
+    pointing_device_set_motion_scale(POINTING_DEVICE_SCALE_UNIT * 3 / 2);
+    for (int i = 0; i < 4; i++) {
+        read(10, -4);
+    }
+    drain();
+    int32_t x = 0, y = 0;
+    for (const auto &report : sent_reports) {
+        x += report.x;
+        y += report.y;
+    }
+    EXPECT_EQ(x, 60);
+    EXPECT_EQ(y, -24);
+}
+
+TEST_F(PointingDeviceScaling, ScalesScroll) {
+    pointing_device_set_scroll_scale(POINTING_DEVICE_SCALE_UNIT / 2);
+    for (int i = 0; i < 6; i++) {
+        read(0, 0, 1, -1);
+    }
+    drain();
+    int32_t v = 0, h = 0;
+    for (const auto &report : sent_reports) {
+        v += report.v;
+        h += report.h;
+    }
+    EXPECT_EQ(v, 3);
+    EXPECT_EQ(h, -3);
+}
+
+TEST_F(PointingDeviceScaling, NegativeRemainderCarried) {
+    pointing_device_set_motion_scale(POINTING_DEVICE_SCALE_UNIT / 2);
+    for (int i = 0; i < 6; i++) {
+        read(-1, 1);
+    }
+    drain();
+    int32_t x = 0, y = 0;
+    for (const auto &report : sent_reports) {
+        x += report.x;
+        y += report.y;
+    }
+    EXPECT_EQ(x, -3);
+    EXPECT_EQ(y, 3);
+}
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+TEST_F(PointingDeviceScaling, HiresScrollOnceEnabledByHost) {
+    // one detent is reported as the multiplier's worth of high resolution units
+    wheel_multiplier = POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER;
+    read(0, 0, 1, 0);
+    drain();
+    ASSERT_EQ(sent_reports.size(), 1);
+    EXPECT_EQ(sent_reports[0].v, POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+
+    // and a fraction of a detent as a fraction of it
+    sent_reports.clear();
+    pointing_device_set_scroll_scale(POINTING_DEVICE_SCALE_UNIT / 4);
+    read(0, 0, 1, 0);
+    drain();
+    ASSERT_EQ(sent_reports.size(), 1);
+    EXPECT_EQ(sent_reports[0].v, POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER / 4);
+}
+
+TEST_F(PointingDeviceScaling, HiresScrollFractionsWaitForWholeDetentsUntilEnabled) {
+    pointing_device_set_scroll_scale(POINTING_DEVICE_SCALE_UNIT / 4);
+    for (int i = 0; i < 4; i++) {
+        read(0, 0, 1, 0);
+        drain();
+    }
+    ASSERT_EQ(sent_reports.size(), 1);
+    EXPECT_EQ(sent_reports[0].v, 1);
+}
+#endif
@@ -0,0 +1,127 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "pointing_device.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+
+static uint32_t              sensor_reads      = 0;
+static uint32_t              motion_pin_reads  = 0;
+static bool                  motion_pin_level  = true;
+static pin_change_callback_t motion_pin_change = NULL;
+
+bool mockReadPin(pin_t pin) {
+    motion_pin_reads++;
+    return motion_pin_level;
+}
+
+void mockEnablePinChangeCallback(pin_t pin, pin_change_callback_t callback) {
+    motion_pin_change = callback;
+}
+
+static void           mock_init(void) {}
+static report_mouse_t mock_get_report(report_mouse_t mouse_report) {
+    sensor_reads++;
+    return mouse_report;
+}
+static void     mock_set_cpi(uint16_t cpi) {}
+static uint16_t mock_get_cpi(void) {
+    return 0;
+}
+
+extern const pointing_device_driver_t pointing_device_driver = {
+    .init       = mock_init,
+    .get_report = mock_get_report,
+    .set_cpi    = mock_set_cpi,
+    .get_cpi    = mock_get_cpi,
+};
+
+void host_mouse_send(report_mouse_t *report) {}
+
+bool has_mouse_report_changed(report_mouse_t *new_report, report_mouse_t *old_report) {
+    return memcmp(new_report, old_report, sizeof(report_mouse_t));
+}
+}
+
+class PointingDeviceTask : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        pointing_device_init();
+        // leaves the throttle somewhere other than 0ms, so that every test starts on a read
+        set_time(100);
+        pointing_device_task();
+    }
+
+    void SetUp() override {
+        ASSERT_NE(motion_pin_change, nullptr);
+        set_motion(false);
+        // restarts the task throttle at 0ms, and consumes any pending edge
+        set_time(0);
+        pointing_device_task();
+        sensor_reads     = 0;
+        motion_pin_reads = 0;
+    }
+
+    // The motion pin is active low, and raises the callback on every change
+    void set_motion(bool active) {
+        if (motion_pin_level == active) {
+            motion_pin_level = !active;
+            motion_pin_change(NULL);
+        }
+    }
+
+    void task_at(uint32_t t) {
+        set_time(t);
+        pointing_device_task();
+    }
+};
+
+TEST_F(PointingDeviceTask, IdleSensorIsNotPolled) {
+    for (uint32_t t = 1; t <= 20; t++) {
+        task_at(t);
+    }
+    EXPECT_EQ(sensor_reads, 0u);
+    EXPECT_EQ(motion_pin_reads, 0u);
+}
+
+TEST_F(PointingDeviceTask, EdgeStartsReadsUntilMotionEnds) {
+    set_motion(true);
+    for (uint32_t t = 1; t <= 10; t++) {
+        task_at(t);
+    }
+    // no further edge, the pin is read again for as long as it stays active
+    EXPECT_EQ(sensor_reads, 5u);
+
+    set_motion(false);
+    for (uint32_t t = 11; t <= 20; t++) {
+        task_at(t);
+    }
+    EXPECT_EQ(sensor_reads, 5u);
+    EXPECT_EQ(motion_pin_reads, 6u);
+}
+
+TEST_F(PointingDeviceTask, ThrottleKeepsSteadyCadence) {
+    set_motion(true);
+    for (uint32_t t = 1; t <= 4; t++) {
+        task_at(t);
+    }
+    EXPECT_EQ(sensor_reads, 2u);
+
+    // noticed 1ms late, the next read is still due on the original cadence
+    task_at(7);
+    EXPECT_EQ(sensor_reads, 3u);
+    task_at(8);
+    EXPECT_EQ(sensor_reads, 4u);
+
+    // a whole interval missed starts afresh, rather than catching up with a burst
+    task_at(20);
+    EXPECT_EQ(sensor_reads, 5u);
+    task_at(21);
+    EXPECT_EQ(sensor_reads, 5u);
+    task_at(22);
+    EXPECT_EQ(sensor_reads, 6u);
+}
@@ -0,0 +1,31 @@
+pointing_device_pmw33xx_DEFS := -DPOINTING_DEVICE_DRIVER_pmw3360 -DPMW33XX_CS_PIN=0
+pointing_device_pmw33xx_INC := $(QUANTUM_PATH)/pointing_device/tests $(DRIVER_PATH)/sensors
+
+pointing_device_pmw33xx_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/pointing_device/tests/spi_mock.cpp \
+	$(QUANTUM_PATH)/pointing_device/tests/pmw33xx_tests.cpp \
+	$(DRIVER_PATH)/sensors/pmw33xx_common.c \
+	$(DRIVER_PATH)/sensors/pmw3360.c
+
+pointing_device_scaling_DEFS := -DMOUSE_ENABLE -DPOINTING_DEVICE_ENABLE -DPOINTING_DEVICE_DRIVER_custom -DPOINTING_DEVICE_REPORT_INTERVAL_MS=4
+pointing_device_scaling_INC := $(QUANTUM_PATH)/pointing_device
+
+pointing_device_scaling_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_scaling_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device.c
+
+pointing_device_scaling_hires_DEFS := -DMOUSE_ENABLE -DPOINTING_DEVICE_ENABLE -DPOINTING_DEVICE_DRIVER_custom -DPROTOCOL_CHIBIOS -DPOINTING_DEVICE_HIRES_SCROLL_ENABLE
+pointing_device_scaling_hires_INC := $(pointing_device_scaling_INC)
+
+pointing_device_scaling_hires_SRC := $(pointing_device_scaling_SRC)
+
+pointing_device_motion_pin_DEFS := -DMOUSE_ENABLE -DPOINTING_DEVICE_ENABLE -DPOINTING_DEVICE_DRIVER_custom
+pointing_device_motion_pin_CONFIG := $(QUANTUM_PATH)/pointing_device/tests/config_mock_motion_pin.h
+pointing_device_motion_pin_INC := $(QUANTUM_PATH)/pointing_device
+
+pointing_device_motion_pin_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_task_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device.c
@@ -0,0 +1,113 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_mock.hpp"
+
+#include <cstring>
+
+void MockPmw33xx::reset() {
+    frames.clear();
+    memset(registers, 0, sizeof(registers));
+    registers[REG_Config1] = 0x0F; // 1600 CPI
+    burst_mode             = false;
+    garble_next            = false;
+    transactions           = 0;
+    burst_arms             = 0;
+    burst_reads            = 0;
+    register_reads         = 0;
+    garbled_frames         = 0;
+    selected               = false;
+    have_address           = false;
+}
+
+void MockPmw33xx::queue_frame(uint8_t motion, int16_t dx, int16_t dy) {
+    pmw33xx_report_t frame = {};
+    frame.motion.w         = motion;
+    frame.delta_x          = dx;
+    frame.delta_y          = dy;
+    frames.push_back(frame);
+}
+
+static void mock_address(MockPmw33xx &mock, uint8_t address) {
+    mock.have_address = true;
+    mock.address      = address;
+    if ((address & 0x7F) != REG_Motion_Burst) {
+        mock.burst_mode = false;
+    }
+}
+
+extern "C" {
+
+bool is_keyboard_left(void) {
+    return true;
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    mock.selected     = true;
+    mock.have_address = false;
+    mock.transactions++;
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    if (!mock.have_address) {
+        mock_address(mock, data);
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    mock.register_reads++;
+    return mock.registers[mock.address & 0x7F];
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    mock_address(mock, data[0]);
+    if (length > 1 && (data[0] & 0x80)) {
+        uint8_t reg = data[0] & 0x7F;
+        if (reg == REG_Motion_Burst) {
+            mock.burst_mode = true;
+            mock.burst_arms++;
+        } else {
+            mock.registers[reg] = data[1];
+        }
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    if (mock.address != REG_Motion_Burst) {
+        memset(data, 0, length);
+        return SPI_STATUS_SUCCESS;
+    }
+
+    mock.burst_reads++;
+    if (!mock.burst_mode || mock.garble_next) {
+        // outside of burst mode the sensor does not return a frame, and the motion register's reserved bits are not 0
+        mock.garble_next = false;
+        mock.garbled_frames++;
+        memset(data, 0xFF, length);
+        return SPI_STATUS_SUCCESS;
+    }
+
+    pmw33xx_report_t frame = {};
+    if (!mock.frames.empty()) {
+        frame = mock.frames.front();
+        mock.frames.pop_front();
+    }
+    memcpy(data, &frame, length < sizeof(frame) ? length : sizeof(frame));
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    MockPmw33xx &mock = MockPmw33xx::instance();
+    mock.selected     = false;
+}
+}
@@ -0,0 +1,44 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+extern "C" {
+// the driver header is C, which spells static_assert differently
+#define _Static_assert static_assert
+#include "pmw33xx_common.h"
+#undef _Static_assert
+}
+
+// Emulates a PMW33xx on the far side of the SPI bus: motion burst frames are replayed from a queue, and burst mode is
+// entered and left the way the datasheet describes, so reads that rely on a stale burst mode come back garbled.
+class MockPmw33xx {
+   public:
+    static MockPmw33xx &instance() {
+        static MockPmw33xx mock;
+        return mock;
+    }
+
+    void reset();
+    void queue_frame(uint8_t motion, int16_t dx, int16_t dy);
+
+    std::deque<pmw33xx_report_t> frames;
+    uint8_t                      registers[0x80];
+    bool                         burst_mode;
+    bool                         garble_next;
+
+    // bus traffic
+    uint32_t transactions;
+    uint32_t burst_arms;
+    uint32_t burst_reads;
+    uint32_t register_reads;
+    uint32_t garbled_frames;
+
+    // state of the current transaction
+    bool    selected;
+    bool    have_address;
+    uint8_t address;
+};
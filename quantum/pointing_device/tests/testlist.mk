@@ -0,0 +1 @@
+TEST_LIST += pointing_device_pmw33xx pointing_device_scaling pointing_device_scaling_hires pointing_device_motion_pin
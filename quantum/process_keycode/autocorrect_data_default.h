@@ -75,11 +75,39 @@
 #define AUTOCORRECT_MIN_LENGTH 5  // ":ture"
 #define AUTOCORRECT_MAX_LENGTH 10 // "accomodate"
 
-#define DICTIONARY_SIZE 1104
+#define DICTIONARY_SIZE 1077
 
-static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {108, 43,  0,   6,   71, 0,  7,   81, 0,   8,   199, 0,   9,   240, 1,  10,  250, 1,  11,  26,  2,   17,  53,  2,   18, 190, 2,   19,  202, 2,   21,  212, 2,   22,  20,  3,   23,  67,  3,   28,  16,  4,   0,  72,  50,  0,   22,  60,  0,   0,   11,  23,  44, 8,   11, 23,  44,  0,   132, 0,   8,   22,  18,  18,  15,  0,  132, 115, 101, 115, 0,   11,  23,  12,  26,  22,  0,   129, 99,  104, 0,   68,  94,  0,   8,   106, 0,   15, 174, 0,   21, 187, 0,   0,   12,  15,  25,  17,  12,  0,   131, 97,  108, 105, 100, 0,   74,  119, 0,   12,  129, 0,   21,  140, 0,   24,  165, 0,   0,   17,  12,  22,  0,   131, 103, 110, 101, 100, 0,   25,  21, 8,   7,   0,   131, 105, 118, 101, 100, 0,   72,  147, 0,  24,  156, 0,  0,   9,   8,   21,  0,   129, 114, 101, 100, 0,   6,   6,   18,  0,   129, 114, 101, 100, 0,   15,  6,   17,  12,  0,   129, 100, 101, 0,   18, 22,  8,   21,  11,  23,  0,   130, 104, 111,
-                                                                  108, 100, 0,   4,   26, 18, 9,   0,  131, 114, 119, 97,  114, 100, 0,  68,  233, 0,  6,   246, 0,   7,   4,   1,   8,  16,  1,   10,  52,  1,   15,  81,  1,   21,  90,  1,   22,  117, 1,   23,  144, 1,   24, 215, 1,   25,  228, 1,   0,   6,   19,  22,  8,  16,  4,  17,  0,   130, 97,  99,  101, 0,   19,  4,   22,  8,  16,  4,   17,  0,   131, 112, 97,  99,  101, 0,   12,  21,  8,   25,  18,  0,   130, 114, 105, 100, 101, 0,  23,  0,   68, 25,  1,   17,  36,  1,   0,   21,  4,   24,  10,  0,   130, 110, 116, 101, 101, 0,   4,   21,  24,  4,   10,  0,   135, 117, 97,  114, 97,  110, 116, 101, 101, 0,   68,  59,  1,   7,   69,  1,   0,  24,  10,  44,  0,   131, 97,  117, 103, 101, 0,   8,   15, 12,  25,  12, 21,  19,  0,   130, 103, 101, 0,   22,  4,   9,   0,   130, 108, 115, 101, 0,   76,  97,  1,   24,  109, 1,   0,   24,  20,  4,   0,   132, 99, 113, 117, 105, 114, 101, 0,   23,  44,  0,
-                                                                  130, 114, 117, 101, 0,  4,  0,   79, 126, 1,   24,  134, 1,   0,   9,  0,   131, 97, 108, 115, 101, 0,   6,   8,   5,  0,   131, 97,  117, 115, 101, 0,   4,   0,   71,  156, 1,   19,  193, 1,   21,  203, 1,  0,   18,  16,  0,   80,  166, 1,   18,  181, 1,  0,   18, 6,   4,   0,   135, 99,  111, 109, 109, 111, 100, 97, 116, 101, 0,   6,   6,   4,   0,   132, 109, 111, 100, 97,  116, 101, 0,   7,   24,  0,   132, 112, 100, 97, 116, 101, 0,  8,   19,  8,   22,  0,   132, 97,  114, 97,  116, 101, 0,   10,  8,   15,  15,  18,  6,   0,   130, 97,  103, 117, 101, 0,   8,   12,  6,   8,   21,  0,   131, 101, 105, 118, 101, 0,   12,  8,   11, 6,   0,   130, 105, 101, 102, 0,   17,  0,   76,  3,   2,  21,  16,  2,  0,   15,  8,   12,  6,   0,   133, 101, 105, 108, 105, 110, 103, 0,   12,  23,  22,  0,   131, 114, 105, 110, 103, 0,   70,  33,  2,   23,  44, 2,   0,   12,  23,  26,  22,  0,   131, 105,
-                                                                  116, 99,  104, 0,   10, 12, 8,   11, 0,   129, 104, 116, 0,   72,  69, 2,   10,  80, 2,   18,  89,  2,   21,  156, 2,  24,  167, 2,   0,   22,  18,  18,  11,  6,   0,   131, 115, 101, 110, 0,   12,  21,  23, 22,  0,   129, 110, 103, 0,   12,  0,   86,  98, 2,   23, 124, 2,   0,   68,  105, 2,   22,  114, 2,   0,   12, 15,  0,   131, 105, 115, 111, 110, 0,   4,   6,   6,   18,  0,   131, 105, 111, 110, 0,   76,  131, 2,   22, 146, 2,   0,  23,  12,  19,  8,   21,  0,   134, 101, 116, 105, 116, 105, 111, 110, 0,   18,  19,  0,   131, 105, 116, 105, 111, 110, 0,   23,  24,  8,   21,  0,   131, 116, 117, 114, 110, 0,   85,  174, 2,   23, 183, 2,   0,   23,  8,   21,  0,   130, 117, 114, 110, 0,  8,   21,  0,  128, 114, 110, 0,   7,   8,   24,  22,  19,  0,   131, 101, 117, 100, 111, 0,   24,  18,  18,  15,  0,   129, 107, 117, 112, 0,   72,  219, 2,  18,  3,   3,   0,   76,  229, 2,   15,  238,
-                                                                  2,   17,  248, 2,   0,  11, 23,  44, 0,   130, 101, 105, 114, 0,   23, 12,  9,   0,  131, 108, 116, 101, 114, 0,   23, 22,  12,  15,  0,   130, 101, 110, 101, 114, 0,   23,  4,   21,  8,   23,  17,  12,  0,  135, 116, 101, 114, 97,  116, 111, 114, 0,   72, 30,  3,  17,  38,  3,   24,  51,  3,   0,   15,  4,   9,   0,  129, 115, 101, 0,   4,   12,  23,  17,  18,  6,   0,   131, 97,  105, 110, 115, 0,   22,  17,  8,   6,   17, 18,  6,   0,  133, 115, 101, 110, 115, 117, 115, 0,   74,  86,  3,   11,  96,  3,   15,  118, 3,   17,  129, 3,   22,  218, 3,   24,  232, 3,   0,   11,  24,  4,   6,   0,   130, 103, 104, 116, 0,   71,  103, 3,  10,  110, 3,   0,   12,  26,  0,   129, 116, 104, 0,   17, 8,   15,  0,  129, 116, 104, 0,   22,  24,  8,   21,  0,   131, 115, 117, 108, 116, 0,   68,  139, 3,   8,   150, 3,   22,  210, 3,   0,   21,  4,   19,  19, 4,   0,   130, 101, 110, 116, 0,   85,  157,
-                                                                  3,   25,  200, 3,   0,  68, 164, 3,  21,  175, 3,   0,   19,  4,   0,  132, 112, 97, 114, 101, 110, 116, 0,   4,   19, 0,   68,  185, 3,   19,  193, 3,   0,   133, 112, 97,  114, 101, 110, 116, 0,   4,   0,  131, 101, 110, 116, 0,   8,   15,  8,   21,  0,  130, 97, 110, 116, 0,   18,  6,   0,   130, 110, 115, 116, 0,  12,  9,   8,   17,  4,   16,  0,   132, 105, 102, 101, 115, 116, 0,   83,  239, 3,   23,  6,   4,   0,   87, 246, 3,   24, 254, 3,   0,   17,  12,  0,   131, 112, 117, 116, 0,   18,  0,   130, 116, 112, 117, 116, 0,   19,  24,  18,  0,   131, 116, 112, 117, 116, 0,   70,  29,  4,   8,   41,  4,   11,  51,  4,   21,  69, 4,   0,   8,   24,  20,  8,   21,  9,   0,   129, 110, 99, 121, 0,   23, 9,   4,   22,  0,   130, 101, 116, 121, 0,   6,   21,  4,   21,  12,  8,   11,  0,   135, 105, 101, 114, 97,  114, 99,  104, 121, 0,   4,   5,  12,  15,  0,   130, 114, 97,  114, 121, 0};
+static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {201, 252, 224, 14,  32,  0,   42,  0,   158, 0,   191, 1,   201, 1,   233, 1,   4,   2,   139, 2,   151, 2,   161, 2,   225, 2,   16,  3,   218, 3,   25,  4,
+                                                                  11,  23,  12,  26,  22,  0,   129, 99,  104, 0,   192, 17,  8,   2,   54,  0,   66,  0,   133, 0,   146, 0,   12,  15,  25,  17,  12,  0,   131, 97,  108, 105,
+                                                                  100, 0,   192, 64,  1,   18,  78,  0,   88,  0,   99,  0,   124, 0,   17,  12,  22,  0,   131, 103, 110, 101, 100, 0,   25,  21,  8,   7,   0,   131, 105, 118,
+                                                                  101, 100, 0,   72,  106, 0,   24,  115, 0,   0,   9,   8,   21,  0,   129, 114, 101, 100, 0,   6,   6,   18,  0,   129, 114, 101, 100, 0,   15,  6,   17,  12,
+                                                                  0,   129, 100, 101, 0,   18,  22,  8,   21,  11,  23,  0,   130, 104, 111, 108, 100, 0,   4,   26,  18,  9,   0,   131, 114, 119, 97,  114, 100, 0,   192, 93,
+                                                                  8,   62,  184, 0,   197, 0,   211, 0,   223, 0,   3,   1,   32,  1,   41,  1,   68,  1,   95,  1,   166, 1,   179, 1,   6,   19,  22,  8,   16,  4,   17,  0,
+                                                                  130, 97,  99,  101, 0,   19,  4,   22,  8,   16,  4,   17,  0,   131, 112, 97,  99,  101, 0,   12,  21,  8,   25,  18,  0,   130, 114, 105, 100, 101, 0,   23,
+                                                                  0,   68,  232, 0,   17,  243, 0,   0,   21,  4,   24,  10,  0,   130, 110, 116, 101, 101, 0,   4,   21,  24,  4,   10,  0,   135, 117, 97,  114, 97,  110, 116,
+                                                                  101, 101, 0,   68,  10,  1,   7,   20,  1,   0,   24,  10,  44,  0,   131, 97,  117, 103, 101, 0,   8,   15,  12,  25,  12,  21,  19,  0,   130, 103, 101, 0,
+                                                                  22,  4,   9,   0,   130, 108, 115, 101, 0,   76,  48,  1,   24,  60,  1,   0,   24,  20,  4,   0,   132, 99,  113, 117, 105, 114, 101, 0,   23,  44,  0,   130,
+                                                                  114, 117, 101, 0,   4,   0,   79,  77,  1,   24,  85,  1,   0,   9,   0,   131, 97,  108, 115, 101, 0,   6,   8,   5,   0,   131, 97,  117, 115, 101, 0,   4,
+                                                                  0,   71,  107, 1,   19,  144, 1,   21,  154, 1,   0,   18,  16,  0,   80,  117, 1,   18,  132, 1,   0,   18,  6,   4,   0,   135, 99,  111, 109, 109, 111, 100,
+                                                                  97,  116, 101, 0,   6,   6,   4,   0,   132, 109, 111, 100, 97,  116, 101, 0,   7,   24,  0,   132, 112, 100, 97,  116, 101, 0,   8,   19,  8,   22,  0,   132,
+                                                                  97,  114, 97,  116, 101, 0,   10,  8,   15,  15,  18,  6,   0,   130, 97,  103, 117, 101, 0,   8,   12,  6,   8,   21,  0,   131, 101, 105, 118, 101, 0,   12,
+                                                                  8,   11,  6,   0,   130, 105, 101, 102, 0,   17,  0,   76,  210, 1,   21,  223, 1,   0,   15,  8,   12,  6,   0,   133, 101, 105, 108, 105, 110, 103, 0,   12,
+                                                                  23,  22,  0,   131, 114, 105, 110, 103, 0,   70,  240, 1,   23,  251, 1,   0,   12,  23,  26,  22,  0,   131, 105, 116, 99,  104, 0,   10,  12,  8,   11,  0,
+                                                                  129, 104, 116, 0,   192, 80,  64,  18,  18,  2,   29,  2,   38,  2,   105, 2,   116, 2,   22,  18,  18,  11,  6,   0,   131, 115, 101, 110, 0,   12,  21,  23,
+                                                                  22,  0,   129, 110, 103, 0,   12,  0,   86,  47,  2,   23,  73,  2,   0,   68,  54,  2,   22,  63,  2,   0,   12,  15,  0,   131, 105, 115, 111, 110, 0,   4,
+                                                                  6,   6,   18,  0,   131, 105, 111, 110, 0,   76,  80,  2,   22,  95,  2,   0,   23,  12,  19,  8,   21,  0,   134, 101, 116, 105, 116, 105, 111, 110, 0,   18,
+                                                                  19,  0,   131, 105, 116, 105, 111, 110, 0,   23,  24,  8,   21,  0,   131, 116, 117, 114, 110, 0,   85,  123, 2,   23,  132, 2,   0,   23,  8,   21,  0,   130,
+                                                                  117, 114, 110, 0,   8,   21,  0,   128, 114, 110, 0,   7,   8,   24,  22,  19,  0,   131, 101, 117, 100, 111, 0,   24,  18,  18,  15,  0,   129, 107, 117, 112,
+                                                                  0,   72,  168, 2,   18,  208, 2,   0,   76,  178, 2,   15,  187, 2,   17,  197, 2,   0,   11,  23,  44,  0,   130, 101, 105, 114, 0,   23,  12,  9,   0,   131,
+                                                                  108, 116, 101, 114, 0,   23,  22,  12,  15,  0,   130, 101, 110, 101, 114, 0,   23,  4,   21,  8,   23,  17,  12,  0,   135, 116, 101, 114, 97,  116, 111, 114,
+                                                                  0,   72,  235, 2,   17,  243, 2,   24,  0,   3,   0,   15,  4,   9,   0,   129, 115, 101, 0,   4,   12,  23,  17,  18,  6,   0,   131, 97,  105, 110, 115, 0,
+                                                                  22,  17,  8,   6,   17,  18,  6,   0,   133, 115, 101, 110, 115, 117, 115, 0,   192, 192, 40,  20,  32,  3,   42,  3,   64,  3,   75,  3,   164, 3,   178, 3,
+                                                                  11,  24,  4,   6,   0,   130, 103, 104, 116, 0,   71,  49,  3,   10,  56,  3,   0,   12,  26,  0,   129, 116, 104, 0,   17,  8,   15,  0,   129, 116, 104, 0,
+                                                                  22,  24,  8,   21,  0,   131, 115, 117, 108, 116, 0,   68,  85,  3,   8,   96,  3,   22,  156, 3,   0,   21,  4,   19,  19,  4,   0,   130, 101, 110, 116, 0,
+                                                                  85,  103, 3,   25,  146, 3,   0,   68,  110, 3,   21,  121, 3,   0,   19,  4,   0,   132, 112, 97,  114, 101, 110, 116, 0,   4,   19,  0,   68,  131, 3,   19,
+                                                                  139, 3,   0,   133, 112, 97,  114, 101, 110, 116, 0,   4,   0,   131, 101, 110, 116, 0,   8,   15,  8,   21,  0,   130, 97,  110, 116, 0,   18,  6,   0,   130,
+                                                                  110, 115, 116, 0,   12,  9,   8,   17,  4,   16,  0,   132, 105, 102, 101, 115, 116, 0,   83,  185, 3,   23,  208, 3,   0,   87,  192, 3,   24,  200, 3,   0,
+                                                                  17,  12,  0,   131, 112, 117, 116, 0,   18,  0,   130, 116, 112, 117, 116, 0,   19,  24,  18,  0,   131, 116, 112, 117, 116, 0,   192, 148, 0,   2,   230, 3,
+                                                                  242, 3,   252, 3,   14,  4,   8,   24,  20,  8,   21,  9,   0,   129, 110, 99,  121, 0,   23,  9,   4,   22,  0,   130, 101, 116, 121, 0,   6,   21,  4,   21,
+                                                                  12,  8,   11,  0,   135, 105, 101, 114, 97,  114, 99,  104, 121, 0,   4,   5,   12,  15,  0,   130, 114, 97,  114, 121, 0,   72,  32,  4,   22,  42,  4,   0,
+                                                                  11,  23,  44,  8,   11,  23,  44,  0,   132, 0,   8,   22,  18,  18,  15,  0,   132, 115, 101, 115, 0};
@@ -33,7 +33,7 @@ bool autocorrect_is_enabled(void) {
  */
 void autocorrect_enable(void) {
     keymap_config.autocorrect_enable = true;
-    eeconfig_update_keymap(keymap_config.raw);
+    eeconfig_update_deferred(eeconfig_update_keymap_current);
 }
 
 /**
@@ -43,7 +43,7 @@ void autocorrect_enable(void) {
 void autocorrect_disable(void) {
     keymap_config.autocorrect_enable = false;
     typo_buffer_size                 = 0;
-    eeconfig_update_keymap(keymap_config.raw);
+    eeconfig_update_deferred(eeconfig_update_keymap_current);
 }
 
 /**
@@ -53,7 +53,24 @@ void autocorrect_disable(void) {
 void autocorrect_toggle(void) {
     keymap_config.autocorrect_enable = !keymap_config.autocorrect_enable;
     typo_buffer_size                 = 0;
-    eeconfig_update_keymap(keymap_config.raw);
+    eeconfig_update_deferred(eeconfig_update_keymap_current);
+}
+
+/**
+ * @brief Maps a keycode held in the typo buffer to its bit in a bitmap node
+ *
+ * @param keycode KC_A to KC_Z, KC_QUOTE or KC_SPACE
+ * @return uint8_t bit index, 0 to 27
+ */
+static inline uint8_t autocorrect_key_index(uint8_t keycode) {
+    switch (keycode) {
+        case KC_QUOTE:
+            return 26;
+        case KC_SPACE:
+            return 27;
+        default:
+            return keycode - KC_A;
+    }
 }
 
 /**
@@ -260,7 +277,17 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
         uint8_t const key_i = typo_buffer[i];
 
-        if (code & 64) { // Check for match in node with multiple children.
+        if ((code & 192) == 192) { // Check for match in bitmap node with multiple children.
+            // The low nibble and the next three bytes hold one bit per key that
+            // has a child, followed by the links of all children in key order. At
+            // the root this rejects a key that ends no typo with a single test.
+            uint32_t const mask = (uint32_t)(code & 15) << 24 | (uint32_t)pgm_read_byte(autocorrect_data + state + 3) << 16 | (uint16_t)pgm_read_byte(autocorrect_data + state + 2) << 8 | pgm_read_byte(autocorrect_data + state + 1);
+            uint32_t const bit  = (uint32_t)1 << autocorrect_key_index(key_i);
+            if (!(mask & bit)) return true;
+            // Follow link to child node, indexed by the number of lower keys present.
+            state += 4 + 2 * __builtin_popcountl(mask & (bit - 1));
+            state = (pgm_read_byte(autocorrect_data + state) | pgm_read_byte(autocorrect_data + state + 1) << 8);
+        } else if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
             for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
                 if (!code) return true;
@@ -282,7 +309,7 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
 
         code = pgm_read_byte(autocorrect_data + state);
 
-        if (code & 128) { // A typo was found! Apply autocorrect.
+        if ((code & 192) == 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
             if (apply_autocorrect(backspaces, (char const *)(autocorrect_data + state + 1))) {
                 for (uint8_t i = 0; i < backspaces; ++i) {
@@ -20,6 +20,7 @@
 #include "action_tapping.h"
 #include "action.h"
 #include "keymap_introspection.h"
+#include "timeout.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -528,6 +529,22 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+#ifndef COMBO_NO_TIMER
+/** \brief Keeps the combo timeout in line with the buffered state.
+ *
+ * The buffered keys and combos are resolved once strictly more than `longest_term` has elapsed since `timer`.
+ */
+static void combo_update_timeout(void) {
+    if (!timer) {
+        timeout_cancel(TIMEOUT_COMBO);
+        return;
+    }
+
+    uint16_t elapsed = timer_elapsed(timer);
+    timeout_start(TIMEOUT_COMBO, elapsed > longest_term ? 0 : longest_term + 1 - elapsed, combo_task);
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -596,6 +613,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
             clear_combos();
         }
     }
+
+#ifndef COMBO_NO_TIMER
+    combo_update_timeout();
+#endif
     return !is_combo_key;
 }
 
@@ -616,6 +637,7 @@ void combo_task(void) {
             clear_combos();
         }
     }
+    combo_update_timeout();
 #endif
 }
 
@@ -626,6 +648,7 @@ void combo_enable(void) {
 void combo_disable(void) {
 #ifndef COMBO_NO_TIMER
     timer = 0;
+    timeout_cancel(TIMEOUT_COMBO);
 #endif
     b_combo_enable    = false;
     combo_buffer_read = combo_buffer_write;
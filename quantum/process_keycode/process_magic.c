@@ -182,7 +182,7 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                     break;
             }
 
-            eeconfig_update_keymap(keymap_config.raw);
+            eeconfig_update_deferred(eeconfig_update_keymap_current);
             clear_keyboard(); // clear to prevent stuck keys
 
             return false;
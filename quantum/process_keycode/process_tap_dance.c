@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "quantum.h"
+#include "timeout.h"
 
 static uint16_t active_td;
 static uint16_t last_tap_time;
@@ -150,6 +151,10 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
                 last_tap_time = timer_read();
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
+                if (active_td) {
+                    // Dance finishes once strictly more than the tapping term has elapsed
+                    timeout_start(TIMEOUT_TAP_DANCE, GET_TAPPING_TERM(active_td, &(keyrecord_t){}) + 1, tap_dance_task);
+                }
             } else {
                 if (action->state.finished) {
                     process_tap_dance_action_on_reset(action);
@@ -165,7 +170,15 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 void tap_dance_task(void) {
     tap_dance_action_t *action;
 
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td) return;
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    if (elapsed <= term) {
+        // The tapping term has been extended since the timeout was armed
+        timeout_start(TIMEOUT_TAP_DANCE, term + 1 - elapsed, tap_dance_task);
+        return;
+    }
 
     action = &tap_dance_actions[TD_INDEX(active_td)];
     if (!action->state.interrupted) {
@@ -36,6 +36,14 @@
 #    include "haptic.h"
 #endif
 
+#if defined(EEPROM_I2C) && defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+#    include "eeprom.h"
+#endif
+
+#ifdef FLASH_SPI
+#    include "flash_spi.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -140,6 +148,18 @@ __attribute__((weak)) void post_process_record_kb(uint16_t keycode, keyrecord_t
 
 __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_t *record) {}
 
+/** \brief Writes out everything still held back from the EEPROM, waiting for it to complete
+ */
+static void flush_pending_writes(void) {
+    eeconfig_flush();
+#if defined(EEPROM_I2C) && defined(EXTERNAL_EEPROM_WRITE_BEHIND)
+    eeprom_i2c_flush();
+#endif
+#ifdef FLASH_SPI
+    flash_wait();
+#endif
+}
+
 void shutdown_quantum(void) {
     clear_keyboard();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
@@ -162,6 +182,7 @@ void shutdown_quantum(void) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+    flush_pending_writes();
 }
 
 void reset_keyboard(void) {
@@ -464,6 +485,8 @@ __attribute__((weak)) void startup_user(void) {}
 __attribute__((weak)) void shutdown_user(void) {}
 
 void suspend_power_down_quantum(void) {
+    // Settings changed just before suspending shouldn't wait for the scheduler, nor sit in write-behind caches
+    flush_pending_writes();
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
@@ -61,6 +61,10 @@
 #    include "deferred_exec.h"
 #endif
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
 extern layer_state_t default_layer_state;
 
 #ifndef NO_ACTION_LAYER
@@ -24,6 +24,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -317,7 +321,6 @@ static void rgb_task_timers(void) {
 }
 
 static void rgb_task_sync(void) {
-    eeconfig_flush_rgb_matrix(false);
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
@@ -439,6 +442,16 @@ void rgb_matrix_task(void) {
             rgb_task_sync();
             break;
     }
+
+#ifdef IDLE_SLEEP_ENABLE
+    // Frames are rendered over several iterations, then nothing happens until the next one is due
+    if (rgb_task_state == SYNCING) {
+        uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+        idle_sleep_request_wakeup_in(elapsed < RGB_MATRIX_LED_FLUSH_LIMIT ? RGB_MATRIX_LED_FLUSH_LIMIT - elapsed : 0);
+    } else {
+        idle_sleep_prevent();
+    }
+#endif
 }
 
 void rgb_matrix_indicators(void) {
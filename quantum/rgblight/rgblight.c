@@ -27,6 +27,9 @@
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
 #endif
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
 #ifdef VELOCIKEY_ENABLE
 #    include "velocikey.h"
 #endif
@@ -105,6 +108,9 @@ rgblight_config_t rgblight_config;
 rgblight_status_t rgblight_status         = {.timer_enabled = false};
 bool              is_rgblight_initialized = false;
 
+// Value to write out once a deferred EEPROM update is flushed, so that any _noeeprom changes made in the meantime aren't persisted
+static rgblight_config_t rgblight_config_saved;
+
 #ifdef RGBLIGHT_SLEEP
 static bool is_suspended;
 static bool pre_suspend_enabled;
@@ -186,6 +192,7 @@ uint64_t eeconfig_read_rgblight(void) {
 }
 
 void eeconfig_update_rgblight(uint64_t val) {
+    rgblight_config_saved.raw = val;
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
     eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
@@ -197,6 +204,15 @@ void eeconfig_update_rgblight_current(void) {
     eeconfig_update_rgblight(rgblight_config.raw);
 }
 
+static void eeconfig_update_rgblight_saved(void) {
+    eeconfig_update_rgblight(rgblight_config_saved.raw);
+}
+
+static void rgblight_update_eeprom_deferred(void) {
+    rgblight_config_saved = rgblight_config;
+    eeconfig_update_deferred(eeconfig_update_rgblight_saved);
+}
+
 void eeconfig_update_rgblight_default(void) {
     rgblight_config.enable = 1;
     rgblight_config.mode   = RGBLIGHT_DEFAULT_MODE;
@@ -344,7 +360,7 @@ void rgblight_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     }
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        rgblight_update_eeprom_deferred();
         dprintf("rgblight mode [EEPROM]: %u\n", rgblight_config.mode);
     } else {
         dprintf("rgblight mode [NOEEPROM]: %u\n", rgblight_config.mode);
@@ -402,7 +418,7 @@ void rgblight_enable_noeeprom(void) {
 
 void rgblight_disable(void) {
     rgblight_config.enable = 0;
-    eeconfig_update_rgblight(rgblight_config.raw);
+    rgblight_update_eeprom_deferred();
     dprintf("rgblight disable [EEPROM]: rgblight_config.enable = %u\n", rgblight_config.enable);
     rgblight_timer_disable();
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
@@ -490,7 +506,7 @@ void rgblight_increase_speed_helper(bool write_to_eeprom) {
     if (rgblight_config.speed < 3) rgblight_config.speed++;
     // RGBLIGHT_SPLIT_SET_CHANGE_HSVS; // NEED?
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        rgblight_update_eeprom_deferred();
     }
 }
 void rgblight_increase_speed(void) {
@@ -504,7 +520,7 @@ void rgblight_decrease_speed_helper(bool write_to_eeprom) {
     if (rgblight_config.speed > 0) rgblight_config.speed--;
     // RGBLIGHT_SPLIT_SET_CHANGE_HSVS; // NEED??
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        rgblight_update_eeprom_deferred();
     }
 }
 void rgblight_decrease_speed(void) {
@@ -590,7 +606,7 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
         rgblight_config.sat = sat;
         rgblight_config.val = val;
         if (write_to_eeprom) {
-            eeconfig_update_rgblight(rgblight_config.raw);
+            rgblight_update_eeprom_deferred();
             dprintf("rgblight set hsv [EEPROM]: %u,%u,%u\n", rgblight_config.hue, rgblight_config.sat, rgblight_config.val);
         } else {
             dprintf("rgblight set hsv [NOEEPROM]: %u,%u,%u\n", rgblight_config.hue, rgblight_config.sat, rgblight_config.val);
@@ -613,7 +629,7 @@ uint8_t rgblight_get_speed(void) {
 void rgblight_set_speed_eeprom_helper(uint8_t speed, bool write_to_eeprom) {
     rgblight_config.speed = speed;
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        rgblight_update_eeprom_deferred();
         dprintf("rgblight set speed [EEPROM]: %u\n", rgblight_config.speed);
     } else {
         dprintf("rgblight set speed [NOEEPROM]: %u\n", rgblight_config.speed);
@@ -1049,6 +1065,16 @@ static void rgblight_effect_dummy(animation_status_t *anim) {
     **/
 }
 
+#    ifdef IDLE_SLEEP_ENABLE
+// Lets the main loop sleep until the given sync timer time, when the next animation step or blink is due
+static void rgblight_request_wakeup(uint16_t deadline) {
+    int16_t remaining = (int16_t)(deadline - sync_timer_read());
+    idle_sleep_request_wakeup_in(remaining > 0 ? remaining : 0);
+}
+#    else
+#        define rgblight_request_wakeup(deadline)
+#    endif
+
 void rgblight_task(void) {
     if (rgblight_status.timer_enabled) {
         effect_func_t effect_func   = rgblight_effect_dummy;
@@ -1149,11 +1175,15 @@ void rgblight_task(void) {
             }
 #    endif
         }
+        rgblight_request_wakeup(animation_status.last_timer);
     }
 
 #    ifdef RGBLIGHT_LAYERS
 #        ifdef RGBLIGHT_LAYER_BLINK
     rgblight_blink_layer_repeat_helper();
+    if (_blinking_layer_mask != 0) {
+        rgblight_request_wakeup(_repeat_timer);
+    }
 #        endif
 
     if (deferred_set_layer_state) {
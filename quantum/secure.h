@@ -67,7 +67,7 @@ void secure_activity_event(void);
  */
 void secure_keypress_event(uint8_t row, uint8_t col);
 
-/** \brief Handle various secure subsystem background tasks
+/** \brief Handle the secure subsystem timeouts, invoked once the pending deadline has passed
  */
 void secure_task(void);
 
@@ -0,0 +1,78 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "timeout.h"
+#include "timer.h"
+
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
+
+_Static_assert(TIMEOUT_COUNT <= 8, "Too many timeouts for the pending mask");
+
+static timeout_callback_t callbacks[TIMEOUT_COUNT];
+static uint32_t           deadlines[TIMEOUT_COUNT];
+static uint8_t            pending_mask  = 0;
+static uint32_t           next_deadline = 0;
+
+static inline bool deadline_before(uint32_t a, uint32_t b) {
+    return ((int32_t)TIMER_DIFF_32(a, b)) < 0;
+}
+
+void timeout_start(timeout_id_t id, uint32_t delay_ms, timeout_callback_t callback) {
+    uint32_t deadline = timer_read32() + delay_ms;
+
+    callbacks[id] = callback;
+    deadlines[id] = deadline;
+
+    // Cancelled or re-armed entries may leave the cached deadline early, which only costs a spurious scan
+    if (!pending_mask || deadline_before(deadline, next_deadline)) {
+        next_deadline = deadline;
+    }
+    pending_mask |= 1 << id;
+}
+
+void timeout_cancel(timeout_id_t id) {
+    pending_mask &= ~(1 << id);
+}
+
+bool timeout_is_pending(timeout_id_t id) {
+    return pending_mask & (1 << id);
+}
+
+void timeout_task(void) {
+    if (!pending_mask) {
+        return;
+    }
+
+    uint32_t now = timer_read32();
+    if (deadline_before(now, next_deadline)) {
+#ifdef IDLE_SLEEP_ENABLE
+        idle_sleep_request_wakeup(next_deadline);
+#endif
+        return;
+    }
+
+    for (uint8_t id = 0; id < TIMEOUT_COUNT; id++) {
+        // Disarm before invoking, as the callback may re-arm itself
+        if ((pending_mask & (1 << id)) && !deadline_before(now, deadlines[id])) {
+            pending_mask &= ~(1 << id);
+            callbacks[id]();
+        }
+    }
+
+    // Work out the next deadline from whatever is still armed, including anything armed by the callbacks
+    bool first = true;
+    for (uint8_t id = 0; id < TIMEOUT_COUNT; id++) {
+        if ((pending_mask & (1 << id)) && (first || deadline_before(deadlines[id], next_deadline))) {
+            next_deadline = deadlines[id];
+            first         = false;
+        }
+    }
+
+#ifdef IDLE_SLEEP_ENABLE
+    if (pending_mask) {
+        idle_sleep_request_wakeup(next_deadline);
+    }
+#endif
+}
@@ -0,0 +1,55 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @typedef Identifies the timeout owned by a core feature. Each feature has a single pending deadline at most, and
+ * expired timeouts are dispatched in this order.
+ */
+typedef enum timeout_id_t {
+    TIMEOUT_TAP_DANCE,
+    TIMEOUT_COMBO,
+    TIMEOUT_LEADER,
+    TIMEOUT_CAPS_WORD,
+    TIMEOUT_SECURE,
+    TIMEOUT_COUNT,
+} timeout_id_t;
+
+/**
+ * @typedef Callback invoked from the main loop once the deadline has passed.
+ */
+typedef void (*timeout_callback_t)(void);
+
+/**
+ * Arms (or re-arms) a timeout, replacing any deadline previously set for the same id.
+ *
+ * @param id[in] the timeout to arm
+ * @param delay_ms[in] the number of milliseconds from now before invoking the callback
+ * @param callback[in] the function to invoke once expired
+ */
+void timeout_start(timeout_id_t id, uint32_t delay_ms, timeout_callback_t callback);
+
+/**
+ * Disarms a timeout, if pending.
+ *
+ * @param id[in] the timeout to disarm
+ */
+void timeout_cancel(timeout_id_t id);
+
+/**
+ * Checks whether a timeout is armed and has yet to expire.
+ *
+ * @param id[in] the timeout to check
+ * @return true if the callback is still due to be invoked
+ */
+bool timeout_is_pending(timeout_id_t id);
+
+/**
+ * Invokes the callbacks of any expired timeouts. Should not be invoked by keyboard/user code, the quantum task runs
+ * this on every main loop iteration.
+ */
+void timeout_task(void);
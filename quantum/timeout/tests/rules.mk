@@ -0,0 +1,4 @@
+timeout_SRC := \
+	$(QUANTUM_PATH)/timeout/tests/timeout_tests.cpp \
+	$(QUANTUM_PATH)/timeout.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
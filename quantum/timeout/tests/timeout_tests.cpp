@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "timeout.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+static std::vector<std::pair<timeout_id_t, uint32_t>> fired; // (id, time)
+
+static void fire_tap_dance(void) {
+    fired.emplace_back(TIMEOUT_TAP_DANCE, timer_read32());
+}
+
+static void fire_leader(void) {
+    fired.emplace_back(TIMEOUT_LEADER, timer_read32());
+}
+
+static void fire_and_rearm_leader(void) {
+    fired.emplace_back(TIMEOUT_LEADER, timer_read32());
+    if (fired.size() < 3) {
+        timeout_start(TIMEOUT_LEADER, 10, fire_and_rearm_leader);
+    }
+}
+
+class Timeout : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        fired.clear();
+        for (int id = 0; id < TIMEOUT_COUNT; id++) {
+            timeout_cancel((timeout_id_t)id);
+        }
+    }
+
+    void run_until(uint32_t t) {
+        while (timer_read32() < t) {
+            advance_time(1);
+            timeout_task();
+        }
+    }
+};
+
+TEST_F(Timeout, FiresOnceAtDeadline) {
+    timeout_start(TIMEOUT_TAP_DANCE, 50, fire_tap_dance);
+    EXPECT_TRUE(timeout_is_pending(TIMEOUT_TAP_DANCE));
+
+    run_until(1049);
+    EXPECT_TRUE(fired.empty());
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 1050u);
+    EXPECT_FALSE(timeout_is_pending(TIMEOUT_TAP_DANCE));
+}
+
+TEST_F(Timeout, CancelPreventsCallback) {
+    timeout_start(TIMEOUT_TAP_DANCE, 50, fire_tap_dance);
+    run_until(1020);
+    timeout_cancel(TIMEOUT_TAP_DANCE);
+    EXPECT_FALSE(timeout_is_pending(TIMEOUT_TAP_DANCE));
+
+    run_until(1200);
+    EXPECT_TRUE(fired.empty());
+}
+
+TEST_F(Timeout, RearmReplacesDeadline) {
+    timeout_start(TIMEOUT_LEADER, 20, fire_leader);
+    run_until(1010);
+    timeout_start(TIMEOUT_LEADER, 20, fire_leader);
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 1030u);
+}
+
+TEST_F(Timeout, RearmToLaterDeadlineAfterEarlierCancel) {
+    // The cached earliest deadline goes stale here, which must not fire anything early
+    timeout_start(TIMEOUT_TAP_DANCE, 10, fire_tap_dance);
+    timeout_start(TIMEOUT_LEADER, 40, fire_leader);
+    timeout_cancel(TIMEOUT_TAP_DANCE);
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].first, TIMEOUT_LEADER);
+    EXPECT_EQ(fired[0].second, 1040u);
+}
+
+TEST_F(Timeout, IndependentDeadlines) {
+    timeout_start(TIMEOUT_LEADER, 30, fire_leader);
+    timeout_start(TIMEOUT_TAP_DANCE, 10, fire_tap_dance);
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0], std::make_pair(TIMEOUT_TAP_DANCE, 1010u));
+    EXPECT_EQ(fired[1], std::make_pair(TIMEOUT_LEADER, 1030u));
+}
+
+TEST_F(Timeout, SameDeadlineFiresInIdOrder) {
+    timeout_start(TIMEOUT_LEADER, 10, fire_leader);
+    timeout_start(TIMEOUT_TAP_DANCE, 10, fire_tap_dance);
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0].first, TIMEOUT_TAP_DANCE);
+    EXPECT_EQ(fired[1].first, TIMEOUT_LEADER);
+}
+
+TEST_F(Timeout, CallbackCanRearm) {
+    timeout_start(TIMEOUT_LEADER, 10, fire_and_rearm_leader);
+
+    run_until(1200);
+    ASSERT_EQ(fired.size(), 3u);
+    EXPECT_EQ(fired[0].second, 1010u);
+    EXPECT_EQ(fired[1].second, 1020u);
+    EXPECT_EQ(fired[2].second, 1030u);
+}
+
+TEST_F(Timeout, ZeroDelayFiresOnNextTask) {
+    timeout_start(TIMEOUT_TAP_DANCE, 0, fire_tap_dance);
+    timeout_task();
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 1000u);
+}
+
+TEST_F(Timeout, DeadlineAcrossTimerWrap) {
+    set_time(UINT32_MAX - 5);
+    timeout_start(TIMEOUT_TAP_DANCE, 10, fire_tap_dance);
+
+    for (int i = 0; i < 9; i++) {
+        advance_time(1);
+        timeout_task();
+    }
+    EXPECT_TRUE(fired.empty());
+
+    advance_time(1);
+    timeout_task();
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 4u);
+}
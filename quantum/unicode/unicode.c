@@ -198,10 +198,14 @@ void cycle_unicode_input_mode(int8_t offset) {
 #endif
 }
 
-void persist_unicode_input_mode(void) {
+static void eeconfig_update_unicode_input_mode(void) {
     eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
+void persist_unicode_input_mode(void) {
+    eeconfig_update_deferred(eeconfig_update_unicode_input_mode);
+}
+
 __attribute__((weak)) void unicode_input_start(void) {
     unicode_saved_led_state = host_keyboard_led_state();
 
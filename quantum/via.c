@@ -35,6 +35,11 @@
 #    include <lib/lib8tion/lib8tion.h>
 #endif
 
+#ifdef VIA_BULK_TRANSFER
+#    include <string.h>
+#    include "crc.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -243,6 +248,125 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_BULK_TRANSFER
+// Bulk packets carry the command ID and a sequence number ahead of the payload
+#    define VIA_BULK_HEADER_SIZE 2
+
+// Bulk transfers:
+//   id_bulk_read:         [target][offset:2][size:2]
+//                         -> one packet per payload, [id_bulk_read][sequence][payload]
+//   id_bulk_write_begin:  [target][offset:2][size:2] -> [status][VIA_BULK_BUFFER_SIZE:2]
+//   id_bulk_write_data:   [sequence][payload], no reply
+//   id_bulk_write_commit: [crc8 of the whole payload] -> [status]
+// Sequence numbers start at zero for each transfer. Nothing is written
+// to EEPROM unless every packet arrived in order and the CRC matches.
+static struct {
+    uint8_t  target;
+    uint8_t  sequence;
+    uint8_t  status;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t received;
+} via_bulk = {.status = bulk_status_not_started};
+
+static uint8_t via_bulk_buffer[VIA_BULK_BUFFER_SIZE];
+
+static bool via_bulk_in_range(uint8_t target, uint16_t offset, uint16_t size) {
+    uint32_t end = (uint32_t)offset + size;
+    if (size == 0 || size > VIA_BULK_BUFFER_SIZE) {
+        return false;
+    }
+    switch (target) {
+        case id_bulk_keymap:
+            return end <= (uint32_t)dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_macro:
+            return end <= dynamic_keymap_macro_get_buffer_size();
+        default:
+            return false;
+    }
+}
+
+static void via_bulk_read(uint8_t *data, uint8_t length) {
+    uint8_t  target = data[1];
+    uint16_t offset = (data[2] << 8) | data[3];
+    uint16_t size   = (data[4] << 8) | data[5];
+    if (!via_bulk_in_range(target, offset, size)) {
+        data[0] = id_unhandled;
+        raw_hid_send(data, length);
+        return;
+    }
+
+    // Each chunk is read straight into the packet being sent
+    uint8_t  payload  = length - VIA_BULK_HEADER_SIZE;
+    uint8_t  sequence = 0;
+    uint16_t position = 0;
+    while (position < size) {
+        uint16_t chunk = MIN(payload, size - position);
+        data[0]        = id_bulk_read;
+        data[1]        = sequence++;
+        memset(&data[VIA_BULK_HEADER_SIZE + chunk], 0, payload - chunk);
+        if (target == id_bulk_keymap) {
+            dynamic_keymap_get_buffer(offset + position, chunk, &data[VIA_BULK_HEADER_SIZE]);
+        } else {
+            dynamic_keymap_macro_get_buffer(offset + position, chunk, &data[VIA_BULK_HEADER_SIZE]);
+        }
+        raw_hid_send(data, length);
+        position += chunk;
+    }
+}
+
+static void via_bulk_write_begin(uint8_t *command_data) {
+    via_bulk.target   = command_data[0];
+    via_bulk.offset   = (command_data[1] << 8) | command_data[2];
+    via_bulk.size     = (command_data[3] << 8) | command_data[4];
+    via_bulk.sequence = 0;
+    via_bulk.received = 0;
+    if (via_bulk_in_range(via_bulk.target, via_bulk.offset, via_bulk.size)) {
+        via_bulk.status = bulk_status_ok;
+        command_data[0] = bulk_status_ok;
+    } else {
+        via_bulk.status = bulk_status_not_started;
+        command_data[0] = bulk_status_out_of_range;
+    }
+    command_data[1] = VIA_BULK_BUFFER_SIZE >> 8;
+    command_data[2] = VIA_BULK_BUFFER_SIZE & 0xFF;
+}
+
+static void via_bulk_write_data(uint8_t *data, uint8_t length) {
+    // Errors are held on to until the commit, so the host never waits for replies
+    if (via_bulk.status != bulk_status_ok) {
+        return;
+    }
+    if (data[1] != via_bulk.sequence) {
+        via_bulk.status = bulk_status_sequence_error;
+        return;
+    }
+    uint16_t chunk = MIN(length - VIA_BULK_HEADER_SIZE, via_bulk.size - via_bulk.received);
+    memcpy(&via_bulk_buffer[via_bulk.received], &data[VIA_BULK_HEADER_SIZE], chunk);
+    via_bulk.received += chunk;
+    via_bulk.sequence++;
+}
+
+static void via_bulk_write_commit(uint8_t *command_data) {
+    uint8_t status = via_bulk.status;
+    if (status == bulk_status_ok && via_bulk.received < via_bulk.size) {
+        status = bulk_status_incomplete;
+    }
+    if (status == bulk_status_ok && crc8(via_bulk_buffer, via_bulk.size) != command_data[0]) {
+        status = bulk_status_crc_mismatch;
+    }
+    if (status == bulk_status_ok) {
+        if (via_bulk.target == id_bulk_keymap) {
+            dynamic_keymap_set_buffer(via_bulk.offset, via_bulk.size, via_bulk_buffer);
+        } else {
+            dynamic_keymap_macro_set_buffer(via_bulk.offset, via_bulk.size, via_bulk_buffer);
+        }
+    }
+    via_bulk.status = bulk_status_not_started;
+    command_data[0] = status;
+}
+#endif
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -414,6 +538,25 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef VIA_BULK_TRANSFER
+        case id_bulk_read: {
+            // Replies have already been sent
+            via_bulk_read(data, length);
+            return;
+        }
+        case id_bulk_write_begin: {
+            via_bulk_write_begin(command_data);
+            break;
+        }
+        case id_bulk_write_data: {
+            via_bulk_write_data(data, length);
+            return;
+        }
+        case id_bulk_write_commit: {
+            via_bulk_write_commit(command_data);
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
@@ -70,6 +70,17 @@
 #    define VIA_FIRMWARE_VERSION 0x00000000
 #endif
 
+// Bulk transfers stream keymap and macro buffers over several packets,
+// staged in RAM and written to EEPROM in one go once complete.
+// These aren't enabled by default, as the staging buffer takes up
+// VIA_BULK_BUFFER_SIZE bytes of RAM.
+// #define VIA_BULK_TRANSFER
+
+// The most that can be read or written by a single bulk transfer.
+#ifndef VIA_BULK_BUFFER_SIZE
+#    define VIA_BULK_BUFFER_SIZE 512
+#endif
+
 enum via_command_id {
     id_get_protocol_version                 = 0x01, // always 0x01
     id_get_keyboard_value                   = 0x02,
@@ -92,6 +103,10 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_bulk_read                            = 0x16,
+    id_bulk_write_begin                     = 0x17,
+    id_bulk_write_data                      = 0x18,
+    id_bulk_write_commit                    = 0x19,
     id_unhandled                            = 0xFF,
 };
 
@@ -111,6 +126,20 @@ enum via_channel_id {
     id_qmk_audio_channel      = 4,
 };
 
+enum via_bulk_target {
+    id_bulk_keymap = 0x01,
+    id_bulk_macro  = 0x02,
+};
+
+enum via_bulk_status {
+    bulk_status_ok             = 0x00,
+    bulk_status_not_started    = 0x01,
+    bulk_status_out_of_range   = 0x02,
+    bulk_status_sequence_error = 0x03,
+    bulk_status_incomplete     = 0x04,
+    bulk_status_crc_mismatch   = 0x05,
+};
+
 enum via_qmk_backlight_value {
     id_qmk_backlight_brightness = 1,
     id_qmk_backlight_effect     = 2,
@@ -20,9 +20,12 @@ void MockBackingStore::reset_instance() {
 
     backing_init_invoke_count   = 0;
     backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_erase_invoke_count       = 0;
+    backing_erase_range_invoke_count = 0;
+    backing_write_invoke_count       = 0;
+    backing_lock_invoke_count        = 0;
+    backing_read_invoke_count        = 0;
+    backing_read_byte_count          = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -30,6 +33,8 @@ void MockBackingStore::reset_instance() {
     write_success_callback  = [](std::uint64_t, std::uint32_t) { return true; };
     lock_success_callback   = [](std::uint64_t) { return true; };
 
+    power_remaining = UINT64_MAX;
+
     write_log.clear();
 }
 
@@ -60,7 +65,7 @@ bool MockBackingStore::erase(void) {
     // Erase each slot
     for (std::size_t i = 0; i < backing_storage.size(); ++i) {
         // Drop out of erase early with failure if we need to
-        if (erase_success_callback && !erase_success_callback(backing_erase_invoke_count)) {
+        if ((erase_success_callback && !erase_success_callback(backing_erase_invoke_count)) || !consume_power()) {
             append_log(true);
             return false;
         }
@@ -75,6 +80,27 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_range(uint32_t address, std::size_t length) {
+    ++backing_erase_range_invoke_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
+    EXPECT_TRUE(length % BACKING_STORE_WRITE_SIZE == 0) << "Supplied length was not aligned with the backing store integral size";
+    EXPECT_TRUE(address + length <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Erase each slot in the range
+    for (std::size_t i = address / BACKING_STORE_WRITE_SIZE; i < (address + length) / BACKING_STORE_WRITE_SIZE; ++i) {
+        // Drop out of erase early with failure if we need to
+        if ((erase_success_callback && !erase_success_callback(backing_erase_range_invoke_count)) || !consume_power()) {
+            return false;
+        }
+
+        backing_storage[i].erase();
+    }
+
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -84,7 +110,7 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     EXPECT_FALSE(is_locked()) << "Write was attempted without being unlocked first";
 
     // Drop out of write early with failure if we need to
-    if (write_success_callback && !write_success_callback(backing_write_invoke_count, address)) {
+    if ((write_success_callback && !write_success_callback(backing_write_invoke_count, address)) || !consume_power()) {
         return false;
     }
 
@@ -122,6 +148,24 @@ bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const
     std::size_t index = address / BACKING_STORE_WRITE_SIZE;
     value             = ~backing_storage[index].get();
 
+    ++backing_read_invoke_count;
+    backing_read_byte_count += BACKING_STORE_WRITE_SIZE;
+    return true;
+}
+
+bool MockBackingStore::read_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) const {
+    EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
+    EXPECT_TRUE(address + item_count * BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+
+    // Read and take the complement as we're simulating flash memory -- 0xFF means 0x00
+    std::size_t index = address / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = 0; i < item_count; ++i) {
+        values[i] = ~backing_storage[index + i].get();
+    }
+
+    // A bulk read counts as a single transaction with the backing store
+    ++backing_read_invoke_count;
+    backing_read_byte_count += item_count * BACKING_STORE_WRITE_SIZE;
     return true;
 }
 
@@ -141,6 +185,10 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_range(uint32_t address, size_t length) {
+    return MockBackingStore::Instance().erase_range(address, length);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -152,3 +200,7 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+extern "C" bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().read_bulk(address, values, item_count);
+}
@@ -27,18 +27,21 @@ class MockBackingStoreElement {
     backing_store_int_t value;
     std::size_t         writes;
     std::size_t         erases;
+    std::size_t         cycles;
 
    public:
-    MockBackingStoreElement() : value(BACKING_STORE_INTEGRAL_COMPLEMENT::value), writes(0), erases(0) {}
+    MockBackingStoreElement() : value(BACKING_STORE_INTEGRAL_COMPLEMENT::value), writes(0), erases(0), cycles(0) {}
     void reset() {
         erase();
         writes = 0;
         erases = 0;
+        cycles = 0;
     }
     void erase() {
         if (!is_erased()) {
             ++erases;
         }
+        ++cycles;
         value = BACKING_STORE_INTEGRAL_COMPLEMENT::value;
     }
     backing_store_int_t get() const {
@@ -55,6 +58,10 @@ class MockBackingStoreElement {
     std::size_t num_erases() const {
         return erases;
     }
+    // Erase cycles, including those of elements which were already erased -- flash erases whole sectors regardless
+    std::size_t num_erase_cycles() const {
+        return cycles;
+    }
     bool is_erased() const {
         return value == BACKING_STORE_INTEGRAL_COMPLEMENT::value;
     }
@@ -94,8 +101,12 @@ class MockBackingStore {
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    // Reads are const, but still need to be counted
+    mutable std::uint64_t backing_read_invoke_count;
+    mutable std::uint64_t backing_read_byte_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -108,6 +119,16 @@ class MockBackingStore {
     // Whether locks should succeed
     std::function<bool(std::uint64_t)> lock_success_callback;
 
+    // The number of element writes/erases left before simulated power loss, in which case nothing further is modified
+    std::uint64_t power_remaining;
+    bool consume_power() {
+        if (power_remaining == 0) {
+            return false;
+        }
+        --power_remaining;
+        return true;
+    }
+
     template <typename... Args>
     void append_log(Args&&... args) {
         if (write_log.size() < MOCK_WRITE_LOG_MAX_ENTRIES::value) {
@@ -141,16 +162,35 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
+    std::uint64_t read_byte_count() const {
+        return backing_read_byte_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
 
+    // Simulate power loss after the given number of element writes/erases
+    void set_power_loss_after(std::uint64_t operations) {
+        power_remaining = operations;
+    }
+    // Restore power, as if the MCU was reset -- contents of the backing store are retained
+    void power_cycle() {
+        power_remaining = UINT64_MAX;
+        locked          = true;
+    }
+
     bool is_locked() const {
         return locked;
     }
@@ -159,9 +199,11 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::size_t length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count) const;
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
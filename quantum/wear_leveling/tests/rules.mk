@@ -28,7 +28,8 @@ wear_leveling_2byte_optimized_writes_DEFS := \
 	-DWEAR_LEVELING_LOGICAL_SIZE=32768
 wear_leveling_2byte_optimized_writes_SRC := \
 	$(wear_leveling_common_SRC) \
-	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_2byte_optimized_writes.cpp
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_2byte_optimized_writes.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_replay.cpp
 wear_leveling_2byte_optimized_writes_INC := \
 	$(wear_leveling_common_INC)
 
@@ -39,7 +40,8 @@ wear_leveling_2byte_DEFS := \
 	-DWEAR_LEVELING_LOGICAL_SIZE=16
 wear_leveling_2byte_SRC := \
 	$(wear_leveling_common_SRC) \
-	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_2byte.cpp
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_2byte.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_replay.cpp
 wear_leveling_2byte_INC := \
 	$(wear_leveling_common_INC)
 
@@ -50,7 +52,8 @@ wear_leveling_4byte_DEFS := \
 	-DWEAR_LEVELING_LOGICAL_SIZE=16
 wear_leveling_4byte_SRC := \
 	$(wear_leveling_common_SRC) \
-	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_4byte.cpp
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_4byte.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_replay.cpp
 wear_leveling_4byte_INC := \
 	$(wear_leveling_common_INC)
 
@@ -61,6 +64,69 @@ wear_leveling_8byte_DEFS := \
 	-DWEAR_LEVELING_LOGICAL_SIZE=16
 wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
-	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_replay.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DWEAR_LEVELING_ERASE_STEP_SIZE=16 \
+	-DWEAR_LEVELING_COPY_STEP_SIZE=4
+wear_leveling_dual_bank_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_replay.cpp
+wear_leveling_dual_bank_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_batch_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=4096 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_batch_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_batch.cpp
+wear_leveling_batch_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_simulator_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_simulator_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_simulator.cpp
+wear_leveling_simulator_2byte_INC := \
+	$(wear_leveling_common_INC) \
+	$(QUANTUM_PATH)
+
+wear_leveling_simulator_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_simulator_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_simulator.cpp
+wear_leveling_simulator_4byte_INC := \
+	$(wear_leveling_common_INC) \
+	$(QUANTUM_PATH)
+
+wear_leveling_simulator_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_simulator_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_simulator.cpp
+wear_leveling_simulator_8byte_INC := \
+	$(wear_leveling_common_INC) \
+	$(QUANTUM_PATH)
@@ -3,4 +3,9 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_dual_bank \
+	wear_leveling_batch \
+	wear_leveling_simulator_2byte \
+	wear_leveling_simulator_4byte \
+	wear_leveling_simulator_8byte
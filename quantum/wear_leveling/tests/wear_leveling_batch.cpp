@@ -0,0 +1,195 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iostream>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+class WearLevelingBatch : public ::testing::Test {
+   protected:
+    logical_data_t expected;
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+    }
+
+    // Writes a value, keeping track of what should be read back
+    template <typename T>
+    wear_leveling_status_t write(std::uint32_t address, T value) {
+        memcpy(&expected[address], &value, sizeof(value));
+        return wear_leveling_write(address, &value, sizeof(value));
+    }
+
+    // Reinitialises from the backing store, verifying the contents match everything written so far
+    void expect_contents_after_init() {
+        logical_data_t actual;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(actual, expected) << "Invalid readback";
+    }
+
+    // Mimics eeconfig_init_quantum() followed by a dynamic keymap reset, as individual writes of each field
+    void write_defaults(std::uint8_t seed) {
+        EXPECT_EQ(write<std::uint16_t>(0, 0xFEE6), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint8_t>(2, 0), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint8_t>(3, seed), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint8_t>(4, 1), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint8_t>(5, seed + 1), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint8_t>(6, 0x04), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint32_t>(8, 0x00FF0301 + seed), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint16_t>(12, 0x0110 + seed), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint32_t>(16, 0x00000001), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint32_t>(20, 0x12345678 + seed), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(write<std::uint16_t>(24, 0xFEE6), WEAR_LEVELING_SUCCESS);
+        for (std::uint32_t i = 0; i < 128; ++i) {
+            std::uint16_t keycode = (i % 4 == 0) ? 0x0001 : (0x0004 + seed + i);
+            EXPECT_EQ(write<std::uint16_t>(64 + i * 2, keycode), WEAR_LEVELING_SUCCESS);
+        }
+    }
+};
+
+/**
+ * This test verifies that writes within a batch only update the cache until committed, under a single unlock.
+ */
+TEST_F(WearLevelingBatch, WritesDeferredUntilCommit) {
+    auto& inst = MockBackingStore::Instance();
+
+    wear_leveling_batch_begin();
+    EXPECT_EQ(write<std::uint8_t>(100, 0x11), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(write<std::uint32_t>(200, 0x12345678), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Batched writes should not touch the backing store";
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Batched writes should not unlock the backing store";
+
+    std::uint8_t value;
+    EXPECT_EQ(wear_leveling_read(100, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(value, 0x11) << "Batched write should be readable from the cache";
+
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_GT(inst.write_invoke_count(), 0) << "Commit should have written";
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Commit should unlock once";
+    EXPECT_EQ(inst.lock_invoke_count(), 1) << "Commit should lock once";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that adjacent writes are coalesced into a single multibyte log entry.
+ */
+TEST_F(WearLevelingBatch, AdjacentWrites_Coalesced) {
+    auto& inst = MockBackingStore::Instance();
+
+    wear_leveling_batch_begin();
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(write<std::uint8_t>(100 + i, 0x20 + i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    // One multibyte entry of 4 words, rather than 4 separate single byte entries of 2 words each
+    EXPECT_EQ(inst.write_invoke_count(), 4) << "Writes should have been coalesced";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that only the changed part of a write is logged.
+ */
+TEST_F(WearLevelingBatch, UnchangedBytes_NotLogged) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(write<std::uint64_t>(128, 0x1111111111111111), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    std::uint64_t writes = inst.write_invoke_count();
+
+    wear_leveling_batch_begin();
+    EXPECT_EQ(write<std::uint64_t>(128, 0x1111111122221111), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    // One multibyte entry of 3 words for the 2 changed bytes, rather than 7 words for all 8
+    EXPECT_EQ(inst.write_invoke_count() - writes, 3) << "Unchanged bytes should not have been logged";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that nested batches are only written when the outermost batch is committed.
+ */
+TEST_F(WearLevelingBatch, NestedBatches_CommitOutermost) {
+    auto& inst = MockBackingStore::Instance();
+
+    wear_leveling_batch_begin();
+    wear_leveling_batch_begin();
+    EXPECT_EQ(write<std::uint8_t>(100, 0x11), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Inner commit should not have written";
+    EXPECT_EQ(write<std::uint8_t>(101, 0x22), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Commit should unlock once";
+
+    // Unbalanced commits are ignored
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that more disjoint writes than tracked ranges are still all committed.
+ */
+TEST_F(WearLevelingBatch, RangesExhausted_AllWritten) {
+    wear_leveling_batch_begin();
+    for (std::uint32_t i = 0; i < WEAR_LEVELING_BATCH_RANGES * 3; ++i) {
+        EXPECT_EQ(write<std::uint8_t>((i * 37) % WEAR_LEVELING_LOGICAL_SIZE, 0x40 + i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that batches overflowing the write log are committed through consolidation.
+ */
+TEST_F(WearLevelingBatch, LargeBatches_Consolidate) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int batch = 0; batch < 4 && status == WEAR_LEVELING_SUCCESS; ++batch) {
+        wear_leveling_batch_begin();
+        for (std::uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; i += 2) {
+            EXPECT_EQ(write<std::uint16_t>(i, 0x0203 + batch + i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+        status = wear_leveling_batch_commit();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test reports the write amplification of resetting the EEPROM contents, with and without batching.
+ */
+TEST_F(WearLevelingBatch, WriteAmplification) {
+    auto& inst = MockBackingStore::Instance();
+
+    write_defaults(0x00);
+    std::uint64_t unbatched_writes  = inst.write_invoke_count();
+    std::uint64_t unbatched_unlocks = inst.unlock_invoke_count();
+    expect_contents_after_init();
+
+    SetUp();
+    wear_leveling_batch_begin();
+    write_defaults(0x00);
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    std::uint64_t batched_writes  = inst.write_invoke_count();
+    std::uint64_t batched_unlocks = inst.unlock_invoke_count();
+    expect_contents_after_init();
+
+    const std::uint64_t logical_bytes = std::count_if(expected.begin(), expected.end(), [](std::uint8_t b) { return b != 0; });
+    EXPECT_EQ(batched_unlocks, 1) << "Batch should unlock once";
+    EXPECT_LT(batched_writes, unbatched_writes) << "Batching should reduce the number of backing store writes";
+
+    std::cout << "[ BATCH    ] " << logical_bytes << " logical bytes: unbatched " << unbatched_writes * BACKING_STORE_WRITE_SIZE << " bytes in " << unbatched_unlocks << " unlocks, batched " << batched_writes * BACKING_STORE_WRITE_SIZE << " bytes in " << batched_unlocks << " unlocks" << std::endl;
+    RecordProperty("logical_bytes", (int)logical_bytes);
+    RecordProperty("unbatched_bytes", (int)(unbatched_writes * BACKING_STORE_WRITE_SIZE));
+    RecordProperty("batched_bytes", (int)(batched_writes * BACKING_STORE_WRITE_SIZE));
+}
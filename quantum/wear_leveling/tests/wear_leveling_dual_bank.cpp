@@ -0,0 +1,252 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+class WearLevelingDualBank : public ::testing::Test {
+   protected:
+    logical_data_t expected;
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+    }
+
+    // Writes a single byte, keeping track of what should be read back
+    wear_leveling_status_t write_byte(std::uint32_t address, std::uint8_t value) {
+        expected[address] = value;
+        return wear_leveling_write(address, &value, sizeof(value));
+    }
+
+    // Writes single bytes until background consolidation has been scheduled -- each of these is a 2-byte log entry
+    void write_to_threshold(std::uint8_t seed) {
+        for (int i = 0; i < WEAR_LEVELING_CONSOLIDATION_THRESHOLD / 2; ++i) {
+            EXPECT_EQ(write_byte(i % WEAR_LEVELING_LOGICAL_SIZE, seed + i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+    }
+
+    // Runs the background task until it stops making progress
+    wear_leveling_status_t run_task(int* steps = nullptr, int max_steps = 100) {
+        wear_leveling_status_t status;
+        int                    count = 0;
+        do {
+            status = wear_leveling_task();
+            ++count;
+        } while (status == WEAR_LEVELING_SUCCESS && count < max_steps);
+        if (steps) {
+            *steps = count;
+        }
+        return status;
+    }
+
+    // Reinitialises from the backing store, verifying the contents match everything written so far
+    void expect_contents_after_init() {
+        logical_data_t actual;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(actual, expected) << "Invalid readback";
+    }
+
+    // Reads back the consolidated data of a bank directly from the backing store
+    static logical_data_t bank_data(int bank) {
+        logical_data_t data;
+        auto&          inst = MockBackingStore::Instance();
+        for (std::size_t i = 0; i < data.size(); i += sizeof(backing_store_int_t)) {
+            backing_store_int_t value;
+            inst.read(bank * WEAR_LEVELING_BANK_SIZE + i, value);
+            memcpy(&data[i], &value, sizeof(value));
+        }
+        return data;
+    }
+};
+
+/**
+ * This test verifies that nothing is scheduled while the write log is below the threshold.
+ */
+TEST_F(WearLevelingDualBank, BelowThreshold_NoConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(write_byte(0x01, 0x11), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Unexpected erase";
+    EXPECT_EQ(inst.erase_range_invoke_count(), 0) << "Unexpected erase";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that passing the threshold consolidates into the other bank in small steps, without erasing within writes.
+ */
+TEST_F(WearLevelingDualBank, Threshold_ConsolidatesInBackground) {
+    auto& inst = MockBackingStore::Instance();
+
+    write_to_threshold(0x20);
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Write should not have erased";
+    EXPECT_EQ(inst.erase_range_invoke_count(), 0) << "Write should not have erased";
+
+    int steps;
+    EXPECT_EQ(run_task(&steps), WEAR_LEVELING_CONSOLIDATED) << "Task should have consolidated";
+    EXPECT_EQ(steps, (WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_COPY_STEP_SIZE) + 1) << "Unexpected number of steps";
+    EXPECT_EQ(inst.erase_range_invoke_count(), WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) << "Only the inactive bank should have been erased";
+    EXPECT_EQ(bank_data(1), expected) << "Consolidated data not written to second bank";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Nothing further should be pending";
+
+    expect_contents_after_init();
+
+    // Second round goes back to the first bank, which now has the higher sequence number
+    write_to_threshold(0x40);
+    EXPECT_EQ(run_task(), WEAR_LEVELING_CONSOLIDATED) << "Task should have consolidated";
+    EXPECT_EQ(bank_data(0), expected) << "Consolidated data not written to first bank";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that writes occurring part way through copying end up in the new bank.
+ */
+TEST_F(WearLevelingDualBank, WritesDuringCopy_Preserved) {
+    write_to_threshold(0x20);
+
+    // Erase everything and copy the first half
+    for (int i = 0; i < (WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_COPY_STEP_SIZE) / 2; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    // One write to the part already copied, one to the part still to be copied
+    EXPECT_EQ(write_byte(0x01, 0x99), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(write_byte(WEAR_LEVELING_LOGICAL_SIZE - 1, 0x98), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_EQ(run_task(), WEAR_LEVELING_CONSOLIDATED) << "Task should have consolidated";
+    expect_contents_after_init();
+
+    // The copied write lives in the new bank's write log
+    EXPECT_NE(bank_data(1)[0x01], 0x99) << "Write should not have been copied";
+}
+
+/**
+ * This test verifies that regular writes never erase in-line, so long as the task is keeping up.
+ */
+TEST_F(WearLevelingDualBank, ManyWrites_NeverEraseInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    int consolidations = 0;
+    for (int i = 0; i < 500; ++i) {
+        std::uint64_t erase_count = inst.erase_invoke_count() + inst.erase_range_invoke_count();
+        EXPECT_EQ(write_byte((i * 7) % WEAR_LEVELING_LOGICAL_SIZE, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        EXPECT_EQ(inst.erase_invoke_count() + inst.erase_range_invoke_count(), erase_count) << "Write should not have erased";
+
+        for (int j = 0; j < 2; ++j) {
+            wear_leveling_status_t status = wear_leveling_task();
+            EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Task failed";
+            consolidations += (status == WEAR_LEVELING_CONSOLIDATED) ? 1 : 0;
+        }
+    }
+
+    EXPECT_GT(consolidations, 10) << "Expected repeated consolidation";
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that a full write log completes consolidation in-line if the task has not been run.
+ */
+TEST_F(WearLevelingDualBank, LogFull_ConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    int                    writes = 0;
+    while (status == WEAR_LEVELING_SUCCESS && writes < 100) {
+        status = write_byte(writes % WEAR_LEVELING_LOGICAL_SIZE, writes + 1);
+        ++writes;
+    }
+
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write should have consolidated";
+    EXPECT_EQ(writes, (WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START) / 2) << "Consolidated before the log was full";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Only the inactive bank should have been erased";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Nothing further should be pending";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that a write which fills the log part way through background copying isn't lost to the stale copy in the new bank.
+ */
+TEST_F(WearLevelingDualBank, LogFullDuringCopy_WritePreserved) {
+    write_to_threshold(0x20);
+
+    // Erase everything and copy the first half, which includes address 0
+    for (int i = 0; i < (WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_COPY_STEP_SIZE) / 2; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (std::uint8_t value = 1; status == WEAR_LEVELING_SUCCESS && value < 100; ++value) {
+        status = write_byte(0, value);
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write should have consolidated";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that a batch which fills the log part way through background copying isn't lost to the stale copy in the new bank.
+ */
+TEST_F(WearLevelingDualBank, BatchLogFullDuringCopy_WritesPreserved) {
+    write_to_threshold(0x20);
+
+    // Erase everything and copy the first half
+    for (int i = 0; i < (WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_ERASE_STEP_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_COPY_STEP_SIZE) / 2; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    // The log fills at the end of the first range, which has already been copied, with further ranges following it
+    wear_leveling_batch_begin();
+    for (std::uint32_t address = 0; address < WEAR_LEVELING_LOGICAL_SIZE / 2; ++address) {
+        EXPECT_EQ(write_byte(address, 0x80 + address), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    for (std::uint32_t address = WEAR_LEVELING_LOGICAL_SIZE / 2 + 2; address < WEAR_LEVELING_LOGICAL_SIZE; address += 2) {
+        EXPECT_EQ(write_byte(address, 0x80 + address), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_batch_commit(), WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+
+    expect_contents_after_init();
+}
+
+/**
+ * This test verifies that power loss at any point during consolidation leaves the latest data intact, for both a clean
+ * store, one where only the active bank has been committed, and one where the inactive bank holds an older committed copy.
+ */
+TEST_F(WearLevelingDualBank, PowerLossDuringConsolidation_DataIntact) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (int generation = 0; generation < 3; ++generation) {
+        bool interrupted  = false;
+        bool consolidated = false;
+        for (std::uint64_t budget = 0; !consolidated; ++budget) {
+            SetUp();
+            for (int i = 0; i < generation; ++i) {
+                write_to_threshold(0x10 + i * 0x08);
+                EXPECT_EQ(run_task(), WEAR_LEVELING_CONSOLIDATED) << "Task should have consolidated";
+            }
+            write_to_threshold(0x30);
+
+            inst.set_power_loss_after(budget);
+            wear_leveling_status_t status = run_task();
+            inst.power_cycle();
+
+            consolidated = (status == WEAR_LEVELING_CONSOLIDATED);
+            interrupted |= (status == WEAR_LEVELING_FAILED);
+            expect_contents_after_init();
+
+            // Init finds the write log past the threshold again, and redoes the interrupted consolidation
+            EXPECT_EQ(run_task(), consolidated ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_CONSOLIDATED) << "Unexpected task status after power loss, budget " << budget;
+            EXPECT_EQ(write_byte(0x0F, 0x77), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+            expect_contents_after_init();
+        }
+        EXPECT_TRUE(interrupted) << "Power loss was never simulated";
+    }
+}
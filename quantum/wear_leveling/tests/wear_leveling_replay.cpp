@@ -0,0 +1,59 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingReplay : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // Performs alternating single byte writes, returning the number of writes before consolidation occurred
+    static int write_until_consolidated(int max_writes) {
+        for (int i = 0; i < max_writes; ++i) {
+            std::uint8_t value = (i % 2) + 1;
+            if (wear_leveling_write(0, &value, sizeof(value)) == WEAR_LEVELING_CONSOLIDATED) {
+                return i;
+            }
+        }
+        return max_writes;
+    }
+};
+
+/**
+ * This test verifies that the number of backing store reads during boot is bounded by the size of the write log in use
+ * rather than the number of entries in it, and reports the cost of replaying a full write log.
+ */
+TEST_F(WearLevelingReplay, FullLog_BoundedReads) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Work out how many writes fill the log, then fill it up to one entry short of consolidation
+    int writes = write_until_consolidated(WEAR_LEVELING_BACKING_SIZE);
+    ASSERT_LT(writes, WEAR_LEVELING_BACKING_SIZE) << "Never consolidated";
+    SetUp();
+    EXPECT_EQ(write_until_consolidated(writes), writes) << "Unexpected consolidation";
+
+    std::uint64_t reads = inst.read_invoke_count();
+    std::uint64_t bytes = inst.read_byte_count();
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status";
+    reads = inst.read_invoke_count() - reads;
+    bytes = inst.read_byte_count() - bytes;
+
+    std::uint8_t value;
+    EXPECT_EQ(wear_leveling_read(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(value, ((writes - 1) % 2) + 1) << "Invalid readback";
+
+    // Consolidated data and its header take a handful of reads, the rest is the write log in blocks
+    const std::uint64_t log_size = WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START;
+    EXPECT_LE(reads, 10 + (log_size + WEAR_LEVELING_PLAYBACK_BUFFER_SIZE - 1) / WEAR_LEVELING_PLAYBACK_BUFFER_SIZE) << "Too many backing store reads";
+
+    std::cout << "[ REPLAY   ] " << WEAR_LEVELING_BACKING_SIZE << " byte backing store, " << writes << " log entries: " << reads << " reads, " << bytes << " bytes" << std::endl;
+    RecordProperty("backing_size", WEAR_LEVELING_BACKING_SIZE);
+    RecordProperty("log_entries", writes);
+    RecordProperty("replay_reads", (int)reads);
+    RecordProperty("replay_bytes", (int)bytes);
+}
@@ -0,0 +1,223 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+// Erase granularity of the simulated flash, used for the per-sector erase counts
+#ifndef WEAR_LEVELING_SIMULATOR_SECTOR_SIZE
+#    define WEAR_LEVELING_SIMULATOR_SECTOR_SIZE 1024
+#endif
+
+// Rated erase cycles of the simulated flash, used for the projected lifetime
+#ifndef WEAR_LEVELING_SIMULATOR_ENDURANCE
+#    define WEAR_LEVELING_SIMULATOR_ENDURANCE 10000
+#endif
+
+// Dynamic keymap layout of a typical 60% VIA board -- 4 layers of 5x15, with the macro buffer filling the rest
+#define SIMULATOR_KEYMAP_ADDR 64
+#define SIMULATOR_KEYMAP_SIZE (4 * 5 * 15 * 2)
+#define SIMULATOR_MACRO_ADDR (SIMULATOR_KEYMAP_ADDR + SIMULATOR_KEYMAP_SIZE)
+#define SIMULATOR_MACRO_SIZE (WEAR_LEVELING_LOGICAL_SIZE - SIMULATOR_MACRO_ADDR)
+// Payload of a single VIA buffer write
+#define SIMULATOR_VIA_CHUNK_SIZE 28
+
+static_assert(SIMULATOR_MACRO_ADDR + 64 <= WEAR_LEVELING_LOGICAL_SIZE, "Logical size too small for the simulated workloads");
+static_assert((WEAR_LEVELING_BACKING_SIZE) % (WEAR_LEVELING_SIMULATOR_SECTOR_SIZE) == 0, "Backing size must be a multiple of the sector size");
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+/**
+ * Replays typical EEPROM workloads against the wear-leveling algorithm, reporting the resulting flash wear.
+ *
+ * Build with different BACKING_STORE_WRITE_SIZE, WEAR_LEVELING_BACKING_SIZE and WEAR_LEVELING_LOGICAL_SIZE values to
+ * compare configurations -- see the wear_leveling_simulator_* targets.
+ */
+class WearLevelingSimulator : public ::testing::Test {
+   protected:
+    logical_data_t expected;
+    std::mt19937   rng;
+    std::uint64_t  logical_writes;
+    std::uint64_t  consolidations;
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+        rng.seed(0x514D4B);
+        logical_writes = 0;
+        consolidations = 0;
+    }
+
+    void track(wear_leveling_status_t status) {
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write failed";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            ++consolidations;
+        }
+    }
+
+    // Equivalent of eeprom_update_block()
+    void write(std::uint32_t address, const void* value, std::size_t length) {
+        memcpy(&expected[address], value, length);
+        track(wear_leveling_write(address, value, length));
+        ++logical_writes;
+    }
+
+    // Equivalent of a series of VIA buffer writes, each being batched by dynamic_keymap_set_buffer()
+    void via_write(std::uint32_t address, const std::uint8_t* data, std::size_t length) {
+        for (std::size_t offset = 0; offset < length; offset += SIMULATOR_VIA_CHUNK_SIZE) {
+            std::size_t chunk = std::min<std::size_t>(SIMULATOR_VIA_CHUNK_SIZE, length - offset);
+            wear_leveling_batch_begin();
+            for (std::size_t i = 0; i < chunk; ++i) {
+                write(address + offset + i, &data[offset + i], 1);
+            }
+            track(wear_leveling_batch_commit());
+        }
+    }
+
+    std::uint8_t random_byte(std::uint8_t min = 0, std::uint8_t max = 255) {
+        return std::uniform_int_distribution<int>(min, max)(rng);
+    }
+
+    // Reports the wear caused by the given number of workload events, projected over the flash endurance
+    void report(const char* workload, int events, double events_per_day) {
+        auto& inst = MockBackingStore::Instance();
+
+        // Contents should survive everything the workload did
+        logical_data_t actual;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(actual, expected) << "Invalid readback";
+
+        const std::size_t        elements_per_sector = WEAR_LEVELING_SIMULATOR_SECTOR_SIZE / BACKING_STORE_WRITE_SIZE;
+        std::vector<std::size_t> sector_erases(WEAR_LEVELING_BACKING_SIZE / WEAR_LEVELING_SIMULATOR_SECTOR_SIZE, 0);
+        std::size_t              index = 0;
+        for (auto it = inst.storage_begin(); it != inst.storage_end(); ++it, ++index) {
+            sector_erases[index / elements_per_sector] = std::max(sector_erases[index / elements_per_sector], it->num_erase_cycles());
+        }
+        const std::size_t max_erases = *std::max_element(sector_erases.begin(), sector_erases.end());
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2);
+        out << "[ SIM      ] " << BACKING_STORE_WRITE_SIZE << "-byte writes, " << WEAR_LEVELING_BACKING_SIZE << "/" << WEAR_LEVELING_LOGICAL_SIZE << " bytes, " << workload << ": ";
+        out << events << " events, " << logical_writes << " logical writes, ";
+        out << (double)inst.total_write_count() / logical_writes << " backing writes per logical write, ";
+        if (consolidations > 0) {
+            out << logical_writes / consolidations << " logical writes per consolidation, ";
+        } else {
+            out << "no consolidation, ";
+        }
+        out << "erases per " << WEAR_LEVELING_SIMULATOR_SECTOR_SIZE << "-byte sector [";
+        for (std::size_t i = 0; i < sector_erases.size(); ++i) {
+            out << (i ? " " : "") << sector_erases[i];
+        }
+        out << "], ";
+        if (max_erases > 0) {
+            double years = (double)events * WEAR_LEVELING_SIMULATOR_ENDURANCE / max_erases / events_per_day / 365;
+            out << "projected lifetime " << std::setprecision(1) << years << " years at " << events_per_day << " events/day";
+        } else {
+            out << "projected lifetime unbounded";
+        }
+        std::cout << out.str() << std::endl;
+
+        RecordProperty("logical_writes", (int)logical_writes);
+        RecordProperty("backing_writes", (int)inst.total_write_count());
+        RecordProperty("consolidations", (int)consolidations);
+        RecordProperty("max_sector_erases", (int)max_erases);
+    }
+
+    // A few steps of an RGB matrix setting, flushed once by eeconfig_task() after they settle
+    void rgb_tweak() {
+        std::uint8_t config[8];
+        memcpy(config, &expected[(uintptr_t)EECONFIG_RGB_MATRIX], sizeof(config));
+        config[0] |= 0x01;                  // enabled
+        config[1] = random_byte(1, 40);     // mode
+        config[2] += random_byte(1, 8) * 8; // hue
+        config[4] = random_byte(0, 255);    // value
+        write((uintptr_t)EECONFIG_RGB_MATRIX, config, sizeof(config));
+    }
+
+    // Switching the persistent default layer, e.g. between QWERTY and Colemak
+    void layer_default() {
+        std::uint8_t layer = 1 << random_byte(0, 1);
+        write((uintptr_t)EECONFIG_DEFAULT_LAYER, &layer, sizeof(layer));
+    }
+
+    // Saving a layout from the VIA configurator, where roughly one key in ten differs from what's there
+    void via_upload() {
+        std::uint8_t keymap[SIMULATOR_KEYMAP_SIZE];
+        memcpy(keymap, &expected[SIMULATOR_KEYMAP_ADDR], sizeof(keymap));
+        for (std::size_t i = 0; i < sizeof(keymap); i += 2) {
+            if (random_byte() < 26) {
+                keymap[i]     = random_byte(0x04, 0xE7);
+                keymap[i + 1] = random_byte(0, 1) ? 0x00 : 0x52;
+            }
+        }
+        via_write(SIMULATOR_KEYMAP_ADDR, keymap, sizeof(keymap));
+    }
+
+    // Recording a new dynamic macro, replacing one of the macros in the buffer
+    void dynamic_macro() {
+        std::uint8_t macro[64];
+        std::size_t  length = random_byte(16, sizeof(macro) - 1);
+        for (std::size_t i = 0; i < length; ++i) {
+            macro[i] = random_byte(0x20, 0x7E);
+        }
+        macro[length]       = 0;
+        std::uint32_t start = SIMULATOR_MACRO_ADDR + random_byte(0, 3) * ((SIMULATOR_MACRO_SIZE - sizeof(macro)) / 3);
+        via_write(start, macro, length + 1);
+    }
+};
+
+TEST_F(WearLevelingSimulator, RgbTweaks) {
+    for (int i = 0; i < 5000; ++i) {
+        rgb_tweak();
+    }
+    report("rgb tweaks", 5000, 20);
+}
+
+TEST_F(WearLevelingSimulator, LayerDefaults) {
+    for (int i = 0; i < 5000; ++i) {
+        layer_default();
+    }
+    report("layer defaults", 5000, 10);
+}
+
+TEST_F(WearLevelingSimulator, ViaUploads) {
+    for (int i = 0; i < 200; ++i) {
+        via_upload();
+    }
+    report("VIA uploads", 200, 1);
+}
+
+TEST_F(WearLevelingSimulator, DynamicMacros) {
+    for (int i = 0; i < 1000; ++i) {
+        dynamic_macro();
+    }
+    report("dynamic macros", 1000, 2);
+}
+
+TEST_F(WearLevelingSimulator, MixedDays) {
+    // Events are whole days of use
+    for (int day = 0; day < 100; ++day) {
+        for (int i = 0; i < 20; ++i) {
+            rgb_tweak();
+        }
+        for (int i = 0; i < 10; ++i) {
+            layer_default();
+        }
+        for (int i = 0; i < 2; ++i) {
+            dynamic_macro();
+        }
+        via_upload();
+    }
+    report("mixed days", 100, 1);
+}
@@ -66,7 +66,10 @@
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is read in blocks of
+                WEAR_LEVELING_PLAYBACK_BUFFER_SIZE bytes, so the number of
+                backing store reads depends on how much of the log is in use
+                rather than the number of entries.
 
         During reads:
             * Logical data is served from the cache.
@@ -76,6 +79,12 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        During batches:
+            * Writes only update the cache, and the changed byte ranges are
+                recorded -- overlapping and adjacent ranges are merged.
+            * On commit, each range is appended to the log as above, under a
+                single unlock of the backing store.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -153,7 +162,29 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Dual-bank operation:
+
+        With WEAR_LEVELING_DUAL_BANK defined, the backing store is split into
+        two banks of equal size, each laid out as above -- consolidated data,
+        then a 16-byte header, then the write log. The header consists of a
+        64-bit sequence number followed by the FNV1a_64 hash of the
+        consolidated data and the sequence number.
+
+        During initialization, the bank with a valid hash and the highest
+        sequence number is used. If neither bank is valid, the first bank's
+        write log is played back on top of zeroed data.
+
+        Once the write log passes WEAR_LEVELING_CONSOLIDATION_THRESHOLD, the
+        inactive bank is erased and the cache copied into it in small steps
+        from wear_leveling_task(). Writes to parts of the cache that have
+        already been copied are appended to the write logs of both banks. The
+        hash is written last, so the switch to the new bank is atomic -- until
+        it is complete, the active bank still holds everything.
+
+        If the write log fills up before the task has completed consolidation,
+        the remaining steps are performed within wear_leveling_write(). */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,8 +193,39 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+    struct {
+        uint8_t depth; // nesting level of wear_leveling_batch_begin()
+        uint8_t count; // number of changed ranges
+        struct {
+            uint32_t start;
+            uint32_t end;
+        } ranges[(WEAR_LEVELING_BATCH_RANGES)];
+    } batch;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    uint32_t bank_base; // start of the active bank
+    uint64_t sequence;  // sequence number of the active bank
+    struct {
+        uint8_t  state;
+        uint32_t position;      // bank offset being erased, or logical address being copied
+        uint32_t write_address; // next write log location in the inactive bank
+        uint64_t hash;          // FNV1a_64 of the data copied so far
+    } consolidation;
+#endif // WEAR_LEVELING_DUAL_BANK
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Background consolidation states.
+ */
+enum { CONSOLIDATION_IDLE, CONSOLIDATION_ERASING, CONSOLIDATION_COPYING, CONSOLIDATION_COMMITTING };
+
+#    define ACTIVE_BANK_BASE (wear_leveling.bank_base)
+#    define INACTIVE_BANK_BASE ((WEAR_LEVELING_BANK_SIZE) - wear_leveling.bank_base)
+#else
+#    define ACTIVE_BANK_BASE 0
+#endif // WEAR_LEVELING_DUAL_BANK
+#define ACTIVE_BANK_END (ACTIVE_BANK_BASE + (WEAR_LEVELING_BANK_SIZE))
+
 /**
  * Locking helper: status
  */
@@ -197,14 +259,47 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * Reads a 64-bit header value, such as the FNV1a_64 of the consolidated data, from the backing store.
+ */
+static bool wear_leveling_read_u64(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+#if BACKING_STORE_WRITE_SIZE == 2
+    bool ok = backing_store_read_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    bool ok = backing_store_read_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    bool ok = backing_store_read(address, &entry.raw64);
+#endif
+    *value = entry.raw64;
+    return ok;
+}
+
+/**
+ * Writes a 64-bit header value, such as the FNV1a_64 of the consolidated data, to the backing store.
+ */
+static bool wear_leveling_write_u64(uint32_t address, uint64_t value) {
+    write_log_entry_t entry;
+    entry.raw64 = value;
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = ACTIVE_BANK_BASE + (WEAR_LEVELING_LOG_START); // skip the header following the consolidated buffer
 }
 
+#ifndef WEAR_LEVELING_DUAL_BANK
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -220,19 +315,13 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
+        uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        uint64_t checksum;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_u64((WEAR_LEVELING_LOGICAL_SIZE), &checksum);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (checksum == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
@@ -265,27 +354,10 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_u64((WEAR_LEVELING_LOGICAL_SIZE), fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -316,7 +388,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START); // skip the FNV1a_64 of the consolidated area
 
     return status;
 }
@@ -329,13 +401,184 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= ACTIVE_BANK_END) {
         return wear_leveling_consolidate_force();
     }
 
     return WEAR_LEVELING_SUCCESS;
 }
 
+#else // WEAR_LEVELING_DUAL_BANK
+
+/**
+ * Reads the consolidated data of a bank into the cache, verifying its header.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_bank(uint32_t bank_base, bool *valid, uint64_t *sequence) {
+    uint64_t checksum;
+    if (!backing_store_read_bulk(bank_base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) || !wear_leveling_read_u64(bank_base + (WEAR_LEVELING_LOGICAL_SIZE), sequence) || !wear_leveling_read_u64(bank_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &checksum)) {
+        wl_dprintf("Failed to read from backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    expected          = fnv_64a_buf(sequence, sizeof(*sequence), expected);
+    *valid            = (checksum == expected);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Reads the consolidated data of the most recently committed bank into the cache, and makes it the active bank.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    bool     valid[2];
+    uint64_t sequence[2];
+    for (int bank = 0; bank < 2; ++bank) {
+        if (wear_leveling_read_bank(bank * (WEAR_LEVELING_BANK_SIZE), &valid[bank], &sequence[bank]) == WEAR_LEVELING_FAILED) {
+            wear_leveling_clear_cache();
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    // If neither bank has been committed, play back the first bank's write log on top of zeroes, which will cater for the completely clean MCU case.
+    int active              = (valid[1] && (!valid[0] || sequence[1] > sequence[0])) ? 1 : 0;
+    wear_leveling.bank_base = active * (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling.sequence  = valid[active] ? sequence[active] : 0;
+    if (!valid[active]) {
+        wl_dprintf("No committed bank, clearing cache\n");
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Using bank %d\n", active);
+    wear_leveling.write_address = ACTIVE_BANK_BASE + (WEAR_LEVELING_LOG_START);
+
+    // The cache holds the bank read last
+    if (active == 0 && wear_leveling_read_bank(0, &valid[0], &sequence[0]) == WEAR_LEVELING_FAILED) {
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Starts consolidation into the inactive bank, which is progressed by wear_leveling_task().
+ */
+static void wear_leveling_consolidate_begin(void) {
+    wl_dprintf("Starting consolidation into inactive bank\n");
+    wear_leveling.consolidation.state    = CONSOLIDATION_ERASING;
+    wear_leveling.consolidation.position = 0;
+}
+
+/**
+ * Performs a single step of consolidation into the inactive bank.
+ * On failure the consolidation is abandoned, and restarted from scratch the next time the write log needs it.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the inactive bank has been committed and became the active bank
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    const uint32_t target = INACTIVE_BANK_BASE;
+    bool           ok     = true;
+
+    switch (wear_leveling.consolidation.state) {
+        case CONSOLIDATION_ERASING: {
+            ok                                   = backing_store_erase_range(target + wear_leveling.consolidation.position, (WEAR_LEVELING_ERASE_STEP_SIZE));
+            wear_leveling.consolidation.position = wear_leveling.consolidation.position + (WEAR_LEVELING_ERASE_STEP_SIZE);
+            if (wear_leveling.consolidation.position >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation.state         = CONSOLIDATION_COPYING;
+                wear_leveling.consolidation.position      = 0;
+                wear_leveling.consolidation.write_address = target + (WEAR_LEVELING_LOG_START);
+                wear_leveling.consolidation.hash          = FNV1A_64_INIT;
+            }
+        } break;
+
+        case CONSOLIDATION_COPYING: {
+            const uint32_t position = wear_leveling.consolidation.position;
+            const uint32_t length   = ((WEAR_LEVELING_LOGICAL_SIZE) - position) < (WEAR_LEVELING_COPY_STEP_SIZE) ? ((WEAR_LEVELING_LOGICAL_SIZE) - position) : (WEAR_LEVELING_COPY_STEP_SIZE);
+
+            // The hash covers exactly what was written, later changes to this part of the cache go to the write log
+            ok                                   = backing_store_write_bulk(target + position, (backing_store_int_t *)&wear_leveling.cache[position], length / sizeof(backing_store_int_t));
+            wear_leveling.consolidation.hash     = fnv_64a_buf(&wear_leveling.cache[position], length, wear_leveling.consolidation.hash);
+            wear_leveling.consolidation.position = position + length;
+            if (wear_leveling.consolidation.position >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation.state = CONSOLIDATION_COMMITTING;
+            }
+        } break;
+
+        case CONSOLIDATION_COMMITTING: {
+            // The checksum is written last, so the inactive bank only becomes valid once everything else is in place
+            uint64_t sequence = wear_leveling.sequence + 1;
+            ok                = wear_leveling_write_u64(target + (WEAR_LEVELING_LOGICAL_SIZE), sequence) && wear_leveling_write_u64(target + (WEAR_LEVELING_LOGICAL_SIZE) + 8, fnv_64a_buf(&sequence, sizeof(sequence), wear_leveling.consolidation.hash));
+            if (ok) {
+                wl_dprintf("Switched to inactive bank\n");
+                wear_leveling.bank_base           = target;
+                wear_leveling.sequence            = sequence;
+                wear_leveling.write_address       = wear_leveling.consolidation.write_address;
+                wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+                return WEAR_LEVELING_CONSOLIDATED;
+            }
+        } break;
+
+        default:
+            break;
+    }
+
+    if (!ok) {
+        wl_dprintf("Failed to consolidate into inactive bank\n");
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+        return WEAR_LEVELING_FAILED;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Forces consolidation into the inactive bank to complete in-line, starting it if required.
+ * Blocks on erasure of the inactive bank if the background task hasn't already done so.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidate_begin();
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    wear_leveling_status_t      status      = WEAR_LEVELING_FAILED;
+    if (lock_status != STATUS_FAILURE) {
+        do {
+            status = wear_leveling_consolidate_step();
+        } while (status == WEAR_LEVELING_SUCCESS);
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+
+/**
+ * Schedules consolidation into the inactive bank once the write log passes the threshold.
+ * Consolidation only occurs in-line if the write log is full before the background task has completed it.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    if (wear_leveling.write_address >= ACTIVE_BANK_END) {
+        return wear_leveling_consolidate_force();
+    }
+
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address >= ACTIVE_BANK_BASE + (WEAR_LEVELING_LOG_START) + (WEAR_LEVELING_CONSOLIDATION_THRESHOLD)) {
+        wear_leveling_consolidate_begin();
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+#endif // WEAR_LEVELING_DUAL_BANK
+
 /**
  * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
  *
@@ -469,18 +712,81 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Appends logical data to the inactive bank's write log as well, if consolidation has already copied that part of the cache.
+ * A failure abandons the consolidation, as the data is still held by the active bank.
+ */
+static void wear_leveling_write_raw_inactive(uint32_t address, const void *value, size_t length) {
+    if (!(wear_leveling.consolidation.state == CONSOLIDATION_COMMITTING || (wear_leveling.consolidation.state == CONSOLIDATION_COPYING && address < wear_leveling.consolidation.position))) {
+        return;
+    }
+
+    // The inactive bank's log has received a subset of the active bank's entries since copying started, so can't be full yet
+    const uint32_t bank_base     = wear_leveling.bank_base;
+    const uint32_t write_address = wear_leveling.write_address;
+    wear_leveling.bank_base      = INACTIVE_BANK_BASE;
+    wear_leveling.write_address  = wear_leveling.consolidation.write_address;
+    wl_assert(wear_leveling.write_address - wear_leveling.bank_base <= write_address - bank_base);
+
+    wear_leveling_status_t status             = wear_leveling_write_raw(address, value, length);
+    wear_leveling.consolidation.write_address = wear_leveling.write_address;
+    wear_leveling.bank_base                   = bank_base;
+    wear_leveling.write_address               = write_address;
+
+    if (status != WEAR_LEVELING_SUCCESS) {
+        wl_dprintf("Failed to write to inactive bank, abandoning consolidation\n");
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    }
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
+/**
+ * Read-ahead buffer used during playback of the write log.
+ */
+typedef struct wear_leveling_playback_buffer_t {
+    backing_store_int_t values[(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE) / sizeof(backing_store_int_t)];
+    uint32_t            address; // backing store address of values[0]
+    uint32_t            count;   // number of values read
+} wear_leveling_playback_buffer_t;
+
+/**
+ * Reads a single value of the write log through the read-ahead buffer, refilling it with a bulk read when required.
+ * The number of backing store reads is bounded by the size of the write log rather than the number of entries.
+ */
+static bool wear_leveling_playback_read(wear_leveling_playback_buffer_t *buffer, uint32_t address, backing_store_int_t *value) {
+    if (address >= ACTIVE_BANK_END) {
+        return false;
+    }
+    if (address < buffer->address || address >= buffer->address + buffer->count * sizeof(backing_store_int_t)) {
+        uint32_t count = (ACTIVE_BANK_END - address) / sizeof(backing_store_int_t);
+        if (count > sizeof(buffer->values) / sizeof(backing_store_int_t)) {
+            count = sizeof(buffer->values) / sizeof(backing_store_int_t);
+        }
+        buffer->count = 0;
+        if (!backing_store_read_bulk(address, buffer->values, count)) {
+            return false;
+        }
+        buffer->address = address;
+        buffer->count   = count;
+    }
+    *value = buffer->values[(address - buffer->address) / sizeof(backing_store_int_t)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    wear_leveling_playback_buffer_t buffer          = {.count = 0};
+    wear_leveling_status_t          status          = WEAR_LEVELING_SUCCESS;
+    bool                            cancel_playback = false;
+    uint32_t                        address         = ACTIVE_BANK_BASE + (WEAR_LEVELING_LOG_START); // skip the header following the consolidated area
+    while (!cancel_playback && address < ACTIVE_BANK_END) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_playback_read(&buffer, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +815,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_playback_read(&buffer, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +835,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +845,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +856,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -617,6 +923,15 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+    // Any uncommitted batch is lost
+    wear_leveling.batch.depth = 0;
+    wear_leveling.batch.count = 0;
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Any consolidation in progress was interrupted, the inactive bank is erased again when required
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -660,7 +975,13 @@ wear_leveling_status_t wear_leveling_erase(void) {
     }
 
     // Perform the erase
-    bool ret = backing_store_erase();
+    bool ret                  = backing_store_erase();
+    wear_leveling.batch.count = 0;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.bank_base           = 0;
+    wear_leveling.sequence            = 0;
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DUAL_BANK
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -671,6 +992,63 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+/**
+ * Records the bytes of a write within a batch which differ from the cache, merging with existing ranges where possible.
+ */
+static void wear_leveling_batch_mark(uint32_t address, const void *value, size_t length) {
+    const uint8_t *p     = value;
+    uint32_t       start = 0;
+    uint32_t       end   = length;
+    while (p[start] == wear_leveling.cache[address + start]) {
+        ++start;
+    }
+    while (p[end - 1] == wear_leveling.cache[address + end - 1]) {
+        --end;
+    }
+    start += address;
+    end += address;
+
+#if BACKING_STORE_WRITE_SIZE == 2
+    // Keep whole words, so that the word-encoded 0/1 optimization can still apply
+    start &= ~1UL;
+    end = (end + 1) & ~1UL;
+    if (end > (WEAR_LEVELING_LOGICAL_SIZE)) {
+        end = (WEAR_LEVELING_LOGICAL_SIZE);
+    }
+#endif // BACKING_STORE_WRITE_SIZE == 2
+
+    // Absorb any overlapping or adjacent ranges
+    for (uint8_t i = 0; i < wear_leveling.batch.count;) {
+        if (wear_leveling.batch.ranges[i].start <= end && start <= wear_leveling.batch.ranges[i].end) {
+            start                         = wear_leveling.batch.ranges[i].start < start ? wear_leveling.batch.ranges[i].start : start;
+            end                           = wear_leveling.batch.ranges[i].end > end ? wear_leveling.batch.ranges[i].end : end;
+            wear_leveling.batch.ranges[i] = wear_leveling.batch.ranges[--wear_leveling.batch.count];
+        } else {
+            ++i;
+        }
+    }
+
+    // Out of ranges, merge with the closest one -- nothing lies in between, so the result can't overlap anything else
+    if (wear_leveling.batch.count == (WEAR_LEVELING_BATCH_RANGES)) {
+        uint8_t  closest = 0;
+        uint32_t gap     = UINT32_MAX;
+        for (uint8_t i = 0; i < wear_leveling.batch.count; ++i) {
+            uint32_t this_gap = wear_leveling.batch.ranges[i].start > end ? wear_leveling.batch.ranges[i].start - end : start - wear_leveling.batch.ranges[i].end;
+            if (this_gap < gap) {
+                closest = i;
+                gap     = this_gap;
+            }
+        }
+        start                               = wear_leveling.batch.ranges[closest].start < start ? wear_leveling.batch.ranges[closest].start : start;
+        end                                 = wear_leveling.batch.ranges[closest].end > end ? wear_leveling.batch.ranges[closest].end : end;
+        wear_leveling.batch.ranges[closest] = wear_leveling.batch.ranges[--wear_leveling.batch.count];
+    }
+
+    wear_leveling.batch.ranges[wear_leveling.batch.count].start = start;
+    wear_leveling.batch.ranges[wear_leveling.batch.count].end   = end;
+    wear_leveling.batch.count++;
+}
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -688,6 +1066,13 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
+    // Within a batch, only the cache is updated until it's committed
+    if (wear_leveling.batch.depth > 0) {
+        wear_leveling_batch_mark(address, value, length);
+        memcpy(&wear_leveling.cache[address], value, length);
+        return WEAR_LEVELING_SUCCESS;
+    }
+
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
@@ -702,11 +1087,22 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
+#ifdef WEAR_LEVELING_DUAL_BANK
+            // Background consolidation may have copied this part of the cache into the new bank before it was changed, so log it again there
+            if (wear_leveling_write_raw(address, value, length) == WEAR_LEVELING_FAILED) {
+                status = WEAR_LEVELING_FAILED;
+            }
+            break;
+#endif // WEAR_LEVELING_DUAL_BANK
         case WEAR_LEVELING_FAILED:
             // If the write triggered consolidation, or the write failed, then nothing else needs to occur.
             break;
 
         case WEAR_LEVELING_SUCCESS:
+#ifdef WEAR_LEVELING_DUAL_BANK
+            // Keep the inactive bank up to date if it's part way through consolidation
+            wear_leveling_write_raw_inactive(address, value, length);
+#endif // WEAR_LEVELING_DUAL_BANK
             // Consolidate the cache + write log if required
             status = wear_leveling_consolidate_if_needed();
             break;
@@ -743,6 +1139,103 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+/**
+ * Starts a batch of writes.
+ */
+void wear_leveling_batch_begin(void) {
+    wear_leveling.batch.depth++;
+}
+
+/**
+ * Commits a batch of writes, appending the changed ranges to the write log.
+ */
+wear_leveling_status_t wear_leveling_batch_commit(void) {
+    if (wear_leveling.batch.depth == 0 || --wear_leveling.batch.depth > 0 || wear_leveling.batch.count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Commit %d ranges\n", (int)wear_leveling.batch.count);
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling.batch.count = 0;
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; i < wear_leveling.batch.count; ++i) {
+        const uint32_t         address      = wear_leveling.batch.ranges[i].start;
+        const size_t           length       = wear_leveling.batch.ranges[i].end - address;
+        wear_leveling_status_t range_status = wear_leveling_write_raw(address, &wear_leveling.cache[address], length);
+#ifdef WEAR_LEVELING_DUAL_BANK
+        if (range_status == WEAR_LEVELING_CONSOLIDATED) {
+            // Background consolidation may have copied this range into the new bank before it was changed, so log it again there, and carry on with the remaining ranges
+            status       = WEAR_LEVELING_CONSOLIDATED;
+            range_status = wear_leveling_write_raw(address, &wear_leveling.cache[address], length);
+        }
+        if (range_status == WEAR_LEVELING_SUCCESS) {
+            wear_leveling_write_raw_inactive(address, &wear_leveling.cache[address], length);
+        }
+#else
+        if (range_status == WEAR_LEVELING_CONSOLIDATED) {
+            // Consolidation rewrote the whole cache, so the remaining ranges are already in place
+            status = WEAR_LEVELING_CONSOLIDATED;
+            break;
+        }
+#endif // WEAR_LEVELING_DUAL_BANK
+        if (range_status == WEAR_LEVELING_FAILED) {
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+    }
+    wear_leveling.batch.count = 0;
+
+    // Consolidate the cache + write log if required
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidate_if_needed();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Performs a single step of any pending background consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_DUAL_BANK
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
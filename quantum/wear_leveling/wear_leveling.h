@@ -52,3 +52,31 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs a single step of any pending background consolidation.
+ *
+ * Only does any work with WEAR_LEVELING_DUAL_BANK, where the inactive bank is erased and written in small steps instead
+ * of within wear_leveling_write(). Intended to be invoked regularly from the main loop.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once the inactive bank has become the active one
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Starts a batch of writes.
+ *
+ * Until the matching wear_leveling_batch_commit(), writes only update the cache and keep track of the changed ranges.
+ * Batches may be nested, in which case only the outermost commit writes to the backing store.
+ */
+void wear_leveling_batch_begin(void);
+
+/**
+ * Commits a batch of writes.
+ *
+ * Appends the changed ranges to the write log, coalescing adjacent writes into as few log entries as possible, with a
+ * single unlock of the backing store.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_batch_commit(void);
@@ -61,15 +61,67 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Each bank holds its own consolidated data, header and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+// Sequence number followed by the FNV1a_64 of the consolidated data and sequence number
+#    define WEAR_LEVELING_HEADER_SIZE 16
+
+// Number of bytes erased in the inactive bank per housekeeping step, needs to be a multiple of the erase size of the backing store.
+// Defaults to a single sector, so that each step blocks for one sector erase at most.
+#    ifndef WEAR_LEVELING_ERASE_STEP_SIZE
+#        ifdef BACKING_STORE_ERASE_SIZE
+#            define WEAR_LEVELING_ERASE_STEP_SIZE (BACKING_STORE_ERASE_SIZE)
+#        else
+#            define WEAR_LEVELING_ERASE_STEP_SIZE (WEAR_LEVELING_BANK_SIZE)
+#        endif
+#    endif
+
+// Number of bytes of consolidated data copied to the inactive bank per housekeeping step
+#    ifndef WEAR_LEVELING_COPY_STEP_SIZE
+#        define WEAR_LEVELING_COPY_STEP_SIZE 64
+#    endif
+
+// Number of bytes of write log in use before consolidation into the inactive bank is started
+#    ifndef WEAR_LEVELING_CONSOLIDATION_THRESHOLD
+#        define WEAR_LEVELING_CONSOLIDATION_THRESHOLD (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - (WEAR_LEVELING_HEADER_SIZE)) / 2)
+#    endif
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+// FNV1a_64 of the consolidated data
+#    define WEAR_LEVELING_HEADER_SIZE 8
+#endif // WEAR_LEVELING_DUAL_BANK
+
+// Number of bytes of write log read at a time during playback
+#ifndef WEAR_LEVELING_PLAYBACK_BUFFER_SIZE
+#    define WEAR_LEVELING_PLAYBACK_BUFFER_SIZE 64
+#endif
+
+// Number of separate changed ranges tracked within a batch, further ranges are merged with their closest neighbour
+#ifndef WEAR_LEVELING_BATCH_RANGES
+#    define WEAR_LEVELING_BATCH_RANGES 16
+#endif
+
+// Offset of the write log within a bank
+#define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_HEADER_SIZE))
+
 // Compile-time validation of configurable options
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback buffer size must be a multiple of write size");
+#ifdef WEAR_LEVELING_DUAL_BANK
+_Static_assert(WEAR_LEVELING_BANK_SIZE > WEAR_LEVELING_LOG_START, "Each bank must have space for a write log after the consolidated data, backing size must be more than twice the logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_ERASE_STEP_SIZE == 0, "Bank size must be a multiple of the erase step size");
+_Static_assert(WEAR_LEVELING_COPY_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Copy step size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_THRESHOLD < WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START, "Consolidation threshold must be smaller than the write log");
+#endif // WEAR_LEVELING_DUAL_BANK
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+bool backing_store_erase_range(uint32_t address, size_t length); // only required for WEAR_LEVELING_DUAL_BANK, erases whole erase units of the backing store
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
@@ -83,6 +83,35 @@ TEST_F(AutoCorrect, fales_to_false_autocorrection) {
     VERIFY_AND_CLEAR(driver);
 }
 
+// Test that typing "widht" autocorrects to "width"
+TEST_F(AutoCorrect, widht_to_width_autocorrection) {
+    TestDriver driver;
+    auto       key_w = KeymapKey(0, 0, 0, KC_W);
+    auto       key_i = KeymapKey(0, 1, 0, KC_I);
+    auto       key_d = KeymapKey(0, 2, 0, KC_D);
+    auto       key_h = KeymapKey(0, 3, 0, KC_H);
+    auto       key_t = KeymapKey(0, 4, 0, KC_T);
+
+    set_keymap({key_w, key_i, key_d, key_h, key_t});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_W)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_I)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_D)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_T)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+    }
+
+    TapKeys(key_w, key_i, key_d, key_h, key_t);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
 // Test that typing "fales" doesn't autocorrect if disabled
 TEST_F(AutoCorrect, fales_disabled_autocorrect) {
     TestDriver driver;
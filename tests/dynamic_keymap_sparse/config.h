@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// 32 layers in the space that 8 dense layers would take up
+#define TRANSIENT_EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_LAYER_COUNT 32
+#define DYNAMIC_KEYMAP_SPARSE
+#define DYNAMIC_KEYMAP_SPARSE_KEY_COUNT 240
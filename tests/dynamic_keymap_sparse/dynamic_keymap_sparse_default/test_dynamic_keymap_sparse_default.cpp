@@ -0,0 +1,45 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "keymap_introspection.h"
+}
+
+#define KEYS_PER_LAYER (MATRIX_ROWS * MATRIX_COLS)
+
+class DynamicKeymapSparseDefault : public TestFixture {};
+
+TEST_F(DynamicKeymapSparseDefault, DefaultPoolHoldsFlashKeymap) {
+    EXPECT_GE(DYNAMIC_KEYMAP_SPARSE_KEY_COUNT, std::min<int>(keymap_layer_count(), DYNAMIC_KEYMAP_LAYER_COUNT) * KEYS_PER_LAYER);
+
+    // Every KC_NO of the test keymap is stored, rather than dropped and read back as transparent
+    dynamic_keymap_reset();
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; ++layer) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t column = 0; column < MATRIX_COLS; ++column) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), keycode_at_keymap_location_raw(layer, row, column)) << "Mismatch at layer " << (int)layer << ", row " << (int)row << ", column " << (int)column;
+            }
+        }
+    }
+}
+
+TEST_F(DynamicKeymapSparseDefault, DefaultPoolHoldsFullLayers) {
+    // Every key of every layer, as with a fully populated keymap of the default layer count
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; ++layer) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t column = 0; column < MATRIX_COLS; ++column) {
+                dynamic_keymap_set_keycode(layer, row, column, KC_A + layer);
+            }
+        }
+    }
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; ++layer) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t column = 0; column < MATRIX_COLS; ++column) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), KC_A + layer);
+            }
+        }
+    }
+}
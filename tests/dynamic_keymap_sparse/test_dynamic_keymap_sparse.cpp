@@ -0,0 +1,159 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "eeprom.h"
+}
+
+#define KEYS_PER_LAYER (MATRIX_ROWS * MATRIX_COLS)
+#define KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER)
+#define BITMAP_SIZE ((KEYS_PER_LAYER + 7) / 8)
+
+class DynamicKeymapSparse : public TestFixture {
+   protected:
+    std::vector<uint16_t> expected;
+    std::mt19937          rng;
+
+    void SetUp() override {
+        dynamic_keymap_reset();
+        // The test keymap has a single layer of KC_NO
+        expected.assign(KEY_COUNT, KC_TRANSPARENT);
+        std::fill(expected.begin(), expected.begin() + KEYS_PER_LAYER, KC_NO);
+        rng.seed(0x514D4B);
+    }
+
+    std::size_t stored_keys() {
+        return std::count_if(expected.begin(), expected.end(), [](uint16_t keycode) { return keycode != KC_TRANSPARENT; });
+    }
+
+    // Sets a key, keeping track of what should be read back, unless the pool is already full
+    void set(std::size_t key, uint16_t keycode) {
+        if (keycode == KC_TRANSPARENT || expected[key] != KC_TRANSPARENT || stored_keys() < DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+            expected[key] = keycode;
+        }
+        dynamic_keymap_set_keycode(key / KEYS_PER_LAYER, (key % KEYS_PER_LAYER) / MATRIX_COLS, key % MATRIX_COLS, keycode);
+    }
+
+    uint16_t random_keycode() {
+        return std::uniform_int_distribution<int>(KC_A, KC_RIGHT_GUI)(rng);
+    }
+
+    // The keymap in the layout used by VIA
+    std::vector<uint8_t> dense() {
+        std::vector<uint8_t> data;
+        for (uint16_t keycode : expected) {
+            data.push_back(keycode >> 8);
+            data.push_back(keycode & 0xFF);
+        }
+        return data;
+    }
+
+    void expect_keymap() {
+        for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+            ASSERT_EQ(dynamic_keymap_get_keycode(key / KEYS_PER_LAYER, (key % KEYS_PER_LAYER) / MATRIX_COLS, key % MATRIX_COLS), expected[key]) << "Mismatch at key " << key;
+        }
+    }
+
+    // Decodes the bitmaps and keycode pool straight from EEPROM
+    void expect_eeprom_contents() {
+        const uint8_t* bitmaps = (const uint8_t*)EECONFIG_SIZE;
+        const uint8_t* pool    = bitmaps + (DYNAMIC_KEYMAP_LAYER_COUNT * BITMAP_SIZE);
+        std::size_t    index   = 0;
+        for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+            std::size_t bit    = key % KEYS_PER_LAYER;
+            bool        stored = eeprom_read_byte(bitmaps + (key / KEYS_PER_LAYER) * BITMAP_SIZE + bit / 8) & (1 << (bit % 8));
+            ASSERT_EQ(stored, expected[key] != KC_TRANSPARENT) << "Bitmap mismatch at key " << key;
+            if (stored) {
+                uint16_t keycode = eeprom_read_byte(pool + index * 2) << 8 | eeprom_read_byte(pool + index * 2 + 1);
+                ASSERT_EQ(keycode, expected[key]) << "Pool mismatch at key " << key;
+                ++index;
+            }
+        }
+    }
+};
+
+TEST_F(DynamicKeymapSparse, Reset_StoresOnlyNonTransparentKeys) {
+    EXPECT_EQ(dynamic_keymap_get_layer_count(), 32);
+    expect_keymap();
+    expect_eeprom_contents();
+    EXPECT_EQ(dynamic_keymap_key_to_eeprom_address(1, 0, 0), nullptr) << "Transparent keys should not be stored";
+}
+
+TEST_F(DynamicKeymapSparse, RandomEdits_MatchDenseModel) {
+    for (int i = 0; i < 2000; ++i) {
+        // Mostly the lower layers, with the higher ones only ever partially filled
+        std::size_t layer = std::min<int>(std::geometric_distribution<int>(0.3)(rng), DYNAMIC_KEYMAP_LAYER_COUNT - 1);
+        std::size_t key   = layer * KEYS_PER_LAYER + std::uniform_int_distribution<int>(0, KEYS_PER_LAYER - 1)(rng);
+        set(key, std::uniform_int_distribution<int>(0, 9)(rng) < 4 ? KC_TRANSPARENT : random_keycode());
+        if (i % 100 == 0) {
+            expect_keymap();
+        }
+    }
+    expect_keymap();
+    expect_eeprom_contents();
+}
+
+TEST_F(DynamicKeymapSparse, ViaBuffer_RoundTrip) {
+    // Layers 0, 2 and 31 fully populated, everything else transparent
+    for (std::size_t layer : {0, 2, 31}) {
+        for (std::size_t i = 0; i < KEYS_PER_LAYER; ++i) {
+            expected[layer * KEYS_PER_LAYER + i] = random_keycode();
+        }
+    }
+    std::vector<uint8_t> data = dense();
+
+    for (std::size_t offset = 0; offset < data.size(); offset += 28) {
+        uint16_t size = std::min<std::size_t>(28, data.size() - offset);
+        dynamic_keymap_set_buffer(offset, size, &data[offset]);
+    }
+    expect_keymap();
+    expect_eeprom_contents();
+
+    std::vector<uint8_t> readback(data.size() + 8, 0xAA);
+    for (std::size_t offset = 0; offset < readback.size(); offset += 28) {
+        uint16_t size = std::min<std::size_t>(28, readback.size() - offset);
+        dynamic_keymap_get_buffer(offset, size, &readback[offset]);
+    }
+    EXPECT_EQ(std::vector<uint8_t>(readback.begin(), readback.begin() + data.size()), data);
+    EXPECT_EQ(std::vector<uint8_t>(readback.begin() + data.size(), readback.end()), std::vector<uint8_t>(8, 0x00)) << "Past the end should read as zero";
+}
+
+TEST_F(DynamicKeymapSparse, ViaBuffer_UnalignedWrite) {
+    // Low byte of one key, both bytes of the next, high byte of the one after
+    uint8_t data[] = {0x04, 0x00, 0x05, 0x00};
+    dynamic_keymap_set_buffer(KEYS_PER_LAYER * 2 + 1, sizeof(data), data);
+    expected[KEYS_PER_LAYER]     = 0x0004;
+    expected[KEYS_PER_LAYER + 1] = 0x0005;
+    expected[KEYS_PER_LAYER + 2] = 0x0001;
+    expect_keymap();
+    expect_eeprom_contents();
+
+    uint8_t readback[sizeof(data)];
+    dynamic_keymap_get_buffer(KEYS_PER_LAYER * 2 + 1, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, data, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymapSparse, Full_WritesIgnored) {
+    std::size_t key = KEYS_PER_LAYER;
+    while (stored_keys() < DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+        set(key++, random_keycode());
+    }
+
+    // No room for another key, but replacing a stored one is fine
+    set(key, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(key / KEYS_PER_LAYER, (key % KEYS_PER_LAYER) / MATRIX_COLS, key % MATRIX_COLS), KC_TRANSPARENT);
+    set(key - 1, KC_B);
+
+    // Making a key transparent frees up space
+    set(0, KC_TRANSPARENT);
+    set(key, KC_A);
+    EXPECT_EQ(expected[key], KC_A);
+    expect_keymap();
+    expect_eeprom_contents();
+}
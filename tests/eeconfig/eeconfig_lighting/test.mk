@@ -0,0 +1,8 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+BACKLIGHT_ENABLE = yes
+BACKLIGHT_DRIVER = custom
+
+RGBLIGHT_ENABLE = yes
+RGBLIGHT_DRIVER = custom
@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// the lighting headers are C, which spells static_assert differently
+#define _Static_assert static_assert
+#include "test_common.hpp"
+#undef _Static_assert
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+void backlight_init_ports(void) {}
+void backlight_set(uint8_t level) {}
+void backlight_task(void) {}
+void rgblight_set(void) {}
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {}
+
+static void flush_nothing(void) {}
+}
+
+class EeconfigLighting : public TestFixture {
+   public:
+    void SetUp() override {
+        // Start each test from a known flush time, far enough back not to hold up the next one
+        eeconfig_update_deferred(flush_nothing);
+        eeconfig_flush();
+        advance_time(EECONFIG_FLUSH_MIN_INTERVAL);
+    }
+};
+
+TEST_F(EeconfigLighting, BacklightNoEepromChangeNotPersisted) {
+    backlight_level(1);
+    backlight_level_noeeprom(2);
+    EXPECT_EQ(get_backlight_level(), 2);
+
+    advance_time(EECONFIG_FLUSH_DELAY + 1);
+    eeconfig_task();
+    EXPECT_FALSE(eeconfig_has_pending());
+
+    backlight_config_t saved = {.raw = eeconfig_read_backlight()};
+    EXPECT_EQ(saved.level, 1);
+}
+
+TEST_F(EeconfigLighting, RgblightNoEepromChangeNotPersisted) {
+    rgblight_enable_noeeprom();
+    rgblight_sethsv(10, 20, 30);
+    rgblight_sethsv_noeeprom(40, 50, 60);
+    EXPECT_EQ(rgblight_get_hue(), 40);
+
+    advance_time(EECONFIG_FLUSH_DELAY + 1);
+    eeconfig_task();
+    EXPECT_FALSE(eeconfig_has_pending());
+
+    rgblight_config_t saved = {.raw = eeconfig_read_rgblight()};
+    EXPECT_EQ(saved.hue, 10);
+    EXPECT_EQ(saved.sat, 20);
+    EXPECT_EQ(saved.val, 30);
+}
+
+TEST_F(EeconfigLighting, ImmediateWriteSupersedesDeferred) {
+    rgblight_enable_noeeprom();
+    rgblight_sethsv(10, 20, 30);
+    rgblight_sethsv_noeeprom(40, 50, 60);
+    eeconfig_update_rgblight_current();
+
+    advance_time(EECONFIG_FLUSH_DELAY + 1);
+    eeconfig_task();
+
+    rgblight_config_t saved = {.raw = eeconfig_read_rgblight()};
+    EXPECT_EQ(saved.hue, 40);
+}
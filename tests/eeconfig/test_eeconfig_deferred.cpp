@@ -0,0 +1,132 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+static int flush_a_count = 0;
+static int flush_b_count = 0;
+
+static void flush_a(void) {
+    flush_a_count++;
+}
+
+static void flush_b(void) {
+    flush_b_count++;
+}
+}
+
+class EeconfigDeferred : public TestFixture {
+   public:
+    void SetUp() override {
+        // Start each test from a known flush time, far enough back not to hold up the next one
+        eeconfig_update_deferred(flush_a);
+        eeconfig_flush();
+        advance_time(EECONFIG_FLUSH_MIN_INTERVAL);
+        flush_a_count = 0;
+        flush_b_count = 0;
+    }
+};
+
+TEST_F(EeconfigDeferred, RepeatedChangesAreCombined) {
+    TestDriver driver;
+
+    for (int i = 0; i < 10; i++) {
+        eeconfig_update_deferred(flush_a);
+        idle_for(EECONFIG_FLUSH_DELAY / 2);
+    }
+    EXPECT_EQ(flush_a_count, 0);
+    EXPECT_TRUE(eeconfig_has_pending());
+
+    idle_for(EECONFIG_FLUSH_DELAY);
+    EXPECT_EQ(flush_a_count, 1);
+    EXPECT_FALSE(eeconfig_has_pending());
+}
+
+TEST_F(EeconfigDeferred, FeaturesAreFlushedTogether) {
+    TestDriver driver;
+
+    eeconfig_update_deferred(flush_a);
+    idle_for(EECONFIG_FLUSH_DELAY / 2);
+    eeconfig_update_deferred(flush_b);
+    idle_for(EECONFIG_FLUSH_DELAY / 2 + 1);
+    EXPECT_EQ(flush_a_count, 0);
+
+    idle_for(EECONFIG_FLUSH_DELAY / 2);
+    EXPECT_EQ(flush_a_count, 1);
+    EXPECT_EQ(flush_b_count, 1);
+}
+
+TEST_F(EeconfigDeferred, ContinuousChangesFlushAfterMaxDelay) {
+    TestDriver driver;
+
+    for (int i = 0; i < EECONFIG_FLUSH_MAX_DELAY / 100 - 1; i++) {
+        eeconfig_update_deferred(flush_a);
+        idle_for(100);
+    }
+    EXPECT_EQ(flush_a_count, 0);
+
+    eeconfig_update_deferred(flush_a);
+    idle_for(200);
+    EXPECT_EQ(flush_a_count, 1);
+}
+
+TEST_F(EeconfigDeferred, FlushesAreRateLimited) {
+    TestDriver driver;
+
+    eeconfig_update_deferred(flush_a);
+    idle_for(EECONFIG_FLUSH_DELAY + 1);
+    EXPECT_EQ(flush_a_count, 1);
+
+    // Settles again well before the minimum interval is up
+    eeconfig_update_deferred(flush_a);
+    idle_for(EECONFIG_FLUSH_MIN_INTERVAL - 1);
+    EXPECT_EQ(flush_a_count, 1);
+
+    idle_for(2);
+    EXPECT_EQ(flush_a_count, 2);
+}
+
+TEST_F(EeconfigDeferred, ExplicitFlushIsImmediate) {
+    eeconfig_update_deferred(flush_a);
+    eeconfig_flush();
+    EXPECT_EQ(flush_a_count, 1);
+    EXPECT_FALSE(eeconfig_has_pending());
+}
+
+TEST_F(EeconfigDeferred, ResetDiscardsPending) {
+    TestDriver driver;
+
+    eeconfig_update_deferred(flush_a);
+    eeconfig_init_quantum();
+    EXPECT_FALSE(eeconfig_has_pending());
+    idle_for(EECONFIG_FLUSH_MAX_DELAY);
+    EXPECT_EQ(flush_a_count, 0);
+}
+
+TEST_F(EeconfigDeferred, KeycodeTogglesWriteOnce) {
+    TestDriver driver;
+    auto       key_toggle = KeymapKey(0, 0, 0, QK_AUTOCORRECT_TOGGLE);
+    set_keymap({key_toggle});
+
+    uint16_t initial = eeconfig_read_keymap();
+    bool     enabled = keymap_config.autocorrect_enable;
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 5; i++) {
+        tap_key(key_toggle);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // Persisted setting only catches up once things settle
+    EXPECT_NE(keymap_config.autocorrect_enable, enabled);
+    EXPECT_EQ(eeconfig_read_keymap(), initial);
+
+    idle_for(EECONFIG_FLUSH_DELAY + 1);
+    EXPECT_EQ(eeconfig_read_keymap(), keymap_config.raw);
+    EXPECT_FALSE(eeconfig_has_pending());
+}
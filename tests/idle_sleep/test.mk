@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+IDLE_SLEEP_ENABLE = yes
+DEFERRED_EXEC_ENABLE = yes
@@ -0,0 +1,116 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "deferred_exec.h"
+#include "idle_sleep.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class IdleSleep : public TestFixture {
+   protected:
+    uint32_t slept_ms = 0;
+
+    // Mirrors the main loop: a pass that doesn't sleep takes one millisecond
+    void run_main_loop_for(uint32_t duration_ms) {
+        uint32_t start = timer_read32();
+        while (timer_elapsed32(start) < duration_ms) {
+            keyboard_task();
+            deferred_exec_task();
+
+            uint32_t before = timer_read32();
+            idle_sleep_task();
+            uint32_t slept = timer_elapsed32(before);
+            if (slept > 0) {
+                slept_ms += slept;
+            } else {
+                advance_time(1);
+            }
+        }
+    }
+};
+
+TEST_F(IdleSleep, SleepsBetweenScansWhenIdle) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_main_loop_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    // Every pass but the scan itself is spent asleep
+    EXPECT_GE(slept_ms, 1000 * (IDLE_SLEEP_SCAN_INTERVAL - 1) / IDLE_SLEEP_SCAN_INTERVAL);
+    EXPECT_LE(slept_ms, 1000);
+}
+
+TEST_F(IdleSleep, HeldKeyKeepsScanning) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_main_loop_for(500);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slept_ms, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+static uint32_t fired_at    = 0;
+static uint32_t fired_count = 0;
+
+static uint32_t record_fire(uint32_t trigger_time, void *cb_arg) {
+    fired_at = timer_read32();
+    fired_count++;
+    return 0;
+}
+
+TEST_F(IdleSleep, DeferredExecutorBoundsSleep) {
+    TestDriver driver;
+    fired_at    = 0;
+    fired_count = 0;
+
+    // Deliberately not a multiple of the scan interval
+    uint32_t       start = timer_read32();
+    deferred_token token = defer_exec(123, record_fire, NULL);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    EXPECT_NO_REPORT(driver);
+    run_main_loop_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(fired_count, 1);
+    EXPECT_EQ(fired_at, start + 123);
+    EXPECT_GT(slept_ms, 0);
+}
+
+TEST_F(IdleSleep, WakeEndsSleep) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    // A wake while the main loop is running ends the next sleep straight away
+    keyboard_task();
+    idle_sleep_wake();
+    uint32_t before = timer_read32();
+    idle_sleep_task();
+    EXPECT_EQ(timer_elapsed32(before), 0);
+
+    // Only the once
+    keyboard_task();
+    before = timer_read32();
+    idle_sleep_task();
+    EXPECT_EQ(timer_elapsed32(before), IDLE_SLEEP_SCAN_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,97 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "flash_mock.hpp"
+
+extern "C" {
+#include "flash_spi.h"
+#include "qp_stream.h"
+}
+
+FlashMock::FlashMock() {
+    file = std::tmpfile();
+    reset();
+}
+
+FlashMock::~FlashMock() {
+    std::fclose(file);
+}
+
+void FlashMock::reset() {
+    std::vector<std::uint8_t> blank(EXTERNAL_FLASH_SIZE, 0xFF);
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(blank.data(), 1, blank.size(), file);
+    std::fflush(file);
+    read_count = 0;
+    read_bytes = 0;
+    fail_read  = -1;
+}
+
+void FlashMock::poke(std::uint32_t address, const void* data, std::size_t length) {
+    std::fseek(file, address, SEEK_SET);
+    std::fwrite(data, 1, length, file);
+    std::fflush(file);
+}
+
+std::uint32_t FlashMock::write_asset_index(std::uint32_t address, const std::vector<std::vector<std::uint8_t>>& assets) {
+    qp_flash_asset_index_v1_t index = {
+        .magic           = QP_FLASH_ASSET_INDEX_MAGIC,
+        .version         = 0x01,
+        .asset_count     = (std::uint16_t)assets.size(),
+        .neg_asset_count = (std::uint16_t)~assets.size(),
+    };
+    poke(address, &index, sizeof(index));
+
+    // Assets are placed straight after the index
+    std::uint32_t offset = sizeof(index) + assets.size() * sizeof(qp_flash_asset_entry_v1_t);
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        qp_flash_asset_entry_v1_t entry = {.offset = offset, .length = (std::uint32_t)assets[i].size()};
+        poke(address + sizeof(index) + i * sizeof(entry), &entry, sizeof(entry));
+        poke(address + offset, assets[i].data(), assets[i].size());
+        offset += assets[i].size();
+    }
+    return offset;
+}
+
+bool FlashMock::read(std::uint32_t address, void* data, std::size_t length) {
+    if (address + length > EXTERNAL_FLASH_SIZE || fail_read-- == 0) {
+        return false;
+    }
+    ++read_count;
+    read_bytes += length;
+    std::fseek(file, address, SEEK_SET);
+    return std::fread(data, 1, length, file) == length;
+}
+
+bool FlashMock::write(std::uint32_t address, const void* data, std::size_t length) {
+    if (address + length > EXTERNAL_FLASH_SIZE) {
+        return false;
+    }
+    // NOR flash can only clear bits
+    std::vector<std::uint8_t> current(length);
+    std::fseek(file, address, SEEK_SET);
+    std::fread(current.data(), 1, length, file);
+    for (std::size_t i = 0; i < length; ++i) {
+        current[i] &= ((const std::uint8_t*)data)[i];
+    }
+    poke(address, current.data(), length);
+    return true;
+}
+
+extern "C" {
+
+void flash_init(void) {}
+
+flash_status_t flash_erase_chip(void) {
+    FlashMock::Instance().reset();
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_read_block(uint32_t addr, void* buf, size_t len) {
+    return FlashMock::Instance().read(addr, buf, len) ? FLASH_STATUS_SUCCESS : FLASH_STATUS_BAD_ADDRESS;
+}
+
+flash_status_t flash_write_block(uint32_t addr, const void* buf, size_t len) {
+    return FlashMock::Instance().write(addr, buf, len) ? FLASH_STATUS_SUCCESS : FLASH_STATUS_BAD_ADDRESS;
+}
+}
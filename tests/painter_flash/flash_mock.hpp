@@ -0,0 +1,44 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * External NOR flash backed by a temporary file, standing in for flash_spi.c.
+ */
+class FlashMock {
+   public:
+    static FlashMock& Instance() {
+        static FlashMock instance;
+        return instance;
+    }
+
+    // Erases everything and resets the transaction counters
+    void reset();
+
+    // Places data directly into the flash, bypassing the counters
+    void poke(std::uint32_t address, const void* data, std::size_t length);
+
+    // Builds an asset index at the given address out of the supplied assets, returning the index size
+    std::uint32_t write_asset_index(std::uint32_t address, const std::vector<std::vector<std::uint8_t>>& assets);
+
+    // Backing for flash_read_block() and flash_write_block()
+    bool read(std::uint32_t address, void* data, std::size_t length);
+    bool write(std::uint32_t address, const void* data, std::size_t length);
+
+    std::uint64_t read_count = 0;
+    std::uint64_t read_bytes = 0;
+
+    // Index of the next read to fail, counting from zero, or negative for none
+    std::int64_t fail_read = -1;
+
+   private:
+    FlashMock();
+    ~FlashMock();
+
+    std::FILE* file = nullptr;
+};
@@ -0,0 +1,37 @@
+// Copyright 2022 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `qmk painter-convert-graphics -i ghoul-name.png -f mono4`
+
+#include <qp.h>
+
+const uint32_t gfx_ghoul_name_length = 371;
+
+// clang-format off
+const uint8_t gfx_ghoul_name[371] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0x73, 0x01, 0x00, 0x00, 0x8C, 0xFE, 0xFF,
+    0xFF, 0x16, 0x00, 0x44, 0x00, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xE8, 0x03, 0x05, 0xFA, 0x43, 0x01, 0x00,
+    0x0F, 0x00, 0x81, 0xA0, 0x02, 0x04, 0x00, 0x81, 0x3F, 0x54, 0x03, 0x55, 0x81, 0xF5, 0x83, 0x04,
+    0xFF, 0x81, 0x3F, 0xF8, 0x04, 0xFF, 0x80, 0x83, 0x04, 0xFF, 0x81, 0x3F, 0xF8, 0x03, 0xAA, 0x82,
+    0xFA, 0x83, 0x1F, 0x03, 0x00, 0x82, 0x3F, 0xF8, 0x01, 0x02, 0x00, 0x82, 0xF0, 0x43, 0x05, 0x03,
+    0x00, 0x80, 0x2A, 0x12, 0x00, 0x80, 0xA9, 0x02, 0xAA, 0x82, 0x2A, 0x00, 0xD0, 0x03, 0xFF, 0x82,
+    0x03, 0x00, 0xFD, 0x02, 0xFF, 0x82, 0x3F, 0x00, 0x90, 0x02, 0xAA, 0x81, 0xFE, 0x02, 0x03, 0x00,
+    0x81, 0x40, 0x1F, 0x04, 0x00, 0x81, 0xE0, 0x03, 0x03, 0x00, 0x83, 0x90, 0x7F, 0x00, 0xD0, 0x03,
+    0xFF, 0x82, 0x07, 0x00, 0xFD, 0x02, 0xFF, 0x82, 0x2F, 0x00, 0xD0, 0x02, 0xFF, 0x86, 0xBF, 0x01,
+    0x00, 0xA9, 0xAA, 0x6A, 0x01, 0x0D, 0x00, 0x82, 0x90, 0xAA, 0x06, 0x02, 0x00, 0x80, 0xD0, 0x02,
+    0xFF, 0x82, 0x07, 0x00, 0x40, 0x03, 0xFF, 0x82, 0x01, 0x00, 0xFC, 0x02, 0xFF, 0x88, 0x2F, 0x00,
+    0xD0, 0x6F, 0x55, 0xF9, 0x07, 0x00, 0xBD, 0x02, 0x00, 0x8D, 0x7E, 0x00, 0xD0, 0x0F, 0x00, 0xF0,
+    0x07, 0x00, 0xFD, 0x56, 0x95, 0x3F, 0x00, 0x80, 0x03, 0xFF, 0x82, 0x02, 0x00, 0xF4, 0x02, 0xFF,
+    0x80, 0x1F, 0x02, 0x00, 0x82, 0xF9, 0xFF, 0x6F, 0x03, 0x00, 0x81, 0x54, 0x15, 0x0E, 0x00, 0x80,
+    0xA5, 0x02, 0xAA, 0x82, 0x02, 0x00, 0xF4, 0x02, 0xFF, 0x82, 0x3F, 0x00, 0xC0, 0x03, 0xFF, 0x88,
+    0x03, 0x00, 0xFD, 0xAB, 0xAA, 0x2A, 0x00, 0xD0, 0x1F, 0x04, 0x00, 0x80, 0xB8, 0x03, 0x00, 0x82,
+    0x40, 0x55, 0x5E, 0x02, 0x00, 0x80, 0x80, 0x04, 0xFF, 0x81, 0x3F, 0xF8, 0x04, 0xFF, 0x80, 0x83,
+    0x04, 0xFF, 0x81, 0x3F, 0xA4, 0x04, 0xAA, 0x80, 0x02, 0x0B, 0x00, 0x81, 0x40, 0x01, 0x02, 0x55,
+    0x83, 0x15, 0x80, 0x2F, 0xF0, 0x02, 0xFF, 0x82, 0x03, 0xFE, 0x02, 0x02, 0xFF, 0x83, 0x3F, 0xF4,
+    0x2F, 0xF0, 0x02, 0xFF, 0x8C, 0x83, 0x7F, 0x00, 0xBF, 0x95, 0x1B, 0xF8, 0x01, 0xE0, 0x07, 0xE0,
+    0x82, 0x1F, 0x03, 0x00, 0x82, 0x3E, 0xF8, 0x5B, 0x02, 0x55, 0x81, 0xFD, 0x47, 0x04, 0xFF, 0x81,
+    0x3F, 0xE0, 0x04, 0xFF, 0x81, 0x02, 0xF8, 0x03, 0xFF, 0x82, 0x07, 0x00, 0x54, 0x02, 0x55, 0x80,
+    0x05, 0x06, 0x00,
+};
+// clang-format on
@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Unused by flash_mock.cpp, but required by flash_spi.h
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN B0
+
+// One surface for memory-loaded fonts, one for flash-loaded fonts
+#define RGB565_SURFACE_NUM_DEVICES 2
+
+// TRUE is only defined by ChibiOS
+#define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM 1
@@ -0,0 +1,12 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = rgb565_surface
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE = yes
+FLASH_DRIVER = custom
+
+SRC += \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
+    ../flash_mock.cpp \
+    ../thintel15.qff.c
@@ -0,0 +1,84 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "test_common.hpp"
+#include "../flash_mock.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_rgb565_surface.h"
+
+extern const uint32_t font_thintel15_length;
+extern const uint8_t  font_thintel15[];
+}
+
+#define SURFACE_WIDTH 128
+#define SURFACE_HEIGHT 32
+
+class PainterFlashFontsToRam : public TestFixture {
+   public:
+    FlashMock& flash = FlashMock::Instance();
+
+    // One framebuffer for memory-loaded fonts, one for flash-loaded fonts
+    static std::array<std::uint16_t, SURFACE_WIDTH * SURFACE_HEIGHT> framebuffers[2];
+
+    void SetUp() override {
+        framebuffers[0].fill(0);
+        framebuffers[1].fill(0);
+        flash.reset();
+        std::vector<std::vector<std::uint8_t>> assets = {
+            std::vector<std::uint8_t>(font_thintel15, font_thintel15 + font_thintel15_length),
+        };
+        flash.write_asset_index(QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS, assets);
+    }
+
+    // Surfaces are limited in number, so they're only created the once
+    static painter_device_t surface(int index) {
+        static painter_device_t surfaces[2] = {nullptr, nullptr};
+        if (!surfaces[index]) {
+            surfaces[index] = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffers[index].data());
+            qp_init(surfaces[index], QP_ROTATION_0);
+        }
+        return surfaces[index];
+    }
+
+    // Draws the text with a font loaded from memory and one loaded from flash, returning the flash reads made while drawing
+    std::uint64_t draw_both(painter_font_handle_t flash_font, const char* text) {
+        painter_font_handle_t mem_font = qp_load_font_mem(font_thintel15);
+        EXPECT_NE(mem_font, nullptr);
+        EXPECT_NE(qp_drawtext(surface(0), 0, 0, mem_font, text), 0);
+        EXPECT_TRUE(qp_close_font(mem_font));
+
+        flash.read_count = 0;
+        EXPECT_NE(qp_drawtext(surface(1), 0, 0, flash_font, text), 0);
+        EXPECT_EQ(framebuffers[1], framebuffers[0]);
+        EXPECT_NE(std::count(framebuffers[1].begin(), framebuffers[1].end(), 0), framebuffers[1].size()) << "Nothing was drawn";
+        return flash.read_count;
+    }
+};
+
+std::array<std::uint16_t, SURFACE_WIDTH * SURFACE_HEIGHT> PainterFlashFontsToRam::framebuffers[2];
+
+TEST_F(PainterFlashFontsToRam, FontCopiedToRam) {
+    painter_font_handle_t flash_font = qp_load_font_flash(0);
+    ASSERT_NE(flash_font, nullptr);
+    EXPECT_EQ(draw_both(flash_font, "Quantum Painter 0123"), 0) << "Drawing should not have read from flash";
+    EXPECT_TRUE(qp_close_font(flash_font));
+}
+
+TEST_F(PainterFlashFontsToRam, CopyFailureFallsBackToFlash) {
+    // Fail each read in turn, those failing validation don't load at all, those failing the copy fall back to flash
+    int fallbacks = 0;
+    for (std::int64_t failed = 0; failed < 64; ++failed) {
+        flash.fail_read                  = failed;
+        painter_font_handle_t flash_font = qp_load_font_flash(0);
+        if (flash_font == nullptr) {
+            continue;
+        }
+        flash.fail_read = -1;
+        fallbacks += draw_both(flash_font, "Fallback") > 0 ? 1 : 0;
+        EXPECT_TRUE(qp_close_font(flash_font));
+    }
+    EXPECT_GT(fallbacks, 0) << "No read failure resulted in drawing from flash";
+}
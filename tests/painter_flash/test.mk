@@ -0,0 +1,19 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = rgb565_surface
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE = yes
+
+# External flash is provided by flash_mock.cpp, and the surface still needs the comms API
+# that's otherwise only pulled in by display drivers
+FLASH_DRIVER = custom
+
+SRC += \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
+    $(TEST_PATH)/ghoul-name.qgf.c \
+    $(TEST_PATH)/thintel15.qff.c
@@ -0,0 +1,173 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <numeric>
+#include "test_common.hpp"
+#include "flash_mock.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_stream.h"
+#include "qp_rgb565_surface.h"
+
+extern const uint32_t gfx_ghoul_name_length;
+extern const uint8_t  gfx_ghoul_name[];
+extern const uint32_t font_thintel15_length;
+extern const uint8_t  font_thintel15[];
+}
+
+#define SURFACE_WIDTH 128
+#define SURFACE_HEIGHT 96
+
+class PainterFlash : public TestFixture {
+   public:
+    FlashMock& flash = FlashMock::Instance();
+
+    // One framebuffer for memory-loaded assets, one for flash-loaded assets
+    static std::array<std::uint16_t, SURFACE_WIDTH * SURFACE_HEIGHT> framebuffers[2];
+
+    void SetUp() override {
+        framebuffers[0].fill(0);
+        framebuffers[1].fill(0);
+        flash.reset();
+        std::vector<std::vector<std::uint8_t>> assets = {
+            std::vector<std::uint8_t>(gfx_ghoul_name, gfx_ghoul_name + gfx_ghoul_name_length),
+            std::vector<std::uint8_t>(font_thintel15, font_thintel15 + font_thintel15_length),
+        };
+        flash.write_asset_index(QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS, assets);
+    }
+
+    // Surfaces are limited in number, so they're only created the once
+    static painter_device_t surface(int index) {
+        static painter_device_t surfaces[2] = {nullptr, nullptr};
+        if (!surfaces[index]) {
+            surfaces[index] = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffers[index].data());
+            qp_init(surfaces[index], QP_ROTATION_0);
+        }
+        return surfaces[index];
+    }
+};
+
+std::array<std::uint16_t, SURFACE_WIDTH * SURFACE_HEIGHT> PainterFlash::framebuffers[2];
+
+TEST_F(PainterFlash, SequentialReadsGrowToCacheSize) {
+    std::vector<std::uint8_t> data(4096);
+    std::iota(data.begin(), data.end(), 0);
+    flash.poke(0x10000, data.data(), data.size());
+    flash.read_count = 0;
+
+    qp_flash_stream_t         stream = qp_make_flash_stream(0x10000, data.size());
+    std::vector<std::uint8_t> readback(data.size());
+    EXPECT_EQ(qp_stream_read(readback.data(), 1, readback.size(), &stream), data.size());
+    EXPECT_EQ(readback, data);
+
+    // Reads double from the minimum until they reach the cache size
+    int ramp = 0;
+    for (int size = QUANTUM_PAINTER_FLASH_STREAM_MIN_READ; size < QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE; size *= 2) {
+        ++ramp;
+    }
+    EXPECT_LE(flash.read_count, ramp + data.size() / QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE + 1);
+
+    EXPECT_EQ(qp_stream_get(&stream), STREAM_EOF);
+    EXPECT_TRUE(qp_stream_eof(&stream));
+}
+
+TEST_F(PainterFlash, RandomAccess) {
+    std::vector<std::uint8_t> data(1024);
+    std::iota(data.begin(), data.end(), 0x40);
+    flash.poke(0x20000, data.data(), data.size());
+
+    qp_flash_stream_t stream = qp_make_flash_stream(0x20000, data.size());
+    for (int32_t pos : {700, 3, 3 + QUANTUM_PAINTER_FLASH_STREAM_MIN_READ, 1023, 0, 512}) {
+        EXPECT_EQ(qp_stream_setpos(&stream, pos), 0);
+        EXPECT_EQ(qp_stream_get(&stream), data[pos]) << "Mismatch at " << pos;
+        EXPECT_EQ(qp_stream_tell(&stream), pos + 1);
+    }
+
+    // Seeking within what's already cached shouldn't touch the flash
+    EXPECT_EQ(qp_stream_setpos(&stream, 500), 0);
+    qp_stream_get(&stream);
+    std::uint64_t reads = flash.read_count;
+    EXPECT_EQ(qp_stream_seek(&stream, 4, SEEK_CUR), 0);
+    EXPECT_EQ(qp_stream_get(&stream), data[505]);
+    EXPECT_EQ(flash.read_count, reads);
+
+    // Same bounds as memory streams
+    EXPECT_EQ(qp_stream_seek(&stream, 0, SEEK_END), 0);
+    EXPECT_EQ(qp_stream_seek(&stream, 1, SEEK_END), -1);
+    EXPECT_EQ(qp_stream_setpos(&stream, -1), -1);
+    EXPECT_FALSE(qp_stream_put(&stream, 0));
+}
+
+TEST_F(PainterFlash, ReadErrorIsEof) {
+    qp_flash_stream_t stream = qp_make_flash_stream(0x10000, 1024);
+    flash.fail_read          = 0;
+    EXPECT_EQ(qp_stream_get(&stream), STREAM_EOF);
+    EXPECT_TRUE(qp_stream_eof(&stream));
+
+    // Seeking clears the error, as it does for the end of the stream
+    EXPECT_EQ(qp_stream_setpos(&stream, 0), 0);
+    EXPECT_FALSE(qp_stream_eof(&stream));
+    EXPECT_EQ(qp_stream_get(&stream), 0xFF);
+}
+
+TEST_F(PainterFlash, InvalidIndex) {
+    flash.reset();
+    EXPECT_EQ(qp_load_image_flash(0), nullptr);
+    EXPECT_EQ(qp_load_font_flash(0), nullptr);
+}
+
+TEST_F(PainterFlash, OutOfRangeAsset) {
+    EXPECT_EQ(qp_load_image_flash(2), nullptr);
+    EXPECT_EQ(qp_load_font_flash(2), nullptr);
+}
+
+TEST_F(PainterFlash, WrongAssetType) {
+    EXPECT_EQ(qp_load_image_flash(1), nullptr) << "Font should not load as an image";
+    EXPECT_EQ(qp_load_font_flash(0), nullptr) << "Image should not load as a font";
+}
+
+TEST_F(PainterFlash, ImageMatchesMemory) {
+    painter_image_handle_t mem_image = qp_load_image_mem(gfx_ghoul_name);
+    ASSERT_NE(mem_image, nullptr);
+    painter_image_handle_t flash_image = qp_load_image_flash(0);
+    ASSERT_NE(flash_image, nullptr);
+    EXPECT_EQ(flash_image->width, mem_image->width);
+    EXPECT_EQ(flash_image->height, mem_image->height);
+
+    flash.read_count = 0;
+    flash.read_bytes = 0;
+    EXPECT_TRUE(qp_drawimage(surface(0), 0, 0, mem_image));
+    EXPECT_TRUE(qp_drawimage(surface(1), 0, 0, flash_image));
+    EXPECT_EQ(framebuffers[1], framebuffers[0]);
+    EXPECT_NE(std::count(framebuffers[1].begin(), framebuffers[1].end(), 0), framebuffers[1].size()) << "Nothing was drawn";
+
+    // Drawing reads the image roughly once, in far fewer transactions than bytes
+    EXPECT_LT(flash.read_count, gfx_ghoul_name_length / 8);
+    std::cout << "[ QP FLASH ] " << gfx_ghoul_name_length << " byte image: " << flash.read_count << " flash reads, " << flash.read_bytes << " bytes" << std::endl;
+
+    EXPECT_TRUE(qp_close_image(mem_image));
+    EXPECT_TRUE(qp_close_image(flash_image));
+}
+
+TEST_F(PainterFlash, FontMatchesMemory) {
+    painter_font_handle_t mem_font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(mem_font, nullptr);
+    painter_font_handle_t flash_font = qp_load_font_flash(1);
+    ASSERT_NE(flash_font, nullptr);
+    EXPECT_EQ(flash_font->line_height, mem_font->line_height);
+
+    const char* text = "Quantum Painter 0123";
+    EXPECT_EQ(qp_textwidth(flash_font, text), qp_textwidth(mem_font, text));
+
+    flash.read_count = 0;
+    flash.read_bytes = 0;
+    EXPECT_NE(qp_drawtext(surface(0), 0, 0, mem_font, text), 0);
+    EXPECT_NE(qp_drawtext(surface(1), 0, 0, flash_font, text), 0);
+    EXPECT_EQ(framebuffers[1], framebuffers[0]);
+    std::cout << "[ QP FLASH ] " << font_thintel15_length << " byte font, " << strlen(text) << " glyphs: " << flash.read_count << " flash reads, " << flash.read_bytes << " bytes" << std::endl;
+
+    EXPECT_TRUE(qp_close_font(mem_font));
+    EXPECT_TRUE(qp_close_font(flash_font));
+}
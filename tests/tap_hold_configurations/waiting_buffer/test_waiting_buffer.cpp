@@ -0,0 +1,137 @@
+/* Copyright 2023 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class WaitingBuffer : public TestFixture {};
+
+TEST_F(WaitingBuffer, roll_more_keys_than_default_buffer_while_mod_tap_is_held) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       key_a       = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b       = KeymapKey(0, 2, 0, KC_B);
+    auto       key_c       = KeymapKey(0, 3, 0, KC_C);
+    auto       key_d       = KeymapKey(0, 4, 0, KC_D);
+    auto       key_e       = KeymapKey(0, 5, 0, KC_E);
+    auto       key_f       = KeymapKey(0, 6, 0, KC_F);
+    auto       key_g       = KeymapKey(0, 7, 0, KC_G);
+
+    set_keymap({mod_tap_key, key_a, key_b, key_c, key_d, key_e, key_f, key_g});
+
+    const uint16_t overflows = action_tapping_overflow_count();
+
+    /* Press mod-tap key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap seven regular keys, 14 events do not fit into the default 8 entry buffer. */
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_a, key_b, key_c, key_d, key_e, key_f, key_g);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap key within the tapping term, all buffered keys are replayed in order. */
+    EXPECT_REPORT(driver, (KC_P));
+    for (auto key : {KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G}) {
+        EXPECT_REPORT(driver, (KC_P, key));
+        EXPECT_REPORT(driver, (KC_P));
+    }
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_tapping_overflow_count(), overflows);
+}
+
+TEST_F(WaitingBuffer, overflow_is_counted) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       key_a       = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_key, key_a});
+
+    const uint16_t overflows = action_tapping_overflow_count();
+
+    /* Press mod-tap key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Fill the waiting buffer up to its capacity. */
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 7; i++) {
+        tap_key(key_a);
+    }
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(action_tapping_overflow_count(), overflows);
+
+    /* One more event overflows the buffer and drops the pending state. */
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(action_tapping_overflow_count(), overflows + 1);
+
+    /* Releasing the mod-tap key afterwards does not register anything. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WaitingBuffer, release_of_mod_tap_key_in_buffer_is_found) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key   = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       layer_tap_key = KeymapKey(0, 1, 0, LT(1, KC_A));
+
+    set_keymap({mod_tap_key, layer_tap_key});
+
+    /* Press and release both dual-role keys in a roll. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    layer_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    layer_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,191 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "crc.h"
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "via.h"
+
+static std::vector<std::array<uint8_t, 32>> replies;
+
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    std::array<uint8_t, 32> reply;
+    memcpy(reply.data(), data, length);
+    replies.push_back(reply);
+}
+}
+
+#define PACKET_SIZE 32
+#define PAYLOAD_SIZE (PACKET_SIZE - 2)
+#define KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+class ViaBulk : public TestFixture {
+   protected:
+    std::size_t packets;
+
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        replies.clear();
+        packets = 0;
+    }
+
+    void send(std::array<uint8_t, PACKET_SIZE> packet) {
+        raw_hid_receive(packet.data(), packet.size());
+        ++packets;
+    }
+
+    uint8_t begin(uint8_t target, uint16_t offset, uint16_t size) {
+        replies.clear();
+        send({id_bulk_write_begin, target, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)});
+        EXPECT_EQ(replies.size(), 1);
+        EXPECT_EQ(replies[0][2] << 8 | replies[0][3], VIA_BULK_BUFFER_SIZE);
+        return replies[0][1];
+    }
+
+    // Streams the data, optionally dropping one of the packets
+    void stream(const uint8_t *data, uint16_t size, int dropped = -1) {
+        replies.clear();
+        uint8_t sequence = 0;
+        for (uint16_t position = 0; position < size; position += PAYLOAD_SIZE, ++sequence) {
+            std::array<uint8_t, PACKET_SIZE> packet = {id_bulk_write_data, sequence};
+            memcpy(&packet[2], &data[position], std::min<uint16_t>(PAYLOAD_SIZE, size - position));
+            if (sequence != dropped) {
+                send(packet);
+            }
+        }
+        EXPECT_EQ(replies.size(), 0) << "Data packets should not be answered";
+    }
+
+    uint8_t commit(uint8_t crc) {
+        replies.clear();
+        send({id_bulk_write_commit, crc});
+        EXPECT_EQ(replies.size(), 1);
+        return replies[0][1];
+    }
+
+    // A complete transfer, split up into as many as needed
+    void write(uint8_t target, const std::vector<uint8_t> &data) {
+        for (uint16_t offset = 0; offset < data.size(); offset += VIA_BULK_BUFFER_SIZE) {
+            uint16_t size = std::min<uint16_t>(VIA_BULK_BUFFER_SIZE, data.size() - offset);
+            ASSERT_EQ(begin(target, offset, size), bulk_status_ok);
+            stream(&data[offset], size);
+            ASSERT_EQ(commit(crc8(&data[offset], size)), bulk_status_ok);
+        }
+    }
+
+    std::vector<uint8_t> read(uint8_t target, uint16_t offset, uint16_t size) {
+        replies.clear();
+        send({id_bulk_read, target, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)});
+        EXPECT_EQ(replies.size(), (size + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE);
+
+        std::vector<uint8_t> data;
+        for (std::size_t i = 0; i < replies.size(); ++i) {
+            EXPECT_EQ(replies[i][0], id_bulk_read);
+            EXPECT_EQ(replies[i][1], i) << "Replies out of sequence";
+            data.insert(data.end(), &replies[i][2], &replies[i][2] + std::min<std::size_t>(PAYLOAD_SIZE, size - data.size()));
+        }
+        return data;
+    }
+
+    std::vector<uint8_t> keymap() {
+        std::vector<uint8_t> data(KEYMAP_SIZE);
+        dynamic_keymap_get_buffer(0, data.size(), data.data());
+        return data;
+    }
+
+    static std::vector<uint8_t> test_keymap() {
+        std::vector<uint8_t> data(KEYMAP_SIZE);
+        for (std::size_t i = 0; i < data.size(); i += 2) {
+            data[i]     = 0x00;
+            data[i + 1] = KC_A + (i / 2) % 26;
+        }
+        return data;
+    }
+};
+
+TEST_F(ViaBulk, Keymap_RoundTrip) {
+    auto data = test_keymap();
+    write(id_bulk_keymap, data);
+    std::size_t write_packets = packets;
+
+    EXPECT_EQ(keymap(), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_A + (KEYMAP_SIZE / 2 - 1) % 26);
+
+    std::vector<uint8_t> readback;
+    for (uint16_t offset = 0; offset < data.size(); offset += VIA_BULK_BUFFER_SIZE) {
+        auto chunk = read(id_bulk_keymap, offset, std::min<uint16_t>(VIA_BULK_BUFFER_SIZE, data.size() - offset));
+        readback.insert(readback.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(readback, data);
+
+    // Every packet of id_dynamic_keymap_set_buffer waits for its reply, with 28 bytes in each
+    std::size_t round_trips = (data.size() + VIA_BULK_BUFFER_SIZE - 1) / VIA_BULK_BUFFER_SIZE * 2;
+    std::cout << "[ VIA      ] " << data.size() << " byte keymap write: " << write_packets << " packets, " << round_trips << " round trips, previously " << (data.size() + 27) / 28 << std::endl;
+}
+
+TEST_F(ViaBulk, Macro_RoundTrip) {
+    std::vector<uint8_t> data(100);
+    std::iota(data.begin(), data.end(), 0x20);
+    ASSERT_EQ(begin(id_bulk_macro, 3, data.size()), bulk_status_ok);
+    stream(data.data(), data.size());
+    ASSERT_EQ(commit(crc8(data.data(), data.size())), bulk_status_ok);
+
+    EXPECT_EQ(read(id_bulk_macro, 3, data.size()), data);
+    EXPECT_EQ(read(id_bulk_macro, 0, 3), std::vector<uint8_t>(3, 0x00));
+}
+
+TEST_F(ViaBulk, DroppedPacket_NothingWritten) {
+    auto before = keymap();
+    auto data   = test_keymap();
+    ASSERT_EQ(begin(id_bulk_keymap, 0, 200), bulk_status_ok);
+    stream(data.data(), 200, 2);
+    EXPECT_EQ(commit(crc8(data.data(), 200)), bulk_status_sequence_error);
+    EXPECT_EQ(keymap(), before);
+}
+
+TEST_F(ViaBulk, CrcMismatch_NothingWritten) {
+    auto before = keymap();
+    auto data   = test_keymap();
+    ASSERT_EQ(begin(id_bulk_keymap, 0, 200), bulk_status_ok);
+    stream(data.data(), 200);
+    EXPECT_EQ(commit(crc8(data.data(), 200) ^ 0x01), bulk_status_crc_mismatch);
+    EXPECT_EQ(keymap(), before);
+
+    // The transfer is over either way
+    EXPECT_EQ(commit(crc8(data.data(), 200)), bulk_status_not_started);
+    EXPECT_EQ(keymap(), before);
+}
+
+TEST_F(ViaBulk, Incomplete_NothingWritten) {
+    auto before = keymap();
+    auto data   = test_keymap();
+    ASSERT_EQ(begin(id_bulk_keymap, 0, 200), bulk_status_ok);
+    stream(data.data(), 100);
+    EXPECT_EQ(commit(crc8(data.data(), 200)), bulk_status_incomplete);
+    EXPECT_EQ(keymap(), before);
+}
+
+TEST_F(ViaBulk, CommitWithoutBegin) {
+    EXPECT_EQ(commit(0x00), bulk_status_not_started);
+}
+
+TEST_F(ViaBulk, OutOfRange_Rejected) {
+    EXPECT_EQ(begin(id_bulk_keymap, KEYMAP_SIZE - 10, 20), bulk_status_out_of_range);
+    EXPECT_EQ(begin(id_bulk_keymap, 0, VIA_BULK_BUFFER_SIZE + 1), bulk_status_out_of_range);
+    EXPECT_EQ(begin(id_bulk_macro, 0, 0), bulk_status_out_of_range);
+    EXPECT_EQ(begin(0x00, 0, 10), bulk_status_out_of_range);
+
+    replies.clear();
+    send({id_bulk_read, id_bulk_keymap, (uint8_t)(KEYMAP_SIZE >> 8), (uint8_t)(KEYMAP_SIZE & 0xFF), 0x00, 0x02});
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0][0], id_unhandled);
+}
@@ -0,0 +1,7 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Normally generated for keyboard builds, used by VIA for its EEPROM magic
+#define QMK_BUILDDATE "2023-01-01-00:00:00"
@@ -43,6 +43,10 @@
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
+#include "usb_report_queue.h"
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -111,6 +115,9 @@ union {
 #define HID_SET_IDLE 0x0A
 #define HID_SET_PROTOCOL 0x0B
 
+/* HID report types (MSB of wValue in GET_REPORT/SET_REPORT) */
+#define HID_REPORT_FEATURE 0x03
+
 /*
  * Handles the GET_DESCRIPTOR callback
  *
@@ -129,24 +136,60 @@ static const USBDescriptor *usb_get_descriptor_cb(USBDriver *usbp, uint8_t dtype
         return &desc;
 }
 
+/* Starts transmitting a report taken from an endpoint's queue */
+static void report_start_transmitI(USBDriver *usbp, usbep_t ep, usb_report_t *report) {
+#ifdef LATENCY_TRACKING_ENABLE
+    if (report->kind <= USB_REPORT_NKRO) {
+        latency_tracking_mark(LATENCY_STAGE_ENDPOINT_SUBMIT);
+    }
+#endif
+    usbStartTransmitI(usbp, ep, report->report.raw, report->size);
+}
+
 /*
- * USB notification callback that does nothing.  Needed to work around bugs in
- * some USB LLDs that fail to resume the waiting thread when the notification
- * callback pointer is NULL.
+ * IN notification callback for HID report endpoints, starting the next queued report
+ * as soon as the previous one has been collected by the host. Always being non-NULL
+ * also works around bugs in some USB LLDs that fail to resume the waiting thread
+ * when the notification callback pointer is NULL.
  */
-static void dummy_usb_cb(USBDriver *usbp, usbep_t ep) {
-    (void)usbp;
-    (void)ep;
+static void report_in_cb(USBDriver *usbp, usbep_t ep) {
+    usb_report_queue_t *queue = usbp->in_params[ep - 1U];
+
+    if (queue == NULL) {
+        return;
+    }
+
+    osalSysLockFromISR();
+#ifdef LATENCY_TRACKING_ENABLE
+    /* The host has just collected the report in flight */
+    if (queue->in_flight && queue->reports[queue->head].kind <= USB_REPORT_NKRO) {
+        latency_tracking_mark(LATENCY_STAGE_COMPLETE);
+    }
+#endif
+    usb_report_queue_complete(queue);
+    usb_report_t *report = usb_report_queue_start(queue);
+    if (report != NULL) {
+        /* The endpoint cannot be busy, we are in the context of the callback */
+        report_start_transmitI(usbp, ep, report);
+    }
+    osalSysUnlockFromISR();
+}
+
+/* Points the endpoint at an empty report queue */
+static void report_queue_initI(USBDriver *usbp, usbep_t ep, usb_report_queue_t *queue) {
+    usb_report_queue_clear(queue);
+    usbp->in_params[ep - 1U] = queue;
 }
 
 #ifndef KEYBOARD_SHARED_EP
 /* keyboard endpoint state structure */
 static USBInEndpointState kbd_ep_state;
+static usb_report_queue_t kbd_report_queue;
 /* keyboard endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig kbd_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     KEYBOARD_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -159,12 +202,13 @@ static const USBEndpointConfig kbd_ep_config = {
 #if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
 /* mouse endpoint state structure */
 static USBInEndpointState mouse_ep_state;
+static usb_report_queue_t mouse_report_queue;
 
 /* mouse endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig mouse_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     MOUSE_EPSIZE,           /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -177,12 +221,13 @@ static const USBEndpointConfig mouse_ep_config = {
 #ifdef SHARED_EP_ENABLE
 /* shared endpoint state structure */
 static USBInEndpointState shared_ep_state;
+static usb_report_queue_t shared_report_queue;
 
 /* shared endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig shared_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     SHARED_EPSIZE,          /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -195,12 +240,13 @@ static const USBEndpointConfig shared_ep_config = {
 #if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
 /* joystick endpoint state structure */
 static USBInEndpointState joystick_ep_state;
+static usb_report_queue_t joystick_report_queue;
 
 /* joystick endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig joystick_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     JOYSTICK_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -213,12 +259,13 @@ static const USBEndpointConfig joystick_ep_config = {
 #if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
 /* digitizer endpoint state structure */
 static USBInEndpointState digitizer_ep_state;
+static usb_report_queue_t digitizer_report_queue;
 
 /* digitizer endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig digitizer_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    report_in_cb,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     DIGITIZER_EPSIZE,       /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -506,21 +553,30 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+            /* The host enables high resolution scrolling again after configuring the device */
+            host_mouse_set_resolution_multiplier(0);
+#endif
             /* Enable the endpoints specified into the configuration. */
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
+            report_queue_initI(usbp, KEYBOARD_IN_EPNUM, &kbd_report_queue);
 #endif
 #if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
             usbInitEndpointI(usbp, MOUSE_IN_EPNUM, &mouse_ep_config);
+            report_queue_initI(usbp, MOUSE_IN_EPNUM, &mouse_report_queue);
 #endif
 #ifdef SHARED_EP_ENABLE
             usbInitEndpointI(usbp, SHARED_IN_EPNUM, &shared_ep_config);
+            report_queue_initI(usbp, SHARED_IN_EPNUM, &shared_report_queue);
 #endif
 #if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
             usbInitEndpointI(usbp, JOYSTICK_IN_EPNUM, &joystick_ep_config);
+            report_queue_initI(usbp, JOYSTICK_IN_EPNUM, &joystick_report_queue);
 #endif
 #if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
             usbInitEndpointI(usbp, DIGITIZER_IN_EPNUM, &digitizer_ep_config);
+            report_queue_initI(usbp, DIGITIZER_IN_EPNUM, &digitizer_report_queue);
 #endif
             for (int i = 0; i < NUM_USB_DRIVERS; i++) {
 #ifdef USB_ENDPOINTS_ARE_REORDERABLE
@@ -606,6 +662,32 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     }
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    ifdef MOUSE_SHARED_EP
+#        define RESOLUTION_MULTIPLIER_INTERFACE SHARED_INTERFACE
+#        define RESOLUTION_MULTIPLIER_REPORT_SIZE 2
+#    else
+#        define RESOLUTION_MULTIPLIER_INTERFACE MOUSE_INTERFACE
+#        define RESOLUTION_MULTIPLIER_REPORT_SIZE 1
+#    endif
+
+/* Resolution Multiplier feature report, preceded by the report ID on the shared endpoint */
+static uint8_t resolution_multiplier_buf[RESOLUTION_MULTIPLIER_REPORT_SIZE] __attribute__((aligned(4)));
+
+static bool is_resolution_multiplier_request(USBDriver *usbp) {
+#    ifdef MOUSE_SHARED_EP
+    if (usbp->setup[2] != REPORT_ID_MOUSE) { /* LSB(wValue) */
+        return false;
+    }
+#    endif
+    return (usbp->setup[4] == RESOLUTION_MULTIPLIER_INTERFACE) && (usbp->setup[3] == HID_REPORT_FEATURE);
+}
+
+static void set_resolution_multiplier_transfer_cb(USBDriver *usbp) {
+    host_mouse_set_resolution_multiplier(resolution_multiplier_buf[RESOLUTION_MULTIPLIER_REPORT_SIZE - 1]);
+}
+#endif
+
 /* Callback for SETUP request on the endpoint 0 (control) */
 static bool usb_request_hook_cb(USBDriver *usbp) {
     const USBDescriptor *dp;
@@ -623,6 +705,14 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_DEV2HOST:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_GET_REPORT:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(usbp)) {
+                            resolution_multiplier_buf[0]                                     = usbp->setup[2];
+                            resolution_multiplier_buf[RESOLUTION_MULTIPLIER_REPORT_SIZE - 1] = host_mouse_get_resolution_multiplier();
+                            usbSetupTransfer(usbp, resolution_multiplier_buf, RESOLUTION_MULTIPLIER_REPORT_SIZE, NULL);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
 #ifndef KEYBOARD_SHARED_EP
                             case KEYBOARD_INTERFACE:
@@ -678,6 +768,12 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_HOST2DEV:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_SET_REPORT:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(usbp)) {
+                            usbSetupTransfer(usbp, resolution_multiplier_buf, RESOLUTION_MULTIPLIER_REPORT_SIZE, set_resolution_multiplier_transfer_cb);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
                             case KEYBOARD_INTERFACE:
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -859,45 +955,54 @@ uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
-void send_report(uint8_t endpoint, void *report, size_t size) {
+static void send_report(uint8_t endpoint, usb_report_kind_t kind, void *report, size_t size) {
     osalSysLock();
-    if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+    usb_report_queue_t *queue = (&USB_DRIVER)->in_params[endpoint - 1U];
+    if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE || queue == NULL) {
         osalSysUnlock();
         return;
     }
 
-    if (usbGetTransmitStatusI(&USB_DRIVER, endpoint)) {
-        /* Need to either suspend, or loop and call unlock/lock during
-         * every iteration - otherwise the system will remain locked,
-         * no interrupts served, so USB not going through as well.
-         * Note: for suspend, need USB_USE_WAIT == TRUE in halconf.h */
-        if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[endpoint]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT) {
+    while (!usb_report_queue_push(queue, kind, report, size)) {
+        /* Only wait when the queue is full and the report could not be coalesced.
+         * The IN callback has already started the next report by the time this
+         * thread is resumed. Note: need USB_USE_WAIT == TRUE in halconf.h */
+        if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[endpoint]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT || usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
             osalSysUnlock();
             return;
         }
     }
-    usbStartTransmitI(&USB_DRIVER, endpoint, report, size);
+
+    /* Otherwise the IN callback will pick it up once the endpoint is free */
+    if (!usbGetTransmitStatusI(&USB_DRIVER, endpoint)) {
+        usb_report_t *next = usb_report_queue_start(queue);
+        if (next != NULL) {
+            report_start_transmitI(&USB_DRIVER, endpoint, next);
+        }
+    }
     osalSysUnlock();
 }
 
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
 void send_keyboard(report_keyboard_t *report) {
-    uint8_t ep   = KEYBOARD_IN_EPNUM;
-    size_t  size = KEYBOARD_REPORT_SIZE;
+    uint8_t           ep   = KEYBOARD_IN_EPNUM;
+    usb_report_kind_t kind = USB_REPORT_KEYBOARD;
+    size_t            size = KEYBOARD_REPORT_SIZE;
 
     /* If we're in Boot Protocol, don't send any report ID or other funky fields */
     if (!keyboard_protocol) {
-        send_report(ep, &report->mods, 8);
+        send_report(ep, USB_REPORT_KEYBOARD_BOOT, &report->mods, 8);
     } else {
 #ifdef NKRO_ENABLE
         if (keymap_config.nkro) {
             ep   = SHARED_IN_EPNUM;
+            kind = USB_REPORT_NKRO;
             size = sizeof(struct nkro_report);
         }
 #endif
 
-        send_report(ep, report, size);
+        send_report(ep, kind, report, size);
     }
 
     keyboard_report_sent = *report;
@@ -910,7 +1015,7 @@ void send_keyboard(report_keyboard_t *report) {
 
 void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
-    send_report(MOUSE_IN_EPNUM, report, sizeof(report_mouse_t));
+    send_report(MOUSE_IN_EPNUM, USB_REPORT_MOUSE, report, sizeof(report_mouse_t));
     mouse_report_sent = *report;
 #endif
 }
@@ -922,25 +1027,25 @@ void send_mouse(report_mouse_t *report) {
 
 void send_extra(report_extra_t *report) {
 #ifdef EXTRAKEY_ENABLE
-    send_report(SHARED_IN_EPNUM, report, sizeof(report_extra_t));
+    send_report(SHARED_IN_EPNUM, USB_REPORT_EXTRA, report, sizeof(report_extra_t));
 #endif
 }
 
 void send_programmable_button(report_programmable_button_t *report) {
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-    send_report(SHARED_IN_EPNUM, report, sizeof(report_programmable_button_t));
+    send_report(SHARED_IN_EPNUM, USB_REPORT_PROGRAMMABLE_BUTTON, report, sizeof(report_programmable_button_t));
 #endif
 }
 
 void send_joystick(report_joystick_t *report) {
 #ifdef JOYSTICK_ENABLE
-    send_report(JOYSTICK_IN_EPNUM, report, sizeof(report_joystick_t));
+    send_report(JOYSTICK_IN_EPNUM, USB_REPORT_OTHER, report, sizeof(report_joystick_t));
 #endif
 }
 
 void send_digitizer(report_digitizer_t *report) {
 #ifdef DIGITIZER_ENABLE
-    send_report(DIGITIZER_IN_EPNUM, report, sizeof(report_digitizer_t));
+    send_report(DIGITIZER_IN_EPNUM, USB_REPORT_OTHER, report, sizeof(report_digitizer_t));
 #endif
 }
 
@@ -1021,6 +1126,9 @@ void raw_hid_task(void) {
     do {
         size = chnReadTimeout(&drivers.raw_driver.driver, buffer, sizeof(buffer), TIME_IMMEDIATE);
         if (size > 0) {
+#ifdef LATENCY_TRACKING_ENABLE
+            if (latency_tracking_raw_hid_receive(buffer, size)) continue;
+#endif
             raw_hid_receive(buffer, size);
         }
     } while (size > 0);
@@ -0,0 +1,108 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "usb_report_queue.h"
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MOUSE_XY_MIN INT16_MIN
+#    define MOUSE_XY_MAX INT16_MAX
+#else
+#    define MOUSE_XY_MIN INT8_MIN
+#    define MOUSE_XY_MAX INT8_MAX
+#endif
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    define MOUSE_HV_MIN INT16_MIN
+#    define MOUSE_HV_MAX INT16_MAX
+#else
+#    define MOUSE_HV_MIN INT8_MIN
+#    define MOUSE_HV_MAX INT8_MAX
+#endif
+
+static usb_report_t *report_at(usb_report_queue_t *queue, uint8_t index) {
+    return &queue->reports[(queue->head + index) % USB_REPORT_QUEUE_SIZE];
+}
+
+static bool merge_mouse(report_mouse_t *tail, const report_mouse_t *next) {
+    if (tail->buttons != next->buttons) {
+        return false;
+    }
+
+    int32_t x = (int32_t)tail->x + next->x;
+    int32_t y = (int32_t)tail->y + next->y;
+    int32_t v = (int32_t)tail->v + next->v;
+    int32_t h = (int32_t)tail->h + next->h;
+    if (x < MOUSE_XY_MIN || x > MOUSE_XY_MAX || y < MOUSE_XY_MIN || y > MOUSE_XY_MAX || v < MOUSE_HV_MIN || v > MOUSE_HV_MAX || h < MOUSE_HV_MIN || h > MOUSE_HV_MAX) {
+        return false;
+    }
+
+    tail->x = x;
+    tail->y = y;
+    tail->v = v;
+    tail->h = h;
+#ifdef MOUSE_EXTENDED_REPORT
+    tail->boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    tail->boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#endif
+    return true;
+}
+
+void usb_report_queue_clear(usb_report_queue_t *queue) {
+    queue->head      = 0;
+    queue->count     = 0;
+    queue->in_flight = false;
+}
+
+bool usb_report_queue_push(usb_report_queue_t *queue, usb_report_kind_t kind, const void *report, uint8_t size) {
+    if (size > sizeof(queue->reports[0].report)) {
+        return false;
+    }
+
+    if (queue->count > 0) {
+        usb_report_t *tail = report_at(queue, queue->count - 1);
+        if (tail->kind == kind && tail->size == size) {
+            // repeating a state report changes nothing, even one in flight, but mouse reports are relative. Any other
+            // change to a state report is a press or release of its own, so it is queued to keep their order.
+            if (kind != USB_REPORT_MOUSE) {
+                if (memcmp(&tail->report, report, size) == 0) {
+                    return true;
+                }
+            } else if (!(queue->in_flight && queue->count == 1) && merge_mouse(&tail->report.mouse, report)) {
+                // only a report which is not yet in flight may be modified
+                return true;
+            }
+        }
+    }
+
+    if (queue->count == USB_REPORT_QUEUE_SIZE) {
+        return false;
+    }
+
+    usb_report_t *entry = report_at(queue, queue->count);
+    entry->kind         = kind;
+    entry->size         = size;
+    memcpy(&entry->report, report, size);
+    queue->count++;
+    return true;
+}
+
+usb_report_t *usb_report_queue_start(usb_report_queue_t *queue) {
+    if (queue->in_flight || queue->count == 0) {
+        return NULL;
+    }
+
+    queue->in_flight = true;
+    return report_at(queue, 0);
+}
+
+void usb_report_queue_complete(usb_report_queue_t *queue) {
+    if (!queue->in_flight) {
+        return;
+    }
+
+    queue->in_flight = false;
+    queue->head      = (queue->head + 1) % USB_REPORT_QUEUE_SIZE;
+    queue->count--;
+}
@@ -0,0 +1,61 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "report.h"
+
+/* Number of reports which can be waiting on a single HID IN endpoint, including the one being transmitted */
+#ifndef USB_REPORT_QUEUE_SIZE
+#    define USB_REPORT_QUEUE_SIZE 4
+#endif
+
+/* What a queued report holds. Only mouse reports are coalesced, every other kind is only de-duplicated. */
+typedef enum {
+    USB_REPORT_KEYBOARD_BOOT, // mods, reserved, keys[6] without report ID
+    USB_REPORT_KEYBOARD,
+    USB_REPORT_NKRO,
+    USB_REPORT_MOUSE,
+    USB_REPORT_EXTRA,
+    USB_REPORT_PROGRAMMABLE_BUTTON,
+    USB_REPORT_OTHER,
+} usb_report_kind_t;
+
+typedef struct {
+    uint8_t kind;
+    uint8_t size;
+    union {
+        uint8_t                      raw[1];
+        report_keyboard_t            keyboard;
+        report_mouse_t               mouse;
+        report_extra_t               extra;
+        report_programmable_button_t programmable_button;
+        report_joystick_t            joystick;
+        report_digitizer_t           digitizer;
+    } __attribute__((aligned(4))) report;
+} usb_report_t;
+
+typedef struct {
+    usb_report_t reports[USB_REPORT_QUEUE_SIZE];
+    uint8_t      head;
+    uint8_t      count;
+    bool         in_flight;
+} usb_report_queue_t;
+
+/* Drops every queued report, including one in flight */
+void usb_report_queue_clear(usb_report_queue_t *queue);
+
+/* Queues a report, dropping it if it repeats the last queued report, and adding mouse movement into the last queued
+ * mouse report while that is not in flight. Any other change is queued on its own, so the host sees every press and
+ * release in order. Returns false if the queue is full. */
+bool usb_report_queue_push(usb_report_queue_t *queue, usb_report_kind_t kind, const void *report, uint8_t size);
+
+/* Marks the oldest report as in flight and returns it, or NULL if there is nothing to send or a report is
+ * already in flight. An in flight report is never modified until it is completed. */
+usb_report_t *usb_report_queue_start(usb_report_queue_t *queue);
+
+/* Releases the report in flight, if any */
+void usb_report_queue_complete(usb_report_queue_t *queue);
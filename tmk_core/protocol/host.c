@@ -30,6 +30,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "joystick.h"
 #endif
 
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
+
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 #    include "outputselect.h"
@@ -43,6 +47,9 @@ extern keymap_config_t keymap_config;
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+static uint8_t mouse_resolution_multiplier = 0;
+#endif
 
 void host_set_driver(host_driver_t *d) {
     driver = d;
@@ -81,6 +88,9 @@ void host_keyboard_send(report_keyboard_t *report) {
 #endif
 
     if (!driver) return;
+#ifdef LATENCY_TRACKING_ENABLE
+    latency_tracking_mark(LATENCY_STAGE_REPORT_BUILD);
+#endif
 #if defined(NKRO_ENABLE) && defined(NKRO_SHARED_EP)
     if (keyboard_protocol && keymap_config.nkro) {
         /* The callers of this function assume that report->mods is where mods go in.
@@ -253,3 +263,21 @@ uint16_t host_last_system_usage(void) {
 uint16_t host_last_consumer_usage(void) {
     return last_consumer_usage;
 }
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+uint8_t host_mouse_get_resolution_multiplier(void) {
+    return mouse_resolution_multiplier;
+}
+
+void host_mouse_set_resolution_multiplier(uint8_t report) {
+    mouse_resolution_multiplier = report & (MOUSE_HIRES_WHEEL | MOUSE_HIRES_PAN);
+}
+
+uint16_t host_mouse_wheel_multiplier(void) {
+    return (mouse_resolution_multiplier & MOUSE_HIRES_WHEEL) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+
+uint16_t host_mouse_pan_multiplier(void) {
+    return (mouse_resolution_multiplier & MOUSE_HIRES_PAN) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+#endif
@@ -49,6 +49,15 @@ void    host_programmable_button_send(uint32_t data);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/* Resolution Multiplier feature report, as set by the host (MOUSE_HIRES_WHEEL/MOUSE_HIRES_PAN) */
+uint8_t host_mouse_get_resolution_multiplier(void);
+void    host_mouse_set_resolution_multiplier(uint8_t report);
+/* Report units per wheel detent the host currently expects */
+uint16_t host_mouse_wheel_multiplier(void);
+uint16_t host_mouse_pan_multiplier(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
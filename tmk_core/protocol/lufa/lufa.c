@@ -73,6 +73,10 @@ extern keymap_config_t keymap_config;
 #    include "raw_hid.h"
 #endif
 
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
+
 uint8_t keyboard_idle = 0;
 /* 0: Boot Protocol, 1: Report Protocol(default) */
 uint8_t        keyboard_protocol  = 1;
@@ -179,6 +183,9 @@ static void raw_hid_task(void) {
         Endpoint_ClearOUT();
 
         if (data_read) {
+#ifdef LATENCY_TRACKING_ENABLE
+            if (latency_tracking_raw_hid_receive(data, sizeof(data))) return;
+#endif
             raw_hid_receive(data, sizeof(data));
         }
     }
@@ -362,6 +369,11 @@ void EVENT_USB_Device_StartOfFrame(void) {
 void EVENT_USB_Device_ConfigurationChanged(void) {
     bool ConfigSuccess = true;
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    /* The host enables high resolution scrolling again after configuring the device */
+    host_mouse_set_resolution_multiplier(0);
+#endif
+
 #ifndef KEYBOARD_SHARED_EP
     /* Setup keyboard report endpoint */
     ConfigSuccess &= Endpoint_ConfigureEndpoint((KEYBOARD_IN_EPNUM | ENDPOINT_DIR_IN), EP_TYPE_INTERRUPT, KEYBOARD_EPSIZE, 1);
@@ -430,6 +442,28 @@ Boot Keyboard   Required    Optional    Required    Required    Required    Requ
 Non-Boot Keybrd Required    Optional    Required    Required    Optional    Optional
 Other Device    Required    Optional    Optional    Optional    Optional    Optional
 */
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    ifdef MOUSE_SHARED_EP
+#        define RESOLUTION_MULTIPLIER_INTERFACE SHARED_INTERFACE
+#        define RESOLUTION_MULTIPLIER_REPORT_SIZE 2
+#    else
+#        define RESOLUTION_MULTIPLIER_INTERFACE MOUSE_INTERFACE
+#        define RESOLUTION_MULTIPLIER_REPORT_SIZE 1
+#    endif
+
+/* Resolution Multiplier feature report, preceded by the report ID on the shared endpoint */
+static uint8_t resolution_multiplier_report[RESOLUTION_MULTIPLIER_REPORT_SIZE];
+
+static bool is_resolution_multiplier_request(void) {
+#    ifdef MOUSE_SHARED_EP
+    if ((USB_ControlRequest.wValue & 0xFF) != REPORT_ID_MOUSE) {
+        return false;
+    }
+#    endif
+    return USB_ControlRequest.wIndex == RESOLUTION_MULTIPLIER_INTERFACE && (USB_ControlRequest.wValue >> 8) == (HID_REPORT_ITEM_Feature + 1);
+}
+#endif
+
 /** \brief Event handler for the USB_ControlRequest event.
  *
  *  This is fired before passing along unhandled control requests to the library for processing internally.
@@ -452,6 +486,14 @@ void EVENT_USB_Device_ControlRequest(void) {
                         ReportSize = sizeof(keyboard_report_sent);
                         break;
                 }
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                if (is_resolution_multiplier_request()) {
+                    resolution_multiplier_report[0]                                     = USB_ControlRequest.wValue & 0xFF;
+                    resolution_multiplier_report[RESOLUTION_MULTIPLIER_REPORT_SIZE - 1] = host_mouse_get_resolution_multiplier();
+                    ReportData                                                          = resolution_multiplier_report;
+                    ReportSize                                                          = RESOLUTION_MULTIPLIER_REPORT_SIZE;
+                }
+#endif
 
                 /* Write the report data to the control endpoint */
                 Endpoint_Write_Control_Stream_LE(ReportData, ReportSize);
@@ -461,6 +503,24 @@ void EVENT_USB_Device_ControlRequest(void) {
             break;
         case HID_REQ_SetReport:
             if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                if (is_resolution_multiplier_request()) {
+                    Endpoint_ClearSETUP();
+
+                    while (!(Endpoint_IsOUTReceived())) {
+                        if (USB_DeviceState == DEVICE_STATE_Unattached) return;
+                    }
+
+#    ifdef MOUSE_SHARED_EP
+                    Endpoint_Read_8(); // report ID
+#    endif
+                    host_mouse_set_resolution_multiplier(Endpoint_Read_8());
+
+                    Endpoint_ClearOUT();
+                    Endpoint_ClearStatusStage();
+                    break;
+                }
+#endif
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
                     case KEYBOARD_INTERFACE:
@@ -577,6 +637,9 @@ static void send_keyboard(report_keyboard_t *report) {
         send_report(ep, report, size);
     }
 
+#ifdef LATENCY_TRACKING_ENABLE
+    latency_tracking_mark(LATENCY_STAGE_ENDPOINT_SUBMIT);
+#endif
     keyboard_report_sent = *report;
 }
 
@@ -209,6 +209,22 @@ typedef int16_t mouse_xy_report_t;
 typedef int8_t mouse_xy_report_t;
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    if !defined(PROTOCOL_LUFA) && !defined(PROTOCOL_CHIBIOS)
+#        error "POINTING_DEVICE_HIRES_SCROLL_ENABLE is only supported by the LUFA and ChibiOS protocols"
+#    endif
+#    ifndef POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#        define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 120
+#    endif
+typedef int16_t mouse_hv_report_t;
+#else
+typedef int8_t mouse_hv_report_t;
+#endif
+
+/* Resolution Multiplier feature report bits, set by the host to enable high resolution scrolling */
+#define MOUSE_HIRES_WHEEL (1 << 0)
+#define MOUSE_HIRES_PAN (1 << 2)
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
@@ -220,8 +236,8 @@ typedef struct {
 #endif
     mouse_xy_report_t x;
     mouse_xy_report_t y;
-    int8_t            v;
-    int8_t            h;
+    mouse_hv_report_t v;
+    mouse_hv_report_t h;
 } __attribute__((packed)) report_mouse_t;
 
 typedef struct {
@@ -48,6 +48,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "os_detection.h"
 #endif
 
+#ifdef LATENCY_TRACKING_ENABLE
+#    include "latency_tracking.h"
+#endif
+
 #define NEXT_INTERFACE __COUNTER__
 
 /*
@@ -166,7 +170,10 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
 
 void raw_hid_task(void) {
     if (raw_output_received_bytes == RAW_BUFFER_SIZE) {
-        raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+#ifdef LATENCY_TRACKING_ENABLE
+        if (!latency_tracking_raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE))
+#endif
+            raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
         raw_output_received_bytes = 0;
     }
 }
@@ -256,6 +263,9 @@ static void send_keyboard(report_keyboard_t *report) {
     // NOTE: send key strokes of Macro
     usbPoll();
     vusb_transfer_keyboard();
+#ifdef LATENCY_TRACKING_ENABLE
+    latency_tracking_mark(LATENCY_STAGE_ENDPOINT_SUBMIT);
+#endif
     keyboard_report_sent = *report;
 }
 